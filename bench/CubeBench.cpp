@@ -0,0 +1,180 @@
+#include "KernelCheck.h"
+#include "core/services/CubeKernels.h"
+#include "core/services/FinanceCube.h"
+#include "infrastructure/database/DatabaseManager.h"
+#include <QCoreApplication>
+#include <QDate>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <cstdio>
+#include <map>
+
+/**
+ * @file CubeBench.cpp
+ * @brief Verificación de kernels y comparación FinanceCube contra SQL
+ *
+ * Uso: gymos_cube_bench [filas] (por defecto 1 000 000). GYMOS_SIMD elige
+ * los kernels; el target gymos_cube_bench_all corre las tres variantes.
+ * Devuelve distinto de cero si algún resultado difiere.
+ */
+
+using namespace GymOS::Core::Services;
+using GymOS::Infrastructure::Database::DatabaseManager;
+
+namespace {
+
+constexpr int kRepeats = 20;
+
+/// Inserta `rows` movimientos aleatorios de los últimos tres años
+bool seedLedger(QSqlDatabase &db, qint64 rows) {
+  static const char *const kIncomeTypes[] = {
+      "enrollment_income", "renewal_income", "custom_income"};
+
+  QRandomGenerator rng(7);
+  const QDate today = QDate::currentDate();
+
+  if (!db.transaction()) {
+    return false;
+  }
+  QSqlQuery insert(db);
+  insert.prepare("INSERT INTO financial_entries "
+                 "(entry_type, classification, amount, description, "
+                 "entry_date) VALUES (?, ?, ?, 'bench', ?)");
+  for (qint64 i = 0; i < rows; ++i) {
+    const bool expense = rng.bounded(4) == 0;
+    insert.addBindValue(expense ? "custom_expense"
+                                : kIncomeTypes[rng.bounded(3)]);
+    insert.addBindValue(expense ? "expense" : "income");
+    insert.addBindValue(double(1 + rng.bounded(500000)) / 100.0);
+    insert.addBindValue(
+        today.addDays(-qint64(rng.bounded(3 * 365))).toString(Qt::ISODate));
+    if (!insert.exec()) {
+      std::printf("Error insertando: %s\n",
+                  qPrintable(insert.lastError().text()));
+      db.rollback();
+      return false;
+    }
+  }
+  return db.commit();
+}
+
+template <typename Fn> double averageUs(Fn &&fn) {
+  QElapsedTimer timer;
+  timer.start();
+  for (int i = 0; i < kRepeats; ++i) {
+    fn();
+  }
+  return double(timer.nsecsElapsed()) / 1000.0 / kRepeats;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+
+  int failures = GymOS::Bench::checkCubeKernels(20240501);
+
+  const qint64 rows = argc > 1 ? QByteArray(argv[1]).toLongLong() : 1000000;
+  QTemporaryDir dir;
+  if (!dir.isValid() ||
+      !DatabaseManager::instance().initialize(dir.filePath("bench.db"))) {
+    std::printf("No se pudo crear la base de datos temporal\n");
+    return 1;
+  }
+  QSqlDatabase &db = DatabaseManager::instance().database();
+
+  QElapsedTimer timer;
+  timer.start();
+  if (!seedLedger(db, rows)) {
+    return 1;
+  }
+  std::printf("%lld filas sintéticas insertadas en %lld ms\n", rows,
+              timer.elapsed());
+
+  FinanceCube &cube = FinanceCube::instance();
+  timer.restart();
+  cube.sync();
+  std::printf("FinanceCube::sync: %lld ms (%zu filas)\n", timer.elapsed(),
+              cube.size());
+
+  // Totales: cubo contra GROUP BY classification
+  const CubeFilter all;
+  CubeCell cubeTotals;
+  const double cubeTotalsUs = averageUs([&] { cubeTotals = cube.totals(all); });
+
+  CubeCell sqlTotals;
+  const double sqlTotalsUs = averageUs([&] {
+    sqlTotals = CubeCell();
+    QSqlQuery query(db);
+    query.exec("SELECT classification, "
+               "SUM(CAST(ROUND(amount * 100) AS INTEGER)), COUNT(*) "
+               "FROM financial_entries GROUP BY classification");
+    while (query.next()) {
+      const qint64 cents = query.value(1).toLongLong();
+      (query.value(0).toString() == "expense" ? sqlTotals.expenseCents
+                                              : sqlTotals.incomeCents) +=
+          cents;
+      sqlTotals.count += query.value(2).toLongLong();
+    }
+  });
+
+  const bool totalsMatch = cubeTotals.incomeCents == sqlTotals.incomeCents &&
+                           cubeTotals.expenseCents == sqlTotals.expenseCents &&
+                           cubeTotals.count == sqlTotals.count;
+  failures += totalsMatch ? 0 : 1;
+  std::printf("totals    cubo %10.1f us   SQL %10.1f us   %s\n", cubeTotalsUs,
+              sqlTotalsUs, totalsMatch ? "iguales" : "DIFERENTES");
+
+  // Desglose de 12 meses, como FinanceEngine::getMonthlyBreakdown
+  const QDate to = QDate::currentDate();
+  const QDate start = to.addMonths(-11);
+  CubeFilter months;
+  months.from = QDate(start.year(), start.month(), 1);
+  months.to = to;
+
+  CubeResult cubeMonths;
+  const double cubeMonthsUs = averageUs(
+      [&] { cubeMonths = cube.aggregate(CubeDimension::Month, months); });
+
+  std::map<qint64, CubeCell> sqlMonths;
+  const double sqlMonthsUs = averageUs([&] {
+    sqlMonths.clear();
+    QSqlQuery query(db);
+    query.prepare("SELECT CAST(strftime('%Y', entry_date) AS INTEGER) * 12 + "
+                  "CAST(strftime('%m', entry_date) AS INTEGER) - 1 AS month, "
+                  "classification, "
+                  "SUM(CAST(ROUND(amount * 100) AS INTEGER)), COUNT(*) "
+                  "FROM financial_entries "
+                  "WHERE entry_date BETWEEN ? AND ? "
+                  "GROUP BY month, classification");
+    query.addBindValue(months.from.toString(Qt::ISODate));
+    query.addBindValue(months.to.toString(Qt::ISODate));
+    query.exec();
+    while (query.next()) {
+      CubeCell &cell = sqlMonths[query.value(0).toLongLong()];
+      const qint64 cents = query.value(2).toLongLong();
+      (query.value(1).toString() == "expense" ? cell.expenseCents
+                                              : cell.incomeCents) += cents;
+      cell.count += query.value(3).toLongLong();
+    }
+  });
+
+  bool monthsMatch = true;
+  for (const CubeCell &cell : cubeMonths.cells) {
+    const auto it = sqlMonths.find(cell.key);
+    const CubeCell expected = it != sqlMonths.end() ? it->second : CubeCell();
+    monthsMatch = monthsMatch && cell.incomeCents == expected.incomeCents &&
+                  cell.expenseCents == expected.expenseCents &&
+                  cell.count == expected.count;
+  }
+  monthsMatch = monthsMatch && cubeMonths.cells.size() >= sqlMonths.size();
+  failures += monthsMatch ? 0 : 1;
+  std::printf("12 meses  cubo %10.1f us   SQL %10.1f us   %s\n", cubeMonthsUs,
+              sqlMonthsUs, monthsMatch ? "iguales" : "DIFERENTES");
+
+  std::printf("Kernels: %s\n", GymOS::Core::Services::CubeKernels::isaName());
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+#include "KernelCheck.h"
+#include "core/services/CubeKernels.h"
+#include "core/services/CubeKernelsIsa.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace GymOS::Bench {
+
+namespace CubeKernels = GymOS::Core::Services::CubeKernels;
+
+namespace {
+
+/// Columnas de una prueba, con `offset` elementos de relleno al inicio
+struct Columns {
+  std::vector<int32_t> days;
+  std::vector<uint8_t> types;
+  std::vector<uint16_t> plans;
+  std::vector<uint8_t> classes;
+  std::vector<int64_t> cents;
+  std::vector<uint8_t> months8;
+  std::vector<uint16_t> months16;
+};
+
+Columns randomColumns(std::mt19937 &rng, size_t n, size_t offset) {
+  std::uniform_int_distribution<int32_t> day(2450000, 2450400);
+  std::uniform_int_distribution<int> small(0, 3);
+  std::uniform_int_distribution<int> plan(0, 5);
+  std::uniform_int_distribution<int> bit(0, 1);
+  std::uniform_int_distribution<int64_t> amount(1, 5'000'000);
+  std::uniform_int_distribution<int> month(0, 23);
+  std::uniform_int_distribution<int> run(0, 7);
+
+  Columns c;
+  const size_t size = n + offset;
+  c.days.resize(size);
+  c.types.resize(size);
+  c.plans.resize(size);
+  c.classes.resize(size);
+  c.cents.resize(size);
+  c.months8.resize(size);
+  c.months16.resize(size);
+
+  // Claves en rachas, como el libro cargado en orden de fecha
+  int key = month(rng);
+  for (size_t i = 0; i < size; ++i) {
+    if (run(rng) == 0) {
+      key = month(rng);
+    }
+    c.days[i] = day(rng);
+    c.types[i] = static_cast<uint8_t>(small(rng));
+    c.plans[i] = static_cast<uint16_t>(plan(rng));
+    c.classes[i] = static_cast<uint8_t>(bit(rng));
+    c.cents[i] = amount(rng);
+    c.months8[i] = static_cast<uint8_t>(key);
+    c.months16[i] = static_cast<uint16_t>(key * 37);
+  }
+  return c;
+}
+
+bool sameTotals(const CubeKernels::MaskedTotals &a,
+                const CubeKernels::MaskedTotals &b) {
+  return a.incomeCents == b.incomeCents && a.expenseCents == b.expenseCents &&
+         a.count == b.count;
+}
+
+struct Sums {
+  explicit Sums(size_t keys) : income(keys), expense(keys), count(keys) {}
+
+  CubeKernels::GroupSums view() {
+    return {income.data(), expense.data(), count.data()};
+  }
+  bool operator==(const Sums &other) const {
+    return income == other.income && expense == other.expense &&
+           count == other.count;
+  }
+
+  std::vector<int64_t> income;
+  std::vector<int64_t> expense;
+  std::vector<int64_t> count;
+};
+
+int checkOne(std::mt19937 &rng, size_t n, size_t offset) {
+  const Columns c = randomColumns(rng, n, offset);
+  const int32_t *days = c.days.data() + offset;
+  const uint8_t *types = c.types.data() + offset;
+  const uint16_t *plans = c.plans.data() + offset;
+  const uint8_t *classes = c.classes.data() + offset;
+  const int64_t *cents = c.cents.data() + offset;
+  const uint8_t *months8 = c.months8.data() + offset;
+  const uint16_t *months16 = c.months16.data() + offset;
+
+  int failures = 0;
+  auto fail = [&](const char *kernel) {
+    std::printf("  DIFERENCIA %s: n=%zu offset=%zu\n", kernel, n, offset);
+    ++failures;
+  };
+
+  // Selección (la salida también desalineada)
+  std::vector<uint8_t> ref(n + offset), got(n + offset);
+  CubeKernels::Scalar::selectRange(days, n, 2450100, 2450300,
+                                   ref.data() + offset);
+  CubeKernels::selectRange(days, n, 2450100, 2450300, got.data() + offset);
+  if (ref != got) {
+    fail("selectRange");
+  }
+
+  CubeKernels::Scalar::filterMask(types, n, 0b1011, ref.data() + offset);
+  CubeKernels::filterMask(types, n, 0b1011, got.data() + offset);
+  if (ref != got) {
+    fail("filterMask");
+  }
+
+  CubeKernels::Scalar::filterEqual(plans, n, 2, ref.data() + offset);
+  CubeKernels::filterEqual(plans, n, 2, got.data() + offset);
+  if (ref != got) {
+    fail("filterEqual");
+  }
+
+  // Agregación sobre una selección mixta
+  std::vector<uint8_t> sel(n + offset);
+  CubeKernels::Scalar::selectRange(days, n, 2450050, 2450350,
+                                   sel.data() + offset);
+  const uint8_t *mask = sel.data() + offset;
+
+  if (!sameTotals(CubeKernels::Scalar::sumSelected(mask, classes, cents, n),
+                  CubeKernels::sumSelected(mask, classes, cents, n))) {
+    fail("sumSelected");
+  }
+
+  Sums ref8(24), got8(24);
+  CubeKernels::Scalar::sumByKey8(months8, mask, classes, cents, n,
+                                 ref8.view());
+  CubeKernels::sumByKey(months8, mask, classes, cents, n, got8.view());
+  if (!(ref8 == got8)) {
+    fail("sumByKey(uint8_t)");
+  }
+
+  Sums ref16(23 * 37 + 1), got16(23 * 37 + 1);
+  CubeKernels::Scalar::sumByKey16(months16, mask, classes, cents, n,
+                                  ref16.view());
+  CubeKernels::sumByKey(months16, mask, classes, cents, n, got16.view());
+  if (!(ref16 == got16)) {
+    fail("sumByKey(uint16_t)");
+  }
+
+  return failures;
+}
+
+} // namespace
+
+int checkCubeKernels(uint32_t seed) {
+  std::mt19937 rng(seed);
+  int failures = 0;
+  int cases = 0;
+
+  for (size_t n = 0; n <= 96; ++n) {
+    for (size_t offset = 0; offset < 3; ++offset) {
+      failures += checkOne(rng, n, offset);
+      ++cases;
+    }
+  }
+  for (size_t n : {size_t(1000), size_t(4097), size_t(65536 + 31)}) {
+    failures += checkOne(rng, n, 1);
+    ++cases;
+  }
+
+  std::printf("Kernels %s contra escalar: %d casos, %d diferencias\n",
+              CubeKernels::isaName(), cases, failures);
+  return failures;
+}
+
+} // namespace GymOS::Bench
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GymOS::Bench {
+
+/**
+ * @brief Compara los kernels de CubeKernels elegidos en runtime con la
+ * versión escalar
+ *
+ * Columnas aleatorias de todas las longitudes de 0 a 96 (todos los restos
+ * módulo 32 varias veces) y algunas largas, empezando en direcciones
+ * desalineadas. GYMOS_SIMD=scalar|sse41|avx2 fija la versión que se
+ * compara.
+ * @return Cantidad de diferencias (0 = iguales)
+ */
+int checkCubeKernels(uint32_t seed);
+
+} // namespace GymOS::Bench
@@ -0,0 +1,65 @@
+#include "infrastructure/diagnostics/Logging.h"
+#include <QCoreApplication>
+#include <QDate>
+#include <QElapsedTimer>
+#include <cstdio>
+
+/**
+ * @file TraceBench.cpp
+ * @brief Costo de una sentencia GYM_TRACE por iteración
+ *
+ * Se compila dos veces: gymos_trace_bench (GYM_TRACE activo, como en
+ * Debug) y gymos_trace_bench_notrace (con GYMOS_NO_TRACE_LOGS, como en
+ * release). Uso: gymos_trace_bench [iteraciones] (por defecto 1 000 000).
+ */
+
+namespace {
+
+qint64 g_delivered = 0;
+
+/// Como el handler de main.cpp, pero sin escribir: mide el formateo
+void countingHandler(QtMsgType, const QMessageLogContext &, const QString &) {
+  ++g_delivered;
+}
+
+double nsPerIteration(qint64 iterations) {
+  const QDate base(2024, 1, 1);
+  QElapsedTimer timer;
+  timer.start();
+  for (qint64 i = 0; i < iterations; ++i) {
+    GYM_TRACE(lcController)
+        << "Vencimiento:" << base.addDays(i % 365).toString("dd/MM/yyyy");
+  }
+  return double(timer.nsecsElapsed()) / double(iterations);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+  qInstallMessageHandler(countingHandler);
+
+  const qint64 iterations =
+      argc > 1 ? QByteArray(argv[1]).toLongLong() : 1000000;
+
+#ifdef GYMOS_NO_TRACE_LOGS
+  const char *build = "GYMOS_NO_TRACE_LOGS";
+#else
+  const char *build = "GYM_TRACE activo";
+#endif
+
+  // Categoría habilitada: el mensaje se formatea y llega al handler
+  QLoggingCategory::setFilterRules("gymos.*.debug=true");
+  const double enabledNs = nsPerIteration(iterations);
+  const qint64 delivered = g_delivered;
+
+  // Categoría deshabilitada en runtime: solo la comprobación del nivel
+  QLoggingCategory::setFilterRules("gymos.*.debug=false");
+  const double disabledNs = nsPerIteration(iterations);
+
+  std::printf("%s, %lld iteraciones\n", build, iterations);
+  std::printf("  categoría habilitada:    %8.1f ns/iter (%lld mensajes)\n",
+              enabledNs, delivered);
+  std::printf("  categoría deshabilitada: %8.1f ns/iter\n", disabledNs);
+  return 0;
+}
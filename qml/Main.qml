@@ -2,9 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Window 2.15
-import "."  // Para Theme singleton
-import "components"
-import "views"
+import GymOSQml
 
 /**
  * GymOS - Ventana Principal
@@ -27,6 +25,9 @@ ApplicationWindow {
     // Propiedades de Estado
     // ========================================================================
     property int currentViewIndex: 0
+    // Nombres con los que cada vista se registra en GymController (mismo orden
+    // que el StackLayout)
+    readonly property var viewNames: ["dashboard", "newSubscriber", "plans", "subscriptions", "finance", "analytics"]
     property bool sidebarExpanded: true
     
     // ========================================================================
@@ -121,6 +122,13 @@ ApplicationWindow {
                     Layout.fillWidth: true
                     Layout.fillHeight: true
                 }
+                
+                // Vista 5: Análisis
+                AnalyticsView {
+                    id: analyticsView
+                    Layout.fillWidth: true
+                    Layout.fillHeight: true
+                }
             }
         }
         
@@ -148,9 +156,13 @@ ApplicationWindow {
         }
     }
     
+    Component.onCompleted: GymController.setActiveView(viewNames[currentViewIndex])
+    
     // Monitor currentViewIndex changes and force repaint
     onCurrentViewIndexChanged: {
         console.log("[Main.qml] currentViewIndex property changed to:", currentViewIndex)
+        // Las vistas ocultas difieren sus recargas hasta volver a mostrarse
+        GymController.setActiveView(viewNames[currentViewIndex])
         // Use gentle repaint for Wine compatibility
         Qt.callLater(forceRepaint)
     }
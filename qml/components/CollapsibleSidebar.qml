@@ -2,7 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Effects
-import ".."
+import GymOSQml
 
 /**
  * Sidebar Colapsable
@@ -134,6 +134,11 @@ Rectangle {
                     iconName: "finance"
                     viewIndex: 4
                 }
+                ListElement { 
+                    title: "Análisis"
+                    iconName: "analytics"
+                    viewIndex: 5
+                }
             }
             
             delegate: Rectangle {
@@ -228,16 +233,14 @@ Rectangle {
             
             // Cargar valor persistido al iniciar
             Component.onCompleted: {
-                if (typeof gymController !== 'undefined') {
-                    Theme.darkMode = gymController.darkMode
-                }
+                Theme.darkMode = GymController.darkMode
             }
             
-            // Sincronizar cambios desde gymController
+            // Sincronizar cambios desde GymController
             Connections {
-                target: typeof gymController !== 'undefined' ? gymController : null
+                target: GymController
                 function onDarkModeChanged() {
-                    Theme.darkMode = gymController.darkMode
+                    Theme.darkMode = GymController.darkMode
                 }
             }
             
@@ -283,9 +286,7 @@ Rectangle {
                     // Toggle y persistir
                     var newValue = !Theme.darkMode
                     Theme.darkMode = newValue
-                    if (typeof gymController !== 'undefined') {
-                        gymController.darkMode = newValue
-                    }
+                    GymController.darkMode = newValue
                 }
             }
         }
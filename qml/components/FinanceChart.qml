@@ -1,12 +1,14 @@
 import QtQuick 2.15
 import QtQuick.Layouts 1.15
-import ".."
+import QtCharts 2.15
+import GymOSQml
 
 /**
  * FinanceChart - Gráfico de Finanzas "Maybe Style"
  * 
- * Visualización de línea suave con gradiente, usando Canvas.
- * Muestra el balance neto o la métrica principal.
+ * Área con el balance neto por mes, dibujada con ChartView. Los puntos
+ * salen de chartModel por un VXYModelMapper: al cambiar un mes se mueve
+ * solo ese punto, sin rearmar la serie en JavaScript.
  */
 Item {
     id: root
@@ -14,7 +16,9 @@ Item {
     // ========================================================================
     // Propiedades
     // ========================================================================
-    property var monthlyData: []
+    // Modelo C++ con un punto por mes (ceros incluidos); al registrar un
+    // movimiento solo cambia la fila del mes afectado
+    property FinanceChartModel chartModel: null
     property string title: "Ingresos vs Gastos"
     
     // Configuracion visual
@@ -24,8 +28,6 @@ Item {
     
     implicitHeight: 300
     
-    onMonthlyDataChanged: chartCanvas.requestPaint()
-    
     // ========================================================================
     // Contenido
     // ========================================================================
@@ -66,139 +68,54 @@ Item {
             Layout.fillWidth: true
             Layout.fillHeight: true
             
-            Canvas {
-                id: chartCanvas
+            ChartView {
+                id: chartView
                 anchors.fill: parent
-                // Margen interno para no cortar la línea
-                anchors.margins: 10 
-                antialiasing: true // Critical for smooth lines
-                
-                Component.onCompleted: {
-                    console.log("[FinanceChart] Canvas completed")
-                    requestPaint()
+                // Las etiquetas de los meses van en el Row de abajo
+                anchors.bottomMargin: 20
+                antialiasing: true
+                backgroundColor: "transparent"
+                legend.visible: false
+                margins { top: 0; bottom: 0; left: 0; right: 0 }
+
+                ValueAxis {
+                    id: monthAxis
+                    min: 0
+                    max: Math.max(1, (root.chartModel ? root.chartModel.count : 0) - 1)
+                    visible: false
                 }
-                
-                onPaint: {
-                    var ctx = getContext("2d")
-                    var w = width
-                    var h = height
-                    console.log("[FinanceChart] Painting canvas. Size: " + w + "x" + h)
-                    
-                    ctx.clearRect(0, 0, w, h)
-                    
-                    // --- 1. Preparar Datos ---
-                    var points = []
-                    
-                    // Si no hay datos reales o están vacíos, usar mock para visualizar diseño
-                    // Check validity of first item to ensure it has required properties
-                    var validData = (monthlyData && monthlyData.length > 0 && monthlyData[0].month !== undefined);
-                    
-                    var dataToDraw = validData ? monthlyData : [
-                        { month: "En", income: 2000000, expense: 1500000 },
-                        { month: "Feb", income: 2500000, expense: 1200000 },
-                        { month: "Mar", income: 2200000, expense: 2000000 },
-                        { month: "Abr", income: 3200000, expense: 1800000 },
-                        { month: "May", income: 2800000, expense: 1500000 },
-                        { month: "Jun", income: 4500000, expense: 2000000 }
-                    ]
-                    
-                    console.log("[FinanceChart] Drawing with " + dataToDraw.length + " points. Source: " + (validData ? "REAL" : "MOCK"))
-                    
-                    // Calcular "Balance" para cada mes (puntos Y)
-                    var values = []
-                    var maxVal = -Infinity
-                    var minVal = Infinity
-                    
-                    for (var i = 0; i < dataToDraw.length; i++) {
-                        var net = dataToDraw[i].income - dataToDraw[i].expense
-                        values.push(net)
-                        if (net > maxVal) maxVal = net
-                        if (net < minVal) minVal = net
-                    }
-                    
-                    // Ensure baseline 0 is visible or chart is centered
-                    if (minVal > 0) minVal = 0
-                    var range = maxVal - minVal
-                    if (range === 0) range = 100 // Avoid divide by zero
-                    
-                    // Add padding to range
-                    maxVal += range * 0.1
-                    // minVal -= range * 0.1 // Optional bottom padding
-                    var plotRange = maxVal - minVal
-                    
-                    // Compute coordinate points
-                    var stepX = w / (values.length - 1)
-                    
-                    for (var j = 0; j < values.length; j++) {
-                        var val = values[j]
-                        // Normalized Y (0 at bottom, 1 at top)
-                        // Canvas Y is 0 at top. So we invert.
-                        var normalizedY = (val - minVal) / plotRange
-                        var px = j * stepX
-                        var py = h - (normalizedY * h)
-                        points.push({x: px, y: py})
-                    }
-                    
-                    if (points.length < 2) return
-                    
-                    // --- 2. Dibujar Gradiente (Relleno) ---
-                    ctx.beginPath()
-                    ctx.moveTo(points[0].x, h) // Start bottom-left
-                    ctx.lineTo(points[0].x, points[0].y)
-                    
-                    // Smooth curve using Catmull-Rom or cubic Bezier
-                    // Simplified: Control points for smooth spline
-                    for (var k = 0; k < points.length - 1; k++) {
-                        var p0 = points[k]
-                        var p1 = points[k+1]
-                        
-                        // Simple midpoint bezier for smoothness
-                        var midX = (p0.x + p1.x) / 2
-                        var cp1x = midX
-                        var cp1y = p0.y
-                        var cp2x = midX
-                        var cp2y = p1.y
-                        
-                        ctx.bezierCurveTo(cp1x, cp1y, cp2x, cp2y, p1.x, p1.y)
-                    }
-                    
-                    ctx.lineTo(w, h) // Line to bottom-right
-                    ctx.closePath()
-                    
-                    var gradient = ctx.createLinearGradient(0, 0, 0, h)
-                    gradient.addColorStop(0, Qt.rgba(34/255, 197/255, 94/255, 0.2)) // Green-500 @ 20%
-                    gradient.addColorStop(1, Qt.rgba(34/255, 197/255, 94/255, 0.0)) // Transparent
-                    ctx.fillStyle = gradient
-                    ctx.fill()
-                    
-                    // --- 3. Dibujar Línea (Stroke) ---
-                    ctx.beginPath()
-                    ctx.moveTo(points[0].x, points[0].y)
-                    
-                    for (var m = 0; m < points.length - 1; m++) {
-                        var pp0 = points[m]
-                        var pp1 = points[m+1]
-                        var mX = (pp0.x + pp1.x) / 2
-                        ctx.bezierCurveTo(mX, pp0.y, mX, pp1.y, pp1.x, pp1.y)
+
+                // Incluye el 0 y deja un 10% de aire arriba
+                ValueAxis {
+                    id: balanceAxis
+                    readonly property real low: root.chartModel ? Math.min(0, root.chartModel.minBalance) : 0
+                    readonly property real high: root.chartModel ? root.chartModel.maxBalance : 0
+                    readonly property real span: high - low > 0 ? high - low : 100
+                    min: low
+                    max: high + span * 0.1
+                    visible: false
+                }
+
+                AreaSeries {
+                    axisX: monthAxis
+                    axisY: balanceAxis
+                    color: Qt.rgba(34/255, 197/255, 94/255, 0.2) // Green-500 @ 20%
+                    borderColor: root.lineColor
+                    borderWidth: 3
+                    upperSeries: LineSeries {
+                        id: balanceLine
                     }
-                    
-                    ctx.strokeStyle = root.lineColor
-                    ctx.lineWidth = 3
-                    ctx.lineCap = "round"
-                    ctx.lineJoin = "round"
-                    ctx.stroke()
-                    
-                    // --- 4. Etiquetas Eje X ---
-                    // Dibujar meses en la parte inferior si hay espacio
-                    // (Opcional, pero útil)
                 }
-                
-                // Refresh triggers
-                onWidthChanged: requestPaint()
-                onHeightChanged: requestPaint()
+
+                VXYModelMapper {
+                    model: root.chartModel
+                    series: balanceLine
+                    xColumn: FinanceChartModel.IndexColumn
+                    yColumn: FinanceChartModel.BalanceColumn
+                }
             }
             
-            // Overlay Labels (HTML/QML Text is sharper than Canvas Text)
+            // Etiquetas de los meses (una por fila del modelo)
             Row {
                 anchors.bottom: parent.bottom
                 anchors.left: parent.left
@@ -206,18 +123,16 @@ Item {
                 height: 20
                 
                 Repeater {
-                    model: (root.monthlyData && root.monthlyData.length > 0) ? root.monthlyData : [
-                        { month: "Jul" }, { month: "Ago" }, { month: "Sep" }, 
-                        { month: "Oct" }, { month: "Nov" }, { month: "Dic" }
-                    ]
+                    id: labelRepeater
+                    model: root.chartModel
                     
                     Item {
-                        width: parent.width / 6 // Assumes 6 months fix or adjust dynamically
+                        width: parent.width / labelRepeater.count
                         height: parent.height
                         
                         Text {
                             anchors.centerIn: parent
-                            text: modelData.month
+                            text: model.label
                             font.family: Theme.fontFamily
                             font.pixelSize: Theme.fontSizeXS
                             color: Theme.textSecondary
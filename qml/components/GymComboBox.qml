@@ -2,7 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Effects
-import ".."
+import GymOSQml
 
 /**
  * GymComboBox - ComboBox Personalizado
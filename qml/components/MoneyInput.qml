@@ -1,5 +1,5 @@
 import QtQuick 2.15
-import ".."
+import GymOSQml
 
 /**
  * MoneyInput - Campo de entrada monetario
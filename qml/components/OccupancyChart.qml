@@ -0,0 +1,158 @@
+import QtQuick 2.15
+import QtQuick.Layouts 1.15
+import GymOSQml
+
+/**
+ * OccupancyChart - Ocupación por Hora
+ * 
+ * Barras con el promedio de ingresos por hora del día, usando Canvas
+ * (mismo patrón que FinanceChart). La hora pico se resalta.
+ */
+Item {
+    id: root
+    
+    // ========================================================================
+    // Propiedades
+    // ========================================================================
+    property var hourlyData: []     // [{ hour, label, visits, isPeak }]
+    property string title: "Ocupación por Hora"
+    property string subtitle: ""
+    
+    // Solo se dibuja el horario de apertura habitual
+    property int firstHour: 6
+    property int lastHour: 23
+    
+    // Configuracion visual
+    property color barColor: Theme.primary
+    property color peakColor: Theme.warning
+    
+    implicitHeight: 220
+    
+    onHourlyDataChanged: chartCanvas.requestPaint()
+    onBarColorChanged: chartCanvas.requestPaint()
+    
+    readonly property var visibleHours: {
+        var hours = []
+        if (!hourlyData) return hours
+        for (var i = 0; i < hourlyData.length; i++) {
+            var h = hourlyData[i].hour
+            if (h >= firstHour && h <= lastHour) hours.push(hourlyData[i])
+        }
+        return hours
+    }
+    
+    // ========================================================================
+    // Contenido
+    // ========================================================================
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: Theme.spacingM
+        
+        // Header
+        RowLayout {
+            Layout.fillWidth: true
+            Text {
+                text: title
+                font.family: Theme.fontFamily
+                font.pixelSize: Theme.fontSizeL
+                font.weight: Theme.fontWeightMedium
+                color: Theme.textPrimary
+            }
+            Item { Layout.fillWidth: true }
+            Text {
+                text: subtitle
+                font.family: Theme.fontFamily
+                font.pixelSize: Theme.fontSizeS
+                color: Theme.textSecondary
+            }
+        }
+        
+        // Area del Gráfico
+        Item {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            
+            Canvas {
+                id: chartCanvas
+                anchors.left: parent.left
+                anchors.right: parent.right
+                anchors.top: parent.top
+                anchors.bottom: labelsRow.top
+                anchors.bottomMargin: Theme.spacingXS
+                antialiasing: true
+                
+                onPaint: {
+                    var ctx = getContext("2d")
+                    var w = width
+                    var h = height
+                    ctx.clearRect(0, 0, w, h)
+                    
+                    var data = root.visibleHours
+                    if (data.length === 0) return
+                    
+                    var maxVal = 0
+                    for (var i = 0; i < data.length; i++) {
+                        if (data[i].visits > maxVal) maxVal = data[i].visits
+                    }
+                    if (maxVal === 0) maxVal = 1 // Sin datos: barras vacías
+                    
+                    var slot = w / data.length
+                    var barWidth = Math.max(2, slot * 0.7)
+                    var radius = Math.min(4, barWidth / 2)
+                    
+                    for (var j = 0; j < data.length; j++) {
+                        var barHeight = (data[j].visits / maxVal) * h
+                        if (barHeight <= 0) continue
+                        
+                        var x = j * slot + (slot - barWidth) / 2
+                        var y = h - barHeight
+                        
+                        // Barra con esquinas superiores redondeadas
+                        ctx.beginPath()
+                        ctx.moveTo(x, h)
+                        ctx.lineTo(x, y + radius)
+                        ctx.quadraticCurveTo(x, y, x + radius, y)
+                        ctx.lineTo(x + barWidth - radius, y)
+                        ctx.quadraticCurveTo(x + barWidth, y, x + barWidth, y + radius)
+                        ctx.lineTo(x + barWidth, h)
+                        ctx.closePath()
+                        
+                        ctx.fillStyle = data[j].isPeak ? root.peakColor : root.barColor
+                        ctx.fill()
+                    }
+                }
+                
+                // Refresh triggers
+                onWidthChanged: requestPaint()
+                onHeightChanged: requestPaint()
+            }
+            
+            // Etiquetas de horas (cada 3 horas para no saturar)
+            Row {
+                id: labelsRow
+                anchors.bottom: parent.bottom
+                anchors.left: parent.left
+                anchors.right: parent.right
+                height: 16
+                
+                Repeater {
+                    model: root.visibleHours
+                    
+                    Item {
+                        width: labelsRow.width / Math.max(1, root.visibleHours.length)
+                        height: labelsRow.height
+                        
+                        Text {
+                            anchors.centerIn: parent
+                            visible: modelData.hour % 3 === 0
+                            text: modelData.label
+                            font.family: Theme.fontFamily
+                            font.pixelSize: Theme.fontSizeXS
+                            color: Theme.textSecondary
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,517 @@
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+import QtQuick.Layouts 1.15
+import QtQuick.Effects
+import GymOSQml
+
+/**
+ * AnalyticsView - Análisis Financiero
+ * 
+ * Ingresos y gastos agrupados por mes, tipo de movimiento, plan o día de
+ * la semana, con filtros combinables. Las consultas van al cubo en memoria
+ * (GymController.getFinanceCube), así que cambiar un filtro recalcula al
+ * instante sin consultar la base.
+ *
+ * Debajo, el estado anual de los últimos años (totales, plan principal y
+ * valor por miembro), que se genera en segundo plano en varios hilos, y la
+ * retención mensual por cohorte (CohortEngine).
+ */
+Item {
+    id: root
+    
+    // ========================================================================
+    // Propiedades de Estado
+    // ========================================================================
+    property string dimension: "month"
+    property int periodMonths: 12
+    property string classification: ""
+    property int planId: -1
+    
+    // Resultado de la última consulta
+    property var cells: []
+    property int scannedRows: 0
+    property real elapsedUs: 0
+    
+    // Máximo de la serie, para escalar las barras
+    readonly property real maxValue: {
+        var max = 0
+        for (var i = 0; i < cells.length; i++) {
+            max = Math.max(max, cells[i].income, cells[i].expense)
+        }
+        return max
+    }
+    
+    property var planOptions: [{ text: "Todos", value: -1 }]
+    
+    // Estado anual (GymController.buildStatement, en segundo plano)
+    property int statementYears: 5
+    property var statement: null
+    
+    // Retención por cohorte (últimas 12 cohortes)
+    property var retention: ({ rows: [], maxOffset: 0 })
+    
+    Connections {
+        target: GymController
+        function onStatementReady(result) {
+            statement = result
+        }
+        function onViewRefreshRequested(view, domains) {
+            if (view !== "analytics") return
+            if (domains & ChangeTracker.Plans) {
+                refreshPlans()
+            }
+            if (domains & (ChangeTracker.Subscriptions | ChangeTracker.Plans)) {
+                refreshRetention()
+            }
+            refreshData()
+        }
+    }
+    
+    Component.onCompleted: {
+        GymController.registerView("analytics", ChangeTracker.Finance | ChangeTracker.Plans
+                                                | ChangeTracker.Subscriptions)
+        if (GymController.ready) {
+            refreshPlans()
+            refreshRetention()
+            refreshData()
+        }
+        Tracer.instant("AnalyticsView loaded")
+    }
+    
+    function refreshPlans() {
+        var options = [{ text: "Todos", value: -1 }, { text: "Sin plan", value: 0 }]
+        var plans = GymController.plans
+        for (var i = 0; i < plans.length; i++) {
+            options.push({ text: plans[i].name, value: plans[i].id })
+        }
+        planOptions = options
+    }
+    
+    function refreshData() {
+        var today = new Date()
+        var filter = {
+            classification: classification,
+            planId: planId
+        }
+        if (periodMonths > 0) {
+            filter.from = new Date(today.getFullYear(), today.getMonth() - periodMonths + 1, 1)
+            filter.to = today
+        }
+        var result = GymController.getFinanceCube(dimension, filter)
+        cells = result.cells
+        scannedRows = result.rows
+        elapsedUs = result.elapsedUs
+    }
+    
+    function refreshRetention() {
+        retention = GymController.getCohortRetention(12)
+    }
+    
+    function buildStatement() {
+        var year = new Date().getFullYear()
+        GymController.buildStatement(year - statementYears + 1, year)
+    }
+    
+    function formatCurrency(amount) {
+        return "$" + Math.round(amount).toString().replace(/\B(?=(\d{3})+(?!\d))/g, ".")
+    }
+    
+    // ========================================================================
+    // Layout Principal
+    // ========================================================================
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: Theme.spacingXL
+        
+        // Encabezado
+        ColumnLayout {
+            spacing: Theme.spacingXS
+            
+            Text {
+                text: "Análisis"
+                font.family: Theme.fontFamily
+                font.pixelSize: Theme.fontSizeTitle
+                font.weight: Theme.fontWeightBold
+                color: Theme.textPrimary
+            }
+            
+            Text {
+                text: "Ingresos y gastos por mes, tipo, plan y día de la semana"
+                font.family: Theme.fontFamily
+                font.pixelSize: Theme.fontSizeM
+                color: Theme.textSecondary
+            }
+        }
+        
+        // Filtros
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Theme.spacingM
+            
+            GymComboBox {
+                Layout.preferredWidth: 200
+                label: "Agrupar por"
+                model: [
+                    { text: "Mes", value: "month" },
+                    { text: "Tipo de movimiento", value: "type" },
+                    { text: "Plan", value: "plan" },
+                    { text: "Día de la semana", value: "weekday" }
+                ]
+                currentIndex: 0
+                onActivated: {
+                    dimension = currentValue
+                    refreshData()
+                }
+            }
+            
+            GymComboBox {
+                Layout.preferredWidth: 180
+                label: "Período"
+                model: [
+                    { text: "3 meses", value: 3 },
+                    { text: "6 meses", value: 6 },
+                    { text: "1 año", value: 12 },
+                    { text: "2 años", value: 24 },
+                    { text: "Todo", value: 0 }
+                ]
+                currentIndex: 2
+                onActivated: {
+                    periodMonths = currentValue
+                    refreshData()
+                }
+            }
+            
+            GymComboBox {
+                Layout.preferredWidth: 180
+                label: "Clasificación"
+                model: [
+                    { text: "Todos", value: "" },
+                    { text: "Ingresos", value: "income" },
+                    { text: "Gastos", value: "expense" }
+                ]
+                currentIndex: 0
+                onActivated: {
+                    classification = currentValue
+                    refreshData()
+                }
+            }
+            
+            GymComboBox {
+                Layout.preferredWidth: 200
+                label: "Plan"
+                model: planOptions
+                currentIndex: 0
+                onActivated: {
+                    planId = currentValue
+                    refreshData()
+                }
+            }
+            
+            Item { Layout.fillWidth: true }
+            
+            Text {
+                Layout.alignment: Qt.AlignBottom
+                text: scannedRows + " movimientos en " + elapsedUs.toFixed(0) + " µs"
+                font.family: Theme.fontFamily
+                font.pixelSize: Theme.fontSizeS
+                color: Theme.textSecondary
+            }
+        }
+        
+        // Resultado
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            color: Theme.surface
+            radius: Theme.radiusL
+            
+            layer.enabled: Theme.enableShadows
+            layer.effect: MultiEffect {
+                shadowEnabled: true
+                shadowColor: Qt.rgba(0, 0, 0, Theme.shadowOpacity)
+                shadowBlur: Theme.shadowBlur
+                shadowVerticalOffset: Theme.shadowOffsetY
+            }
+            
+            ListView {
+                id: cellsListView
+                anchors.fill: parent
+                anchors.margins: Theme.spacingL
+                clip: true
+                spacing: Theme.spacingS
+                model: cells
+                
+                delegate: RowLayout {
+                    width: cellsListView.width
+                    spacing: Theme.spacingM
+                    
+                    Text {
+                        Layout.preferredWidth: 140
+                        text: modelData.label
+                        elide: Text.ElideRight
+                        font.family: Theme.fontFamily
+                        font.pixelSize: Theme.fontSizeM
+                        color: Theme.textPrimary
+                    }
+                    
+                    // Barras de ingresos y gastos
+                    ColumnLayout {
+                        Layout.fillWidth: true
+                        spacing: 2
+                        
+                        Rectangle {
+                            Layout.preferredHeight: 10
+                            Layout.preferredWidth: maxValue > 0 ? Math.max(2, parent.width * modelData.income / maxValue) : 2
+                            radius: 3
+                            color: Theme.success
+                        }
+                        
+                        Rectangle {
+                            Layout.preferredHeight: 10
+                            Layout.preferredWidth: maxValue > 0 ? Math.max(2, parent.width * modelData.expense / maxValue) : 2
+                            radius: 3
+                            color: Theme.error
+                        }
+                    }
+                    
+                    Text {
+                        Layout.preferredWidth: 260
+                        horizontalAlignment: Text.AlignRight
+                        text: "+" + formatCurrency(modelData.income) + "  −" + formatCurrency(modelData.expense)
+                              + "  (" + modelData.count + ")"
+                        font.family: Theme.fontFamily
+                        font.pixelSize: Theme.fontSizeS
+                        color: Theme.textSecondary
+                    }
+                }
+                
+                ScrollBar.vertical: ScrollBar {
+                    policy: ScrollBar.AsNeeded
+                }
+            }
+        }
+        
+        // Estado anual y retención
+        RowLayout {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 280
+            spacing: Theme.spacingL
+            
+            // Estado anual
+            Rectangle {
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                color: Theme.surface
+                radius: Theme.radiusL
+                
+                layer.enabled: Theme.enableShadows
+                layer.effect: MultiEffect {
+                    shadowEnabled: true
+                    shadowColor: Qt.rgba(0, 0, 0, Theme.shadowOpacity)
+                    shadowBlur: Theme.shadowBlur
+                    shadowVerticalOffset: Theme.shadowOffsetY
+                }
+                
+                ColumnLayout {
+                    anchors.fill: parent
+                    anchors.margins: Theme.spacingL
+                    spacing: Theme.spacingM
+                    
+                    RowLayout {
+                        id: statementHeader
+                        Layout.fillWidth: true
+                        spacing: Theme.spacingM
+                        
+                        ColumnLayout {
+                            spacing: 2
+                            
+                            Text {
+                                text: "Estado anual"
+                                font.family: Theme.fontFamily
+                                font.pixelSize: Theme.fontSizeL
+                                font.weight: Theme.fontWeightBold
+                                color: Theme.textPrimary
+                            }
+                            
+                            Text {
+                                visible: statement !== null
+                                text: statement
+                                      ? statement.payingMembers + " miembros con pagos · valor promedio "
+                                        + formatCurrency(statement.averageMemberValue)
+                                        + " · " + statement.partitions + " meses en "
+                                        + statement.workers + " hilos, " + statement.elapsedMs + " ms"
+                                      : ""
+                                font.family: Theme.fontFamily
+                                font.pixelSize: Theme.fontSizeS
+                                color: Theme.textSecondary
+                            }
+                        }
+                        
+                        Item { Layout.fillWidth: true }
+                        
+                        GymComboBox {
+                            Layout.preferredWidth: 160
+                            model: [
+                                { text: "Último año", value: 1 },
+                                { text: "3 años", value: 3 },
+                                { text: "5 años", value: 5 }
+                            ]
+                            currentIndex: 2
+                            onActivated: statementYears = currentValue
+                        }
+                        
+                        GymButton {
+                            text: GymController.statementBuilding ? "Generando..." : "Generar"
+                            variant: "outline"
+                            enabled: !GymController.statementBuilding
+                            onClicked: buildStatement()
+                        }
+                    }
+                    
+                    ListView {
+                        id: statementListView
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        visible: statement !== null
+                        clip: true
+                        spacing: Theme.spacingS
+                        model: statement ? statement.years : []
+                        
+                        delegate: RowLayout {
+                            width: statementListView.width
+                            spacing: Theme.spacingM
+                            
+                            Text {
+                                Layout.preferredWidth: 60
+                                text: modelData.year
+                                font.family: Theme.fontFamily
+                                font.pixelSize: Theme.fontSizeM
+                                font.weight: Theme.fontWeightBold
+                                color: Theme.textPrimary
+                            }
+                            
+                            Text {
+                                Layout.fillWidth: true
+                                text: "+" + formatCurrency(modelData.income) + "  −" + formatCurrency(modelData.expense)
+                                      + "  = " + formatCurrency(modelData.balance)
+                                font.family: Theme.fontFamily
+                                font.pixelSize: Theme.fontSizeS
+                                color: modelData.balance >= 0 ? Theme.success : Theme.error
+                            }
+                            
+                            Text {
+                                Layout.preferredWidth: 220
+                                text: modelData.plans.length > 0
+                                      ? modelData.plans[0].name + ": " + formatCurrency(modelData.plans[0].revenue)
+                                      : "Sin ingresos"
+                                elide: Text.ElideRight
+                                font.family: Theme.fontFamily
+                                font.pixelSize: Theme.fontSizeS
+                                color: Theme.textSecondary
+                            }
+                            
+                            Text {
+                                Layout.preferredWidth: 200
+                                horizontalAlignment: Text.AlignRight
+                                text: modelData.payingMembers + " miembros · "
+                                      + formatCurrency(modelData.averageMemberRevenue) + " c/u"
+                                font.family: Theme.fontFamily
+                                font.pixelSize: Theme.fontSizeS
+                                color: Theme.textSecondary
+                            }
+                        }
+                        
+                        ScrollBar.vertical: ScrollBar {
+                            policy: ScrollBar.AsNeeded
+                        }
+                    }
+                }
+            }
+            
+            // Retención por cohorte
+            Rectangle {
+                Layout.preferredWidth: 420
+                Layout.fillHeight: true
+                color: Theme.surface
+                radius: Theme.radiusL
+                
+                layer.enabled: Theme.enableShadows
+                layer.effect: MultiEffect {
+                    shadowEnabled: true
+                    shadowColor: Qt.rgba(0, 0, 0, Theme.shadowOpacity)
+                    shadowBlur: Theme.shadowBlur
+                    shadowVerticalOffset: Theme.shadowOffsetY
+                }
+                
+                ColumnLayout {
+                    anchors.fill: parent
+                    anchors.margins: Theme.spacingL
+                    spacing: Theme.spacingS
+                    
+                    Text {
+                        text: "Retención por cohorte"
+                        font.family: Theme.fontFamily
+                        font.pixelSize: Theme.fontSizeL
+                        font.weight: Theme.fontWeightBold
+                        color: Theme.textPrimary
+                    }
+                    
+                    Text {
+                        text: "Fracción de los miembros de cada mes que siguen activos N meses después"
+                        wrapMode: Text.WordWrap
+                        Layout.fillWidth: true
+                        font.family: Theme.fontFamily
+                        font.pixelSize: Theme.fontSizeS
+                        color: Theme.textSecondary
+                    }
+                    
+                    ListView {
+                        id: retentionListView
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        clip: true
+                        spacing: 2
+                        model: retention.rows
+                        
+                        delegate: RowLayout {
+                            width: retentionListView.width
+                            spacing: 2
+                            
+                            Text {
+                                Layout.preferredWidth: 90
+                                text: modelData.label + " (" + modelData.members + ")"
+                                elide: Text.ElideRight
+                                font.family: Theme.fontFamily
+                                font.pixelSize: Theme.fontSizeS
+                                color: Theme.textSecondary
+                            }
+                            
+                            Repeater {
+                                model: modelData.retention
+                                
+                                Rectangle {
+                                    Layout.preferredWidth: 22
+                                    Layout.preferredHeight: 18
+                                    radius: 2
+                                    color: Qt.rgba(Theme.primary.r, Theme.primary.g, Theme.primary.b,
+                                                   0.1 + 0.9 * modelData)
+                                    
+                                    ToolTip.visible: cellMouseArea.containsMouse
+                                    ToolTip.text: "Mes " + index + ": " + Math.round(modelData * 100) + "%"
+                                    
+                                    MouseArea {
+                                        id: cellMouseArea
+                                        anchors.fill: parent
+                                        hoverEnabled: true
+                                    }
+                                }
+                            }
+                            
+                            Item { Layout.fillWidth: true }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -2,8 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Effects
-import ".."
-import "../components"
+import GymOSQml
 
 /**
  * DashboardView - Vista Principal (Home)
@@ -21,38 +20,92 @@ Item {
     // ========================================================================
     // Datos de ejemplo (serán reemplazados por el controller)
     // ========================================================================
-    // Datos vinculados al controlador
-    property int activeMembers: typeof gymController !== 'undefined' ? gymController.activeSubscriptionsCount : 0
-    property int inactiveMembers: typeof gymController !== 'undefined' ? (gymController.totalMembers - gymController.activeSubscriptionsCount) : 0
-    property int expiringMembers: typeof gymController !== 'undefined' ? gymController.expiringSubscriptionsCount : 0
+    // Datos vinculados al controlador (se cargan cuando GymController.ready)
+    property int activeMembers: 0
+    property int inactiveMembers: 0
+    property int expiringMembers: 0
     
     // Lista de suscripciones próximas a vencer
     property var expiringList: []
     
+    // Último check-in (resultado de GymController.checkIn)
+    property var lastCheckIn: null
+    
+    // Asistencia (agregados mantenidos en C++)
+    property var hourlyOccupancy: []
+    property int visitsToday: 0
+    
+    // Recordatorios de vencimiento pendientes en el outbox
+    property int pendingReminders: 0
+    
+    // Ingresos proyectados por renovaciones (pronóstico en C++)
+    property var renewalForecast: ({ projected30: 0, projected60: 0, projected90: 0, expectedRenewals: 0 })
+    
+    // Una notificación por vuelta del event loop con los dominios modificados;
+    // mientras la vista está oculta se acumulan hasta que vuelve a mostrarse
     Connections {
-        target: typeof gymController !== 'undefined' ? gymController : null
-        function onSubscriptionsChanged() {
-            expiringList = gymController.expiringSubscriptions
-            activeMembers = gymController.activeSubscriptionsCount
-            inactiveMembers = gymController.totalMembers - gymController.activeSubscriptionsCount
-            expiringMembers = gymController.expiringSubscriptionsCount
-        }
-        function onMembersChanged() {
-            inactiveMembers = gymController.totalMembers - gymController.activeSubscriptionsCount
+        target: GymController
+        function onViewRefreshRequested(view, domains) {
+            if (view !== "dashboard") return
+            if (domains & (ChangeTracker.Subscriptions | ChangeTracker.Members)) {
+                refreshMemberStats()
+            }
+            if (domains & (ChangeTracker.Subscriptions | ChangeTracker.Plans)) {
+                refreshForecast()
+            }
+            if (domains & ChangeTracker.Attendance) {
+                refreshAttendance()
+            }
+            if (domains & ChangeTracker.Reminders) {
+                refreshReminders()
+            }
         }
     }
     
     Component.onCompleted: {
-        if (typeof gymController !== 'undefined') {
+        GymController.registerView("dashboard", ChangeTracker.Subscriptions | ChangeTracker.Members | ChangeTracker.Plans | ChangeTracker.Attendance | ChangeTracker.Reminders)
+        if (GymController.ready) {
             refreshData()
         }
+        Tracer.instant("DashboardView loaded")
+    }
+    
+    function submitCheckIn() {
+        if (checkInField.text.trim() === "") return
+        lastCheckIn = GymController.checkIn(checkInField.text)
+        checkInField.text = ""
+        checkInField.textField.forceActiveFocus()
     }
     
     function refreshData() {
-        expiringList = gymController.expiringSubscriptions
-        activeMembers = gymController.activeSubscriptionsCount
-        inactiveMembers = gymController.totalMembers - gymController.activeSubscriptionsCount
-        expiringMembers = gymController.expiringSubscriptionsCount
+        refreshMemberStats()
+        refreshForecast()
+        refreshAttendance()
+        refreshReminders()
+    }
+    
+    function refreshMemberStats() {
+        expiringList = GymController.expiringSubscriptions
+        activeMembers = GymController.activeSubscriptionsCount
+        inactiveMembers = GymController.totalMembers - activeMembers
+        expiringMembers = GymController.expiringSubscriptionsCount
+    }
+    
+    function refreshForecast() {
+        renewalForecast = GymController.getRenewalForecast(90)
+    }
+    
+    function formatCurrency(amount) {
+        return "$" + Math.round(amount).toString().replace(/\B(?=(\d{3})+(?!\d))/g, ".")
+    }
+    
+    function refreshAttendance() {
+        hourlyOccupancy = GymController.hourlyOccupancy
+        visitsToday = GymController.visitsToday
+    }
+    
+    function refreshReminders() {
+        pendingReminders = GymController.pendingReminderCount
     }
     
     // ========================================================================
@@ -102,6 +155,120 @@ Item {
                 iconSource: "qrc:/assets/icons/subscriptions.svg"
                 onClicked: root.navigationRequested("subscriptions", "expiring")
             }
+            
+            StatCard {
+                Layout.fillWidth: true
+                title: "RENOVACIONES PROYECTADAS"
+                value: formatCurrency(renewalForecast.projected30)
+                subtitle: "30 días · 60: " + formatCurrency(renewalForecast.projected60)
+                          + " · 90: " + formatCurrency(renewalForecast.projected90)
+                accentColor: Theme.primary
+                iconSource: "qrc:/assets/icons/finance.svg"
+                onClicked: root.navigationRequested("subscriptions", "expiring")
+            }
+        }
+        
+        // Check-in de Miembros
+        Rectangle {
+            Layout.fillWidth: true
+            implicitHeight: checkInLayout.implicitHeight + Theme.spacingL * 2
+            color: Theme.surface
+            radius: Theme.radiusL
+            
+            layer.enabled: Theme.enableShadows
+            layer.effect: MultiEffect {
+                shadowEnabled: true
+                shadowColor: Qt.rgba(0, 0, 0, Theme.shadowOpacity)
+                shadowBlur: Theme.shadowBlur
+                shadowVerticalOffset: Theme.shadowOffsetY
+            }
+            
+            RowLayout {
+                id: checkInLayout
+                anchors.fill: parent
+                anchors.margins: Theme.spacingL
+                spacing: Theme.spacingL
+                
+                GymTextField {
+                    id: checkInField
+                    Layout.preferredWidth: 280
+                    label: "Check-in"
+                    placeholder: "Tarjeta o N° de socio"
+                    
+                    // Los lectores de tarjetas envían Enter al final
+                    Connections {
+                        target: checkInField.textField
+                        function onAccepted() { root.submitCheckIn() }
+                    }
+                }
+                
+                GymButton {
+                    Layout.alignment: Qt.AlignBottom
+                    text: "Registrar Ingreso"
+                    variant: "primary"
+                    onClicked: root.submitCheckIn()
+                }
+                
+                // Resultado del último escaneo
+                Rectangle {
+                    Layout.fillWidth: true
+                    Layout.alignment: Qt.AlignBottom
+                    implicitHeight: Theme.inputHeight
+                    radius: Theme.radiusM
+                    visible: lastCheckIn !== null
+                    color: {
+                        if (!lastCheckIn) return "transparent"
+                        if (lastCheckIn.status === "allowed") return Theme.success
+                        if (lastCheckIn.status === "expired") return Theme.error
+                        return Theme.warning
+                    }
+                    
+                    Text {
+                        anchors.fill: parent
+                        anchors.leftMargin: Theme.spacingM
+                        anchors.rightMargin: Theme.spacingM
+                        verticalAlignment: Text.AlignVCenter
+                        elide: Text.ElideRight
+                        font.family: Theme.fontFamily
+                        font.pixelSize: Theme.fontSizeM
+                        font.weight: Theme.fontWeightMedium
+                        color: "white"
+                        text: {
+                            if (!lastCheckIn) return ""
+                            if (lastCheckIn.status === "allowed")
+                                return "✓ " + lastCheckIn.memberName + " — vence el " + lastCheckIn.endDate
+                                       + " · " + lastCheckIn.visits30 + " visitas en 30 días"
+                            if (lastCheckIn.status === "expired")
+                                return "✗ " + lastCheckIn.memberName + " — venció el " + lastCheckIn.endDate
+                            return "Código no encontrado"
+                        }
+                    }
+                }
+            }
+        }
+        
+        // Ocupación por hora (día de la semana actual)
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 240
+            color: Theme.surface
+            radius: Theme.radiusL
+            
+            layer.enabled: Theme.enableShadows
+            layer.effect: MultiEffect {
+                shadowEnabled: true
+                shadowColor: Qt.rgba(0, 0, 0, Theme.shadowOpacity)
+                shadowBlur: Theme.shadowBlur
+                shadowVerticalOffset: Theme.shadowOffsetY
+            }
+            
+            OccupancyChart {
+                anchors.fill: parent
+                anchors.margins: Theme.spacingL
+                title: "Ocupación Promedio de Hoy"
+                subtitle: visitsToday + " ingresos hoy"
+                hourlyData: hourlyOccupancy
+            }
         }
         
                 // Lista de Próximos a Vencer
@@ -139,11 +306,42 @@ Item {
                     Item { Layout.fillWidth: true }
                     
                     Text {
-                        text: "Ordenado por fecha de vencimiento"
+                        text: pendingReminders > 0
+                              ? pendingReminders + " recordatorios pendientes"
+                              : "Ordenado por fecha de vencimiento"
                         font.family: Theme.fontFamily
                         font.pixelSize: Theme.fontSizeS
                         color: Theme.textSecondary
                     }
+                    
+                    // Exportación y envío de recordatorios (outbox)
+                    GymButton {
+                        text: "CSV"
+                        variant: "outline"
+                        visible: pendingReminders > 0
+                        onClicked: GymController.exportReminders("csv")
+                    }
+                    
+                    GymButton {
+                        text: "vCard"
+                        variant: "outline"
+                        visible: pendingReminders > 0
+                        onClicked: GymController.exportReminders("vcard")
+                    }
+                    
+                    GymButton {
+                        text: "Mensajes"
+                        variant: "outline"
+                        visible: pendingReminders > 0
+                        onClicked: GymController.exportReminders("messages")
+                    }
+                    
+                    GymButton {
+                        text: "Enviar"
+                        variant: "primary"
+                        visible: pendingReminders > 0
+                        onClicked: GymController.sendReminders()
+                    }
                 }
                 Rectangle {
                     Layout.fillWidth: true
@@ -1,8 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
-import ".."
-import "../components"
+import GymOSQml
 
 /**
  * EditMemberDialog - Dialog component for editing member profile
@@ -224,24 +223,22 @@ Dialog {
     
     // Logic
     function saveChanges() {
-        if (typeof gymController !== 'undefined') {
-            var success = gymController.updateMember(
-                memberId,
-                pFirstName,
-                pLastName,
-                pEmail,
-                pPhone,
-                pInstagram,
-                pWeight,
-                pHeight,
-                pHealthNotes,
-                pObservations
-            )
+        var success = GymController.updateMember(
+            memberId,
+            pFirstName,
+            pLastName,
+            pEmail,
+            pPhone,
+            pInstagram,
+            pWeight,
+            pHeight,
+            pHealthNotes,
+            pObservations
+        )
             
-            if (success) {
-                root.saved()
-                root.close()
-            }
+        if (success) {
+            root.saved()
+            root.close()
         }
     }
 }
@@ -2,8 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Effects
-import ".."
-import "../components"
+import GymOSQml
 
 /**
  * FinanceView - Vista de Finanzas
@@ -30,9 +29,6 @@ Item {
     property double totalExpenses: 0
     readonly property double balance: totalIncome - totalExpenses
     
-    // Datos mensuales para el gráfico
-    property var monthlyData: []
-    
     // Período seleccionado para el gráfico (en meses)
     property int selectedPeriod: 6
     property var periodOptions: [
@@ -44,32 +40,49 @@ Item {
     ]
     property int selectedPeriodIndex: 3  // Default: 6 meses
     
-    // Historial de movimientos
-    property var entries: []
+    // Historial de movimientos (paginado, se carga al hacer scroll)
+    LedgerModel {
+        id: ledger
+    }
+    
+    // Datos mensuales del gráfico (se actualizan solo los meses modificados)
+    FinanceChartModel {
+        id: monthlyChart
+        months: root.selectedPeriod
+    }
+    
+    // Avance de la exportación de movimientos (0-100)
+    property int exportProgress: 0
     
     Connections {
-        target: typeof gymController !== 'undefined' ? gymController : null
-        function onFinancialDataChanged() {
+        target: GymController
+        function onViewRefreshRequested(view, domains) {
+            if (view !== "finance") return
             refreshData()
         }
+        function onReportExportProgress(percent) {
+            exportProgress = percent
+        }
     }
     
     Component.onCompleted: {
-        if (typeof gymController !== 'undefined') {
+        GymController.registerView("finance", ChangeTracker.Finance)
+        if (GymController.ready) {
             refreshData()
         }
+        Tracer.instant("FinanceView loaded")
     }
     
     function refreshData() {
         console.log("[QML] Refreshing financial data...")
-        var summary = gymController.financialSummary
+        var summary = GymController.financialSummary
         if (summary) {
             totalIncome = summary.totalIncome || 0
             totalExpenses = summary.totalExpenses || 0
         }
-        monthlyData = gymController.getMonthlyBreakdownForPeriod(selectedPeriod) || []
-        entries = gymController.recentTransactions || []
-        console.log("[QML] Loaded " + entries.length + " transactions")
+        monthlyChart.refresh()
+        ledger.reload()
+        console.log("[QML] Loaded " + ledger.count + " transactions")
     }
     
     // ========================================================================
@@ -213,9 +226,6 @@ Item {
                                 if (currentIndex >= 0 && currentIndex < root.periodOptions.length) {
                                     root.selectedPeriodIndex = currentIndex
                                     root.selectedPeriod = root.periodOptions[currentIndex].months
-                                    if (typeof gymController !== 'undefined') {
-                                        root.monthlyData = gymController.getMonthlyBreakdownForPeriod(root.selectedPeriod)
-                                    }
                                 }
                             }
                         }
@@ -226,7 +236,7 @@ Item {
                         Layout.fillWidth: true
                         Layout.fillHeight: true
                         title: ""
-                        monthlyData: root.monthlyData
+                        chartModel: monthlyChart
                     }
                 }
             }
@@ -251,13 +261,96 @@ Item {
                     anchors.margins: Theme.spacingL
                     spacing: Theme.spacingM
                     
-                    // Título
-                    Text {
-                        text: "Últimos Movimientos"
-                        font.family: Theme.fontFamily
-                        font.pixelSize: Theme.fontSizeL
-                        font.weight: Theme.fontWeightMedium
-                        color: Theme.textPrimary
+                    // Título y exportación del período seleccionado
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: Theme.spacingS
+                        
+                        Text {
+                            text: "Movimientos"
+                            font.family: Theme.fontFamily
+                            font.pixelSize: Theme.fontSizeL
+                            font.weight: Theme.fontWeightMedium
+                            color: Theme.textPrimary
+                        }
+                        
+                        Item { Layout.fillWidth: true }
+                        
+                        Text {
+                            visible: GymController.reportExporting
+                            text: "Exportando… " + exportProgress + "%"
+                            font.family: Theme.fontFamily
+                            font.pixelSize: Theme.fontSizeS
+                            color: Theme.textSecondary
+                        }
+                        
+                        GymButton {
+                            text: "Cancelar"
+                            variant: "outline"
+                            visible: GymController.reportExporting
+                            onClicked: GymController.cancelFinancialReport()
+                        }
+                        
+                        GymButton {
+                            text: "CSV"
+                            variant: "outline"
+                            visible: !GymController.reportExporting
+                            onClicked: exportEntries("csv")
+                        }
+                        
+                        GymButton {
+                            text: "Columnar"
+                            variant: "outline"
+                            visible: !GymController.reportExporting
+                            onClicked: exportEntries("columnar")
+                        }
+                    }
+                    
+                    // Filtros del libro
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: Theme.spacingM
+                        
+                        GymComboBox {
+                            Layout.preferredWidth: 180
+                            label: "Clasificación"
+                            model: [
+                                { text: "Todos", value: "" },
+                                { text: "Ingresos", value: "income" },
+                                { text: "Gastos", value: "expense" }
+                            ]
+                            currentIndex: 0
+                            onActivated: ledger.classification = currentValue
+                        }
+                        
+                        GymComboBox {
+                            Layout.preferredWidth: 180
+                            label: "Tipo"
+                            model: [
+                                { text: "Todos", value: "" },
+                                { text: "Inscripción", value: "enrollment_income" },
+                                { text: "Renovación", value: "renewal_income" },
+                                { text: "Ingreso", value: "custom_income" },
+                                { text: "Gasto", value: "custom_expense" }
+                            ]
+                            currentIndex: 0
+                            onActivated: ledger.entryType = currentValue
+                        }
+                        
+                        GymTextField {
+                            id: ledgerSearchField
+                            Layout.fillWidth: true
+                            label: "Buscar"
+                            placeholder: "Descripción"
+                            onTextChanged: ledgerSearchTimer.restart()
+                        }
+                        
+                        // Evita una consulta por tecla
+                        Timer {
+                            id: ledgerSearchTimer
+                            interval: 250
+                            onTriggered: ledger.searchText = ledgerSearchField.text
+                        }
                     }
                     
                     // Separador
@@ -275,7 +368,7 @@ Item {
                         clip: true
                         spacing: Theme.spacingXS
                         
-                        model: root.entries
+                        model: ledger
                         
                         delegate: Rectangle {
                             width: entriesListView.width
@@ -297,7 +390,7 @@ Item {
                                     Layout.preferredWidth: 4
                                     Layout.fillHeight: true
                                     radius: 2
-                                    color: getEntryColor(modelData.type)
+                                    color: getEntryColor(model.type)
                                 }
                                 
                                 // Icono
@@ -306,18 +399,18 @@ Item {
                                     Layout.preferredHeight: 40
                                     radius: Theme.radiusRound
                                     color: Qt.rgba(
-                                        getEntryColor(modelData.type).r,
-                                        getEntryColor(modelData.type).g,
-                                        getEntryColor(modelData.type).b,
+                                        getEntryColor(model.type).r,
+                                        getEntryColor(model.type).g,
+                                        getEntryColor(model.type).b,
                                         0.1
                                     )
                                     
                                     Text {
                                         anchors.centerIn: parent
-                                        text: isIncome(modelData.type) ? "↑" : "↓"
+                                        text: isIncome(model.type) ? "↑" : "↓"
                                         font.pixelSize: 18
                                         font.weight: Font.Bold
-                                        color: getEntryColor(modelData.type)
+                                        color: getEntryColor(model.type)
                                     }
                                 }
                                 
@@ -328,7 +421,7 @@ Item {
                                     
                                     Text {
                                         Layout.fillWidth: true
-                                        text: modelData.description
+                                        text: model.description
                                         font.family: Theme.fontFamily
                                         font.pixelSize: Theme.fontSizeM
                                         color: Theme.textPrimary
@@ -336,7 +429,7 @@ Item {
                                     }
                                     
                                     Text {
-                                        text: modelData.date + " • " + getEntryTypeLabel(modelData.type)
+                                        text: model.date + " • " + getEntryTypeLabel(model.type)
                                         font.family: Theme.fontFamily
                                         font.pixelSize: Theme.fontSizeXS
                                         color: Theme.textSecondary
@@ -345,12 +438,12 @@ Item {
                                 
                                 // Monto
                                 Text {
-                                    text: (isIncome(modelData.type) ? "+" : "-") + 
-                                          formatCurrency(modelData.amount)
+                                    text: (isIncome(model.type) ? "+" : "-") + 
+                                          formatCurrency(model.amount)
                                     font.family: Theme.fontFamily
                                     font.pixelSize: Theme.fontSizeM
                                     font.weight: Theme.fontWeightBold
-                                    color: getEntryColor(modelData.type)
+                                    color: getEntryColor(model.type)
                                 }
                             }
                             
@@ -518,6 +611,14 @@ Item {
     // ========================================================================
     // Funciones Helper
     // ========================================================================
+    // Exporta los movimientos del período del gráfico (meses completos)
+    function exportEntries(format) {
+        var today = new Date()
+        var from = new Date(today.getFullYear(), today.getMonth() - selectedPeriod + 1, 1)
+        exportProgress = 0
+        GymController.exportFinancialReport(from, today, format)
+    }
+    
     function formatCurrency(amount) {
         // Manual regex to force dots for thousands. 1000 -> 1.000
         return "$" + amount.toString().replace(/\B(?=(\d{3})+(?!\d))/g, ".")
@@ -553,9 +654,9 @@ Item {
         // Determinar si es gasto o ingreso y llamar al método correspondiente
         // Determinar si es gasto o ingreso y llamar al método correspondiente
         if (newEntryType === "expense") {
-            success = gymController.recordExpense(newEntryDescription, newEntryAmount)
+            success = GymController.recordExpense(newEntryDescription, newEntryAmount)
         } else {
-            success = gymController.recordIncome(newEntryDescription, newEntryAmount)
+            success = GymController.recordIncome(newEntryDescription, newEntryAmount)
         }
         
         if (success) {
@@ -2,8 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Effects
-import ".."
-import "../components"
+import GymOSQml
 
 /**
  * NewSubscriberView - Vista de Nuevo Suscriptor (Horizontal Refactor)
@@ -54,20 +53,27 @@ Item {
     // ========================================================================
     Component.onCompleted: {
         console.log("[QML] NewSubscriberView V2 loading plans")
-        if (typeof gymController !== 'undefined') {
-            availablePlans = gymController.plans
-            enrollmentFee = gymController.enrollmentFee // Load global fee
-        } else {
-            console.log("[QML] WARNING: gymController is undefined!")
-            availablePlans = []
+        // Si todavía no están listos, los datos llegan con onViewRefreshRequested
+        GymController.registerView("newSubscriber", ChangeTracker.Plans | ChangeTracker.Settings)
+        if (GymController.ready) {
+            availablePlans = GymController.plans
+            enrollmentFee = GymController.enrollmentFee // Load global fee
         }
+        Tracer.instant("NewSubscriberView loaded")
     }
     
-    // Listen for settings/plans changes
+    // Listen for settings/plans changes (solo mientras la vista está visible)
     Connections {
-        target: typeof gymController !== 'undefined' ? gymController : null
-        function onPlansChanged() { availablePlans = gymController.plans }
-        function onSettingsChanged() { enrollmentFee = gymController.enrollmentFee }
+        target: GymController
+        function onViewRefreshRequested(view, domains) {
+            if (view !== "newSubscriber") return
+            if (domains & ChangeTracker.Plans) {
+                availablePlans = GymController.plans
+            }
+            if (domains & ChangeTracker.Settings) {
+                enrollmentFee = GymController.enrollmentFee
+            }
+        }
     }
 
     // ========================================================================
@@ -441,9 +447,7 @@ Item {
         weight = 0; memberHeight = 0
         selectedPlanIndex = -1; 
         // Do NOT reset enrollmentFee to 0, reload it from controller to keep sync
-        if (typeof gymController !== 'undefined') {
-            enrollmentFee = gymController.enrollmentFee
-        }
+        enrollmentFee = GymController.enrollmentFee
         errorMessage = ""
     }
     
@@ -453,26 +457,22 @@ Item {
         isSubmitting = true
         errorMessage = ""
         
-        // Simular o Llamar Backend
-        if (typeof gymController !== 'undefined') {
-            try {
-                var success = gymController.registerMember(
-                    firstName, lastName, email, phone,
-                    availablePlans[selectedPlanIndex].id,
-                    startDate, enrollmentFee
-                )
-                
-                if (success) {
-                    root.state = "Submitted"
-                    // Auto-reset después de 3s si se desea, o manual via botón
-                } else {
-                    errorMessage = "Error al guardar en base de datos"
-                }
-            } catch(e) {
-                errorMessage = "Excepción: " + e
+        // Llamar Backend
+        try {
+            var success = GymController.registerMember(
+                firstName, lastName, email, phone,
+                availablePlans[selectedPlanIndex].id,
+                startDate, enrollmentFee
+            )
+            
+            if (success) {
+                root.state = "Submitted"
+                // Auto-reset después de 3s si se desea, o manual via botón
+            } else {
+                errorMessage = "Error al guardar en base de datos"
             }
-        } else {
-            errorMessage = "Error: Controlador no conectado"
+        } catch(e) {
+            errorMessage = "Excepción: " + e
         }
         isSubmitting = false
     }
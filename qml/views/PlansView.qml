@@ -2,8 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Effects
-import ".."
-import "../components"
+import GymOSQml
 
 /**
  * PlansView - Vista de Planes de Pago
@@ -31,20 +30,25 @@ Item {
     
     // Cargar datos al iniciar
     Component.onCompleted: {
-        if (typeof gymController !== 'undefined') {
-            plans = gymController.plans
-            enrollmentFee = gymController.enrollmentFee
+        GymController.registerView("plans", ChangeTracker.Plans | ChangeTracker.Settings)
+        if (GymController.ready) {
+            plans = GymController.plans
+            enrollmentFee = GymController.enrollmentFee
         }
+        Tracer.instant("PlansView loaded")
     }
     
-    // Actualizar cuando cambien los datos
+    // Actualizar cuando cambien los datos (si está oculta, al volver a mostrarse)
     Connections {
-        target: typeof gymController !== 'undefined' ? gymController : null
-        function onPlansChanged() {
-            plans = gymController.plans
-        }
-        function onSettingsChanged() {
-            enrollmentFee = gymController.enrollmentFee
+        target: GymController
+        function onViewRefreshRequested(view, domains) {
+            if (view !== "plans") return
+            if (domains & ChangeTracker.Plans) {
+                plans = GymController.plans
+            }
+            if (domains & ChangeTracker.Settings) {
+                enrollmentFee = GymController.enrollmentFee
+            }
         }
     }
     
@@ -143,9 +147,7 @@ Item {
                         stepSize: 100
                         editable: true
                         onValueModified: {
-                            if (typeof gymController !== 'undefined') {
-                                gymController.setEnrollmentFee(value)
-                            }
+                            GymController.setEnrollmentFee(value)
                         }
                     }
                 }
@@ -357,9 +359,7 @@ Item {
                                         id: planSwitch
                                         checked: modelData.isActive
                                         onClicked: {
-                                            if (typeof gymController !== 'undefined') {
-                                                gymController.togglePlanStatus(modelData.id, checked)
-                                            }
+                                            GymController.togglePlanStatus(modelData.id, checked)
                                         }
                                     }
                                 }
@@ -613,15 +613,13 @@ Item {
     }
     
     function savePlan() {
-        if (typeof gymController === 'undefined') return
-
         if (editingIndex < 0) {
             // Create
-            gymController.createPlan(planName, planDays, planPrice)
+            GymController.createPlan(planName, planDays, planPrice)
         } else {
             // Update
             var id = plans[editingIndex].id
-            gymController.updatePlan(id, planName, planDays, planPrice)
+            GymController.updatePlan(id, planName, planDays, planPrice)
         }
         
         isEditing = false
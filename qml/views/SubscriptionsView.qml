@@ -2,8 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Effects
-import ".."
-import "../components"
+import GymOSQml
 
 /**
  * SubscriptionsView - Vista de Suscripciones Activas
@@ -22,19 +21,32 @@ Item {
     
     // Lista de suscripciones (será cargada desde el controller)
     // Lista de suscripciones (vinculada al controller)
-    property var subscriptions: typeof gymController !== 'undefined' ? gymController.allSubscriptions : []
+    property var subscriptions: []
+    
+    // Planes del formulario de renovación (se cargan con la vista, no con
+    // un binding a GymController.plans)
+    property var plans: []
     
     Connections {
-        target: typeof gymController !== 'undefined' ? gymController : null
-        function onSubscriptionsChanged() {
-            root.subscriptions = gymController.allSubscriptions
+        target: GymController
+        function onViewRefreshRequested(view, domains) {
+            if (view !== "subscriptions") return
+            // La lista también muestra el nombre del plan
+            root.subscriptions = GymController.allSubscriptions
+            if (domains & ChangeTracker.Plans) {
+                root.plans = GymController.plans
+            }
         }
     }
     
     Component.onCompleted: {
-        if (typeof gymController !== 'undefined') {
-            root.subscriptions = gymController.allSubscriptions
+        // Los nombres de los miembros también se muestran en la lista
+        GymController.registerView("subscriptions", ChangeTracker.Subscriptions | ChangeTracker.Members | ChangeTracker.Plans)
+        if (GymController.ready) {
+            root.subscriptions = GymController.allSubscriptions
+            root.plans = GymController.plans
         }
+        Tracer.instant("SubscriptionsView loaded")
     }
 
     function setFilter(filter) {
@@ -309,8 +321,8 @@ Item {
         onOpened: {
             currentMemberId = selectedMemberId
             console.log("[QML] Popup opened for member:", currentMemberId)
-            memberDetails = gymController.getMemberDetails(currentMemberId)
-            subscriptionHistory = gymController.getMemberSubscriptionHistory(currentMemberId)
+            memberDetails = GymController.getMemberDetails(currentMemberId)
+            subscriptionHistory = GymController.getMemberSubscriptionHistory(currentMemberId)
             console.log("[QML] History loaded:", subscriptionHistory.length, "items")
             memberName = memberDetails ? (memberDetails.firstName + " " + memberDetails.lastName) : ""
             showRenewalForm = false
@@ -633,9 +645,9 @@ Item {
                                     }
                                 }
                                 
-                                // Precio
+                                // Monto pagado (precio del plan si no hay pagos registrados)
                                 Text {
-                                    text: "$" + (modelData.price || 0).toLocaleString()
+                                    text: "$" + ((modelData.paid > 0 ? modelData.paid : modelData.price) || 0).toLocaleString()
                                     font.weight: Font.Bold
                                     color: Theme.textPrimary
                                 }
@@ -681,7 +693,7 @@ Item {
                     spacing: Theme.spacingM
                     visible: memberDetailPopup.showRenewalForm
                     
-                    property var plans: gymController.plans
+                    property var plans: root.plans
                     
                     Text { 
                         text: "Seleccione el plan de renovación para " + memberDetailPopup.memberName
@@ -789,7 +801,7 @@ Item {
                             onClicked: {
                                 var plan = renewalForm.plans[memberDetailPopup.renewalPlanIndex]
                                 console.log("Renovando: " + selectedMemberId + " Plan: " + plan.id)
-                                var success = gymController.renewSubscription(selectedMemberId, plan.id, memberDetailPopup.renewalPrice)
+                                var success = GymController.renewSubscription(selectedMemberId, plan.id, memberDetailPopup.renewalPrice)
                                 if (success) memberDetailPopup.close()
                             }
                         }
@@ -808,9 +820,8 @@ Item {
         
         onSaved: {
             // Recargar detalles del miembro en el popup
-            memberDetailPopup.memberDetails = gymController.getMemberDetails(selectedMemberId)
-            // También recargar la lista principal si cambió el nombre
-            gymController.refreshData() 
+            memberDetailPopup.memberDetails = GymController.getMemberDetails(selectedMemberId)
+            // La lista principal se recarga sola: updateMember marca Members
         }
     }
 }
@@ -0,0 +1,7 @@
+#include "Attendance.h"
+
+namespace GymOS::Core::Models {
+
+// La implementación está en el header ya que es un struct de datos simple
+
+} // namespace GymOS::Core::Models
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+
+namespace GymOS::Core::Models {
+
+/**
+ * @brief Registro de ingreso al gimnasio (INMUTABLE)
+ *
+ * Cada escaneo de un miembro conocido genera un registro, tanto si se le
+ * permitió el acceso como si se le negó por suscripción vencida.
+ */
+struct Attendance {
+  int64_t id = 0;
+  int64_t memberId = 0;
+  QDateTime checkedInAt;
+  bool granted = true;
+};
+
+/**
+ * @brief Ingresos agrupados por día de la semana y hora
+ */
+struct HourlyAttendance {
+  int dayOfWeek; ///< 1 = lunes … 7 = domingo (como QDate::dayOfWeek)
+  int hour;      ///< 0 … 23
+  int count;
+};
+
+/**
+ * @brief Ingresos de un miembro en un día
+ */
+struct DailyAttendance {
+  int64_t memberId;
+  QDate date;
+  int count;
+};
+
+} // namespace GymOS::Core::Models
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "FinancialEntry.h"
+#include <QDate>
+#include <array>
+#include <cstdint>
+
+namespace GymOS::Core::Models {
+
+/**
+ * @brief Totales del libro (montos en centavos)
+ */
+struct LedgerTotals {
+  int64_t incomeCents = 0;
+  int64_t expenseCents = 0;
+  int64_t entries = 0;
+  std::array<int64_t, 4> typeCents{}; ///< Indexado por EntryType
+
+  [[nodiscard]] int64_t balanceCents() const {
+    return incomeCents - expenseCents;
+  }
+
+  LedgerTotals &operator+=(const LedgerTotals &other) {
+    incomeCents += other.incomeCents;
+    expenseCents += other.expenseCents;
+    entries += other.entries;
+    for (size_t type = 0; type < typeCents.size(); ++type) {
+      typeCents[type] += other.typeCents[type];
+    }
+    return *this;
+  }
+
+  LedgerTotals &operator-=(const LedgerTotals &other) {
+    incomeCents -= other.incomeCents;
+    expenseCents -= other.expenseCents;
+    entries -= other.entries;
+    for (size_t type = 0; type < typeCents.size(); ++type) {
+      typeCents[type] -= other.typeCents[type];
+    }
+    return *this;
+  }
+
+  [[nodiscard]] FinancialSummary toSummary() const {
+    FinancialSummary summary;
+    summary.totalIncome = double(incomeCents) / 100.0;
+    summary.totalExpenses = double(expenseCents) / 100.0;
+    summary.transactionCount = static_cast<int>(entries);
+    return summary;
+  }
+};
+
+/**
+ * @brief Cierre de un mes (fila de ledger_snapshots)
+ *
+ * `totals` acumula todos los movimientos con id <= lastEntryId y fecha
+ * <= periodEnd. Los movimientos con fecha anterior registrados después del
+ * cierre (id mayor) no se pierden: los suma el tramo posterior.
+ */
+struct LedgerSnapshot {
+  QDate month;     ///< Primer día del mes cerrado
+  QDate periodEnd; ///< Último día del mes
+  int64_t lastEntryId = 0;
+  LedgerTotals totals;
+};
+
+} // namespace GymOS::Core::Models
@@ -25,6 +25,7 @@ struct Member {
   std::optional<double> weightKg;
   std::optional<double> heightCm;
   std::optional<QString> observations;
+  std::optional<QString> cardCode; ///< Código de tarjeta para el check-in
   QDateTime createdAt;
   QDateTime updatedAt;
 
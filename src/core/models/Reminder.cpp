@@ -0,0 +1,7 @@
+#include "Reminder.h"
+
+namespace GymOS::Core::Models {
+
+// La implementación está en el header ya que son métodos inline simples
+
+} // namespace GymOS::Core::Models
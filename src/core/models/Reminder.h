@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QDate>
+#include <QDateTime>
+#include <QString>
+
+namespace GymOS::Core::Models {
+
+/**
+ * @brief Estado de un recordatorio en el outbox
+ */
+enum class ReminderStatus {
+  Pending, ///< Generado, todavía no enviado
+  Sending, ///< Reclamado por un envío en curso
+  Sent,    ///< Entregado por el sender
+  Failed   ///< Agotó los reintentos
+};
+
+/**
+ * @brief Recordatorio de vencimiento (fila del outbox)
+ *
+ * Se genera una vez por suscripción y ventana de aviso (p. ej. 7, 3 y 1
+ * días antes). Guarda los datos de contacto y el mensaje ya renderizado,
+ * de modo que exportarlo o enviarlo no requiere volver a consultar
+ * miembros ni planes.
+ */
+struct Reminder {
+  int64_t id = 0;
+  int64_t memberId = 0;
+  int64_t subscriptionId = 0;
+  int windowDays = 0; ///< Días de anticipación con que se generó
+  QDate expiryDate;
+  QString memberName;
+  QString planName;
+  QString phone;
+  QString email;
+  QString message;
+  ReminderStatus status = ReminderStatus::Pending;
+  int attempts = 0;
+  QString lastError;
+  QDateTime createdAt;
+  QDateTime sentAt;
+
+  /**
+   * @brief Obtiene el identificador del estado para la base de datos
+   */
+  [[nodiscard]] QString statusId() const { return statusToString(status); }
+
+  /**
+   * @brief Convierte un ReminderStatus a su identificador
+   */
+  static QString statusToString(ReminderStatus status) {
+    switch (status) {
+    case ReminderStatus::Pending:
+      return "pending";
+    case ReminderStatus::Sending:
+      return "sending";
+    case ReminderStatus::Sent:
+      return "sent";
+    case ReminderStatus::Failed:
+      return "failed";
+    }
+    return "pending";
+  }
+
+  /**
+   * @brief Convierte un string a ReminderStatus
+   */
+  static ReminderStatus statusFromString(const QString &str) {
+    if (str == "sending")
+      return ReminderStatus::Sending;
+    if (str == "sent")
+      return ReminderStatus::Sent;
+    if (str == "failed")
+      return ReminderStatus::Failed;
+    return ReminderStatus::Pending;
+  }
+};
+
+} // namespace GymOS::Core::Models
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QDate>
+#include <QString>
+#include <cstdint>
+
+namespace GymOS::Core::Models {
+
+/**
+ * @brief Ingresos de un plan en un mes (fila de plan_revenue_monthly)
+ */
+struct PlanRevenue {
+  int64_t planId = 0;
+  QString planName; ///< Vacío si el plan fue eliminado
+  int year = 0;
+  int month = 0;
+  int64_t revenueCents = 0;
+  int payments = 0;
+  int renewals = 0;
+};
+
+/**
+ * @brief Valor acumulado de un miembro (fila de member_revenue)
+ */
+struct MemberValue {
+  int64_t memberId = 0;
+  QString memberName;
+  int64_t revenueCents = 0;
+  int payments = 0;
+  int renewals = 0;
+  QDate firstPayment;
+  QDate lastPayment;
+};
+
+/**
+ * @brief Miembros agrupados por el mes de su primer pago
+ *
+ * Un miembro cuenta como retenido si renovó al menos una vez.
+ */
+struct PaymentCohort {
+  int year = 0;
+  int month = 0;
+  int members = 0;
+  int renewed = 0;
+  int64_t revenueCents = 0;
+
+  [[nodiscard]] double retentionRate() const {
+    return members > 0 ? double(renewed) / members : 0.0;
+  }
+
+  [[nodiscard]] double churnRate() const {
+    return members > 0 ? 1.0 - retentionRate() : 0.0;
+  }
+
+  [[nodiscard]] double averageValue() const {
+    return members > 0 ? revenueCents / 100.0 / members : 0.0;
+  }
+};
+
+/**
+ * @brief Valor de vida promedio de todos los miembros con pagos
+ */
+struct LifetimeValueSummary {
+  int members = 0;
+  int renewedMembers = 0;
+  int64_t revenueCents = 0;
+
+  [[nodiscard]] double averageValue() const {
+    return members > 0 ? revenueCents / 100.0 / members : 0.0;
+  }
+};
+
+} // namespace GymOS::Core::Models
@@ -1,7 +1,17 @@
 #include "Subscription.h"
+#include "../services/BusinessClock.h"
 
 namespace GymOS::Core::Models {
 
-// La implementación está en el header ya que son métodos inline simples
+// "Hoy" es la fecha de negocio: se resuelve aquí para que el header del
+// modelo no dependa de la capa de servicios
+
+SubscriptionStatus Subscription::status() const {
+  return status(Services::BusinessClock::instance().today());
+}
+
+int Subscription::daysUntilExpiry() const {
+  return Services::BusinessClock::instance().today().daysTo(endDate());
+}
 
 } // namespace GymOS::Core::Models
@@ -47,9 +47,15 @@ struct Subscription {
 
   /**
    * @brief Calcula el estado actual de la suscripción
+   *
+   * Usa la fecha de negocio (BusinessClock), que cambia una vez por día.
    */
-  [[nodiscard]] SubscriptionStatus status() const {
-    const QDate today = QDate::currentDate();
+  [[nodiscard]] SubscriptionStatus status() const;
+
+  /**
+   * @brief Calcula el estado de la suscripción en la fecha indicada
+   */
+  [[nodiscard]] SubscriptionStatus status(const QDate &today) const {
     const QDate expiry = endDate();
 
     if (expiry < today) {
@@ -65,9 +71,7 @@ struct Subscription {
    * @brief Calcula los días hasta el vencimiento
    * @return Días restantes (negativo si ya venció)
    */
-  [[nodiscard]] int daysUntilExpiry() const {
-    return QDate::currentDate().daysTo(endDate());
-  }
+  [[nodiscard]] int daysUntilExpiry() const;
 
   /**
    * @brief Verifica si la suscripción está activa
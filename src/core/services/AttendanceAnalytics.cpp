@@ -0,0 +1,166 @@
+#include "AttendanceAnalytics.h"
+#include "BusinessClock.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+#include "../../infrastructure/diagnostics/Tracer.h"
+
+namespace GymOS::Core::Services {
+
+namespace {
+
+int hourOfWeekIndex(int dayOfWeek, int hour) {
+  return (dayOfWeek - 1) * 24 + hour;
+}
+
+} // namespace
+
+AttendanceAnalytics::AttendanceAnalytics(QObject *parent) : QObject(parent) {}
+
+void AttendanceAnalytics::load() {
+  GYM_TRACE_SCOPE("checkin", "AttendanceAnalytics::load");
+
+  m_hourOfWeek.fill(0);
+  m_members.clear();
+  m_dailyTotals.clear();
+  m_windowTotal = 0;
+
+  for (const auto &bucket : m_repo.countByHourOfWeek()) {
+    m_hourOfWeek[hourOfWeekIndex(bucket.dayOfWeek, bucket.hour)] =
+        bucket.count;
+  }
+  m_firstDay = m_repo.firstCheckInDate();
+
+  const QDate today = BusinessClock::instance().today();
+  m_windowStart = today.addDays(-(kWindowDays - 1));
+  for (const auto &day : m_repo.countDailyByMember(m_windowStart)) {
+    MemberDaily &member = m_members[day.memberId];
+    member.daily[day.date] += day.count;
+    member.visitsInWindow += day.count;
+    if (!member.lastVisit.isValid() || day.date > member.lastVisit) {
+      member.lastVisit = day.date;
+    }
+    m_dailyTotals[day.date] += day.count;
+    m_windowTotal += day.count;
+  }
+
+  qCInfo(lcCheckIn) << "Analítica de asistencia cargada:" << m_windowTotal
+                    << "ingresos en los últimos" << kWindowDays << "días";
+  emit updated();
+}
+
+void AttendanceAnalytics::record(const Attendance &attendance) {
+  if (!attendance.granted) {
+    return;
+  }
+
+  const QDate day = attendance.checkedInAt.date();
+  advanceWindow(BusinessClock::instance().today());
+
+  m_hourOfWeek[hourOfWeekIndex(day.dayOfWeek(),
+                               attendance.checkedInAt.time().hour())]++;
+  if (!m_firstDay.isValid() || day < m_firstDay) {
+    m_firstDay = day;
+  }
+
+  if (day >= m_windowStart) {
+    MemberDaily &member = m_members[attendance.memberId];
+    member.daily[day]++;
+    member.visitsInWindow++;
+    if (!member.lastVisit.isValid() || day > member.lastVisit) {
+      member.lastVisit = day;
+    }
+    m_dailyTotals[day]++;
+    m_windowTotal++;
+  }
+
+  emit updated();
+}
+
+void AttendanceAnalytics::rollOver(const QDate &today) {
+  advanceWindow(today);
+  emit updated();
+}
+
+void AttendanceAnalytics::advanceWindow(const QDate &today) {
+  const QDate windowStart = today.addDays(-(kWindowDays - 1));
+  if (windowStart <= m_windowStart) {
+    return;
+  }
+  m_windowStart = windowStart;
+
+  // Restar los días que quedaron fuera de la ventana
+  while (!m_dailyTotals.empty() && m_dailyTotals.begin()->first < windowStart) {
+    m_windowTotal -= m_dailyTotals.begin()->second;
+    m_dailyTotals.erase(m_dailyTotals.begin());
+  }
+
+  for (auto it = m_members.begin(); it != m_members.end();) {
+    auto &daily = it->daily;
+    while (!daily.empty() && daily.begin()->first < windowStart) {
+      it->visitsInWindow -= daily.begin()->second;
+      daily.erase(daily.begin());
+    }
+    // lastVisit se conserva solo mientras el miembro tenga días en la ventana
+    if (daily.empty()) {
+      it = m_members.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+double AttendanceAnalytics::weeksCovered() const {
+  if (!m_firstDay.isValid()) {
+    return 1.0;
+  }
+  const qint64 days =
+      m_firstDay.daysTo(BusinessClock::instance().today()) + 1;
+  return qMax(1.0, static_cast<double>(days) / 7.0);
+}
+
+std::array<double, 24> AttendanceAnalytics::hourlyProfile(int dayOfWeek) const {
+  std::array<double, 24> profile{};
+  if (dayOfWeek < 1 || dayOfWeek > 7) {
+    return profile;
+  }
+
+  const double weeks = weeksCovered();
+  for (int hour = 0; hour < 24; ++hour) {
+    profile[hour] = m_hourOfWeek[hourOfWeekIndex(dayOfWeek, hour)] / weeks;
+  }
+  return profile;
+}
+
+int AttendanceAnalytics::peakHour(int dayOfWeek) const {
+  if (dayOfWeek < 1 || dayOfWeek > 7) {
+    return -1;
+  }
+
+  int peak = -1;
+  int peakCount = 0;
+  for (int hour = 0; hour < 24; ++hour) {
+    const int count = m_hourOfWeek[hourOfWeekIndex(dayOfWeek, hour)];
+    if (count > peakCount) {
+      peak = hour;
+      peakCount = count;
+    }
+  }
+  return peak;
+}
+
+AttendanceAnalytics::MemberVisits
+AttendanceAnalytics::memberVisits(int64_t memberId) const {
+  MemberVisits visits;
+  auto it = m_members.constFind(memberId);
+  if (it != m_members.constEnd()) {
+    visits.visitsInWindow = it->visitsInWindow;
+    visits.lastVisit = it->lastVisit;
+  }
+  return visits;
+}
+
+int AttendanceAnalytics::visitsOn(const QDate &date) const {
+  auto it = m_dailyTotals.find(date);
+  return it != m_dailyTotals.end() ? it->second : 0;
+}
+
+} // namespace GymOS::Core::Services
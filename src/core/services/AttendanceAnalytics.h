@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../../infrastructure/repositories/AttendanceRepository.h"
+#include "../models/Attendance.h"
+#include <QDate>
+#include <QHash>
+#include <QObject>
+#include <array>
+#include <map>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Repositories;
+
+/**
+ * @brief Analítica de Asistencia
+ *
+ * Mantiene en memoria los agregados de asistencia para que las consultas
+ * no recorran la tabla attendance:
+ * - Histograma hora-de-la-semana (7 × 24) de ingresos permitidos
+ * - Ingresos diarios por miembro en la ventana móvil de 30 días
+ *
+ * Se carga una vez con consultas agrupadas y luego se actualiza con cada
+ * check-in (record()), sin volver a la base de datos. La ventana móvil
+ * avanza al registrar el primer check-in de cada día o al cambiar la fecha
+ * de negocio (rollOver()).
+ */
+class AttendanceAnalytics : public QObject {
+  Q_OBJECT
+
+public:
+  /// Días de la ventana móvil de frecuencia por miembro
+  static constexpr int kWindowDays = 30;
+
+  /**
+   * @brief Frecuencia de visitas de un miembro
+   */
+  struct MemberVisits {
+    int visitsInWindow = 0; ///< Ingresos en los últimos kWindowDays días
+    QDate lastVisit;
+  };
+
+  explicit AttendanceAnalytics(QObject *parent = nullptr);
+
+  /**
+   * @brief Construye los agregados desde la base de datos
+   */
+  void load();
+
+  /**
+   * @brief Suma un check-in a los agregados (solo los permitidos cuentan)
+   */
+  void record(const Attendance &attendance);
+
+  /**
+   * @brief Avanza la ventana móvil al nuevo día y notifica `updated`
+   */
+  void rollOver(const QDate &today);
+
+  /**
+   * @brief Promedio de ingresos por hora para un día de la semana
+   * @param dayOfWeek 1 = lunes … 7 = domingo (como QDate::dayOfWeek)
+   * @return 24 valores, uno por hora
+   */
+  [[nodiscard]] std::array<double, 24> hourlyProfile(int dayOfWeek) const;
+
+  /**
+   * @brief Hora con más ingresos promedio para un día de la semana
+   */
+  [[nodiscard]] int peakHour(int dayOfWeek) const;
+
+  /**
+   * @brief Frecuencia de visitas de un miembro
+   */
+  [[nodiscard]] MemberVisits memberVisits(int64_t memberId) const;
+
+  /**
+   * @brief Ingresos de un día dentro de la ventana (todos los miembros)
+   */
+  [[nodiscard]] int visitsOn(const QDate &date) const;
+
+  /**
+   * @brief Ingresos totales en la ventana móvil
+   */
+  [[nodiscard]] int visitsInWindow() const { return m_windowTotal; }
+
+signals:
+  void updated();
+
+private:
+  struct MemberDaily {
+    std::map<QDate, int> daily; ///< Solo días dentro de la ventana
+    int visitsInWindow = 0;
+    QDate lastVisit;
+  };
+
+  /**
+   * @brief Descarta los días que salieron de la ventana
+   */
+  void advanceWindow(const QDate &today);
+
+  /**
+   * @brief Semanas cubiertas por el histograma (para promediar)
+   */
+  [[nodiscard]] double weeksCovered() const;
+
+  std::array<int, 7 * 24> m_hourOfWeek{};
+  QDate m_firstDay;
+  QDate m_windowStart;
+  int m_windowTotal = 0;
+  QHash<int64_t, MemberDaily> m_members;
+  std::map<QDate, int> m_dailyTotals;
+
+  AttendanceRepository m_repo;
+};
+
+} // namespace GymOS::Core::Services
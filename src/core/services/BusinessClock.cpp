@@ -0,0 +1,50 @@
+#include "BusinessClock.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+#include <QDateTime>
+
+namespace GymOS::Core::Services {
+
+namespace {
+
+// El timer se vuelve a armar como máximo cada hora, de modo que un cambio
+// de hora del sistema o una suspensión se detectan aunque el timer largo
+// no haya disparado a tiempo
+constexpr qint64 kMaxCheckIntervalMs = 60 * 60 * 1000;
+constexpr qint64 kRolloverMarginMs = 500;
+
+} // namespace
+
+BusinessClock &BusinessClock::instance() {
+  static BusinessClock instance;
+  return instance;
+}
+
+BusinessClock::BusinessClock()
+    : QObject(nullptr), m_julianDay(QDate::currentDate().toJulianDay()) {
+  m_timer.setSingleShot(true);
+  m_timer.setTimerType(Qt::VeryCoarseTimer);
+  connect(&m_timer, &QTimer::timeout, this, &BusinessClock::checkRollover);
+}
+
+void BusinessClock::start() {
+  checkRollover();
+}
+
+void BusinessClock::checkRollover() {
+  const QDate current = QDate::currentDate();
+  if (current > today()) {
+    m_julianDay.store(current.toJulianDay(), std::memory_order_relaxed);
+    qCInfo(lcSubscriptions) << "Cambio de día:" << current;
+    emit dayChanged(current);
+  }
+  scheduleNextCheck();
+}
+
+void BusinessClock::scheduleNextCheck() {
+  const QDateTime now = QDateTime::currentDateTime();
+  const QDateTime midnight(now.date().addDays(1), QTime(0, 0));
+  const qint64 untilMidnight = now.msecsTo(midnight) + kRolloverMarginMs;
+  m_timer.start(static_cast<int>(qMin(untilMidnight, kMaxCheckIntervalMs)));
+}
+
+} // namespace GymOS::Core::Services
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QDate>
+#include <QObject>
+#include <QTimer>
+#include <atomic>
+
+namespace GymOS::Core::Services {
+
+/**
+ * @brief Fecha de negocio de la aplicación
+ *
+ * Fuente única de "hoy" para estados de suscripción, ventanas de asistencia
+ * y consultas por fecha. La fecha se fija al arrancar y cambia solo cuando
+ * un timer detecta el cambio de día (hora local), emitiendo `dayChanged`
+ * una vez. Así los cálculos que dependen de la fecha pueden cachearse y
+ * descartarse exactamente una vez por día, y las consultas reciben la
+ * fecha como parámetro en lugar de evaluar date('now') (que además es UTC).
+ *
+ * today() es seguro desde cualquier hilo.
+ */
+class BusinessClock : public QObject {
+  Q_OBJECT
+
+public:
+  static BusinessClock &instance();
+
+  /**
+   * @brief Fecha de negocio actual
+   */
+  [[nodiscard]] QDate today() const {
+    return QDate::fromJulianDay(m_julianDay.load(std::memory_order_relaxed));
+  }
+
+  /**
+   * @brief Arma el timer de cambio de día
+   *
+   * Debe llamarse desde el hilo principal una vez creada la aplicación.
+   */
+  void start();
+
+signals:
+  /**
+   * @brief La fecha de negocio avanzó (medianoche, o reanudación del
+   * equipo en otro día)
+   */
+  void dayChanged(const QDate &today);
+
+private:
+  BusinessClock();
+
+  BusinessClock(const BusinessClock &) = delete;
+  BusinessClock &operator=(const BusinessClock &) = delete;
+
+  void checkRollover();
+  void scheduleNextCheck();
+
+  std::atomic<qint64> m_julianDay;
+  QTimer m_timer;
+};
+
+} // namespace GymOS::Core::Services
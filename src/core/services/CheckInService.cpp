@@ -0,0 +1,191 @@
+#include "CheckInService.h"
+#include "BusinessClock.h"
+#include "../../infrastructure/database/DatabaseManager.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+#include "../../infrastructure/diagnostics/Tracer.h"
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+
+namespace GymOS::Core::Services {
+
+CheckInService::CheckInService(QObject *parent) : QObject(parent) {
+  m_flushTimer.setSingleShot(true);
+  m_flushTimer.setInterval(kFlushIntervalMs);
+  connect(&m_flushTimer, &QTimer::timeout, this, &CheckInService::flush);
+}
+
+CheckInService::~CheckInService() {
+  // Al cerrar se espera el lote en curso y lo pendiente se escribe en la
+  // conexión principal (la continuación ya no corre sin `this`)
+  m_flushFuture.waitForFinished();
+  if (m_flushing && !m_flushFuture.result()) {
+    m_pending.insert(m_pending.begin(), m_inFlight.begin(), m_inFlight.end());
+  }
+  m_attendanceRepo.insertMany(m_pending);
+}
+
+void CheckInService::load() {
+  GYM_TRACE_SCOPE("checkin", __func__);
+
+  m_access.clear();
+  m_cardCodes.clear();
+
+  const auto latest = m_subscriptionRepo.findLatestPerMember();
+  m_access.reserve(static_cast<qsizetype>(latest.size()));
+  for (const auto &sub : latest) {
+    m_access.insert(sub.memberId, {sub.endDate(), sub.memberName});
+  }
+
+  for (const auto &[code, memberId] : m_memberRepo.findCardCodes()) {
+    m_cardCodes.insert(code, memberId);
+  }
+
+  qCInfo(lcCheckIn) << "Índice de acceso cargado:" << m_access.size()
+                    << "miembros," << m_cardCodes.size() << "tarjetas";
+}
+
+CheckInService::Result CheckInService::checkIn(const QString &code) {
+  const QString trimmed = code.trimmed();
+  Result result;
+
+  auto card = m_cardCodes.constFind(trimmed);
+  if (card != m_cardCodes.constEnd()) {
+    result.memberId = card.value();
+  } else {
+    bool ok = false;
+    result.memberId = trimmed.toLongLong(&ok);
+    if (!ok) {
+      result.memberId = 0;
+    }
+  }
+
+  auto access = m_access.constFind(result.memberId);
+  if (access == m_access.constEnd()) {
+    GYM_TRACE(lcCheckIn) << "Código desconocido:" << trimmed;
+    return result;
+  }
+
+  result.memberName = access->memberName;
+  result.endDate = access->endDate;
+  // Igual que Subscription::status(): vencida solo si terminó antes de hoy
+  result.decision = access->endDate >= BusinessClock::instance().today()
+                        ? Decision::Allowed
+                        : Decision::Expired;
+
+  Attendance record;
+  record.memberId = result.memberId;
+  record.checkedInAt = QDateTime::currentDateTime();
+  record.granted = result.allowed();
+  m_pending.push_back(record);
+
+  // Con la escritura fallando, los reintentos quedan a cargo del
+  // temporizador (con espera creciente)
+  if (m_pending.size() >= kMaxPending && !m_writeFailing) {
+    flush();
+  } else if (!m_flushTimer.isActive()) {
+    m_flushTimer.start();
+  }
+
+  emit checkedIn(record);
+  return result;
+}
+
+void CheckInService::refreshMember(int64_t memberId) {
+  auto latest = m_subscriptionRepo.findLatestByMember(memberId);
+  if (latest) {
+    m_access.insert(memberId, {latest->endDate(), latest->memberName});
+  } else {
+    m_access.remove(memberId);
+  }
+}
+
+void CheckInService::updateAccess(int64_t memberId, const QDate &endDate,
+                                  const QString &memberName) {
+  m_access.insert(memberId, {endDate, memberName});
+}
+
+void CheckInService::setCardCode(int64_t memberId, const QString &cardCode) {
+  // Un miembro tiene a lo sumo una tarjeta
+  for (auto it = m_cardCodes.begin(); it != m_cardCodes.end();) {
+    if (it.value() == memberId) {
+      it = m_cardCodes.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (!cardCode.isEmpty()) {
+    m_cardCodes.insert(cardCode, memberId);
+  }
+}
+
+void CheckInService::flush() {
+  m_flushTimer.stop();
+  if (m_pending.empty() || m_flushing) {
+    return; // Con un lote en curso, onFlushed() retoma lo pendiente
+  }
+  GYM_TRACE_SCOPE("checkin", __func__);
+
+  m_inFlight.clear();
+  m_inFlight.swap(m_pending);
+  m_flushing = true;
+
+  // Conexión propia: un lock de escritura de otra conexión (p. ej. el
+  // envío del outbox) demora al hilo de trabajo, no al escaneo
+  m_flushFuture = QtConcurrent::run([batch = m_inFlight]() {
+    GYM_TRACE_SCOPE("checkin", "flushWorker");
+    const QString connection = QStringLiteral("gymos_checkin");
+    bool ok = false;
+    {
+      QSqlDatabase db =
+          DatabaseManager::instance().openWorkerConnection(connection, false);
+      ok = db.isOpen() && AttendanceRepository::insertMany(db, batch);
+    }
+    DatabaseManager::closeWorkerConnection(connection);
+    return ok;
+  });
+  m_flushFuture.then(this, [this](bool ok) { onFlushed(ok); });
+}
+
+void CheckInService::onFlushed(bool ok) {
+  m_flushing = false;
+  std::vector<Attendance> batch;
+  batch.swap(m_inFlight);
+
+  if (!ok) {
+    // Conservar los registros para el próximo intento, con tope
+    m_pending.insert(m_pending.begin(), batch.begin(), batch.end());
+    if (m_pending.size() > kMaxRetained) {
+      const auto dropped = m_pending.size() - kMaxRetained;
+      m_pending.erase(m_pending.begin(),
+                      m_pending.begin() + static_cast<ptrdiff_t>(dropped));
+      qCWarning(lcCheckIn) << "Asistencia descartada por errores de escritura:"
+                           << dropped << "registros";
+    }
+    m_writeFailing = true;
+    m_flushTimer.setInterval(
+        std::min(m_flushTimer.interval() * 2, kMaxRetryIntervalMs));
+    qCWarning(lcCheckIn) << "No se pudo guardar la asistencia, reintento en"
+                         << m_flushTimer.interval() << "ms";
+    m_flushTimer.start();
+    return;
+  }
+
+  if (m_writeFailing) {
+    m_writeFailing = false;
+    m_flushTimer.setInterval(kFlushIntervalMs);
+    qCInfo(lcCheckIn) << "Escritura de asistencia restablecida";
+  }
+
+  GYM_TRACE(lcCheckIn) << "Asistencia guardada:" << batch.size()
+                       << "registros";
+  emit attendanceFlushed(static_cast<int>(batch.size()));
+
+  // Escaneos llegados durante la escritura
+  if (m_pending.size() >= kMaxPending) {
+    flush();
+  } else if (!m_pending.empty() && !m_flushTimer.isActive()) {
+    m_flushTimer.start();
+  }
+}
+
+} // namespace GymOS::Core::Services
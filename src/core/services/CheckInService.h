@@ -0,0 +1,145 @@
+#pragma once
+
+#include "../../infrastructure/repositories/AttendanceRepository.h"
+#include "../../infrastructure/repositories/MemberRepository.h"
+#include "../../infrastructure/repositories/SubscriptionRepository.h"
+#include "../models/Attendance.h"
+#include <QDate>
+#include <QFuture>
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+#include <vector>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Repositories;
+
+/**
+ * @brief Servicio de Check-in
+ *
+ * Valida el acceso de un miembro sin consultar la base de datos: mantiene
+ * en memoria el vencimiento de la suscripción más reciente de cada miembro
+ * y el índice de códigos de tarjeta. Los registros de asistencia se
+ * acumulan y se escriben en lote (por tiempo o por tamaño) desde un hilo
+ * de trabajo con su propia conexión, de modo que ni una ráfaga de escaneos
+ * ni un lock de escritura tomado por otra conexión bloquean la interfaz.
+ */
+class CheckInService : public QObject {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Resultado de la validación
+   */
+  enum class Decision {
+    Allowed,      ///< Suscripción vigente
+    Expired,      ///< La última suscripción ya venció
+    UnknownMember ///< El código no corresponde a ningún miembro suscripto
+  };
+
+  struct Result {
+    Decision decision = Decision::UnknownMember;
+    int64_t memberId = 0;
+    QString memberName;
+    QDate endDate;
+
+    [[nodiscard]] bool allowed() const {
+      return decision == Decision::Allowed;
+    }
+  };
+
+  explicit CheckInService(QObject *parent = nullptr);
+  ~CheckInService() override;
+
+  /**
+   * @brief Construye los índices en memoria desde la base de datos
+   */
+  void load();
+
+  /**
+   * @brief Valida un código escaneado o tipeado
+   *
+   * Busca primero un código de tarjeta y, si no existe, interpreta el
+   * código como ID de miembro. Los miembros conocidos quedan registrados
+   * en la asistencia (permitidos o no).
+   */
+  Result checkIn(const QString &code);
+
+  /**
+   * @brief Vuelve a leer el vencimiento de un miembro
+   *
+   * Llamar después de crear o renovar una suscripción (ya confirmada).
+   */
+  void refreshMember(int64_t memberId);
+
+  /**
+   * @brief Actualiza el vencimiento de un miembro con datos ya conocidos
+   *
+   * Variante sin consulta de refreshMember() para operaciones en lote.
+   */
+  void updateAccess(int64_t memberId, const QDate &endDate,
+                    const QString &memberName);
+
+  /**
+   * @brief Actualiza el índice de tarjetas de un miembro
+   */
+  void setCardCode(int64_t memberId, const QString &cardCode);
+
+  /**
+   * @brief Escribe los registros pendientes en un hilo de trabajo
+   *
+   * No espera a la base: si ya hay un lote en curso, lo pendiente sale
+   * cuando ese termina. Si la escritura falla, los registros se conservan
+   * (hasta kMaxRetained) y se reintenta con el temporizador, duplicando la
+   * espera hasta kMaxRetryIntervalMs.
+   */
+  void flush();
+
+  [[nodiscard]] int pendingCount() const {
+    return static_cast<int>(m_pending.size());
+  }
+
+signals:
+  void checkedIn(const Attendance &attendance);
+  void attendanceFlushed(int count);
+
+private:
+  /**
+   * @brief Resultado de la escritura de m_inFlight (hilo principal)
+   */
+  void onFlushed(bool ok);
+
+  /// Tiempo máximo que un registro espera antes de escribirse
+  static constexpr int kFlushIntervalMs = 2000;
+  /// Cantidad de registros que fuerza una escritura inmediata
+  static constexpr size_t kMaxPending = 256;
+  /// Espera máxima entre reintentos mientras la escritura sigue fallando
+  static constexpr int kMaxRetryIntervalMs = 60000;
+  /// Registros conservados para reintentar; se descartan los más antiguos
+  static constexpr size_t kMaxRetained = 4096;
+
+  struct Access {
+    QDate endDate;
+    QString memberName;
+  };
+
+  QHash<int64_t, Access> m_access;
+  QHash<QString, int64_t> m_cardCodes;
+  std::vector<Attendance> m_pending;
+  QTimer m_flushTimer;
+  /// La última escritura falló: sin escrituras inmediatas hasta que una
+  /// funcione
+  bool m_writeFailing = false;
+  /// Lote que se está escribiendo en el hilo de trabajo
+  std::vector<Attendance> m_inFlight;
+  QFuture<bool> m_flushFuture;
+  bool m_flushing = false;
+
+  AttendanceRepository m_attendanceRepo;
+  SubscriptionRepository m_subscriptionRepo;
+  MemberRepository m_memberRepo;
+};
+
+} // namespace GymOS::Core::Services
@@ -0,0 +1,210 @@
+#include "CohortEngine.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+#include "../../infrastructure/diagnostics/Tracer.h"
+#include "BusinessClock.h"
+#include <algorithm>
+
+namespace GymOS::Core::Services {
+
+CohortEngine &CohortEngine::instance() {
+  static CohortEngine instance;
+  return instance;
+}
+
+int CohortEngine::monthIndex(int32_t julianDay) {
+  const QDate date = QDate::fromJulianDay(julianDay);
+  return (date.year() - kBaseYear) * 12 + date.month() - 1;
+}
+
+void CohortEngine::ensureLoaded() {
+  if (m_loaded) {
+    return;
+  }
+  GYM_TRACE_SCOPE("subscriptions", "CohortEngine::load");
+
+  m_intervals.clear();
+  if (!m_repo.forEachPeriod([this](int64_t memberId, int start, int days) {
+        addPeriod(memberId, start, start + days);
+      })) {
+    m_intervals.clear();
+    return; // Se reintenta en la próxima consulta
+  }
+  m_loaded = true;
+  m_dirty = true;
+
+  GYM_TRACE(lcSubscriptions) << "CohortEngine loaded:" << m_intervals.size()
+                             << "members";
+}
+
+void CohortEngine::addPeriod(int64_t memberId, int32_t start, int32_t end) {
+  std::vector<Interval> &intervals = m_intervals[memberId];
+
+  // Casos comunes (carga ordenada, renovaciones): agregar al final o
+  // extender el último intervalo
+  if (intervals.empty() || start > intervals.back().end + 1) {
+    intervals.push_back({start, end});
+    return;
+  }
+  if (start >= intervals.back().start) {
+    intervals.back().end = std::max(intervals.back().end, end);
+    return;
+  }
+
+  // Período fuera de orden: insertar y fusionar los que se solapan
+  auto it = std::lower_bound(
+      intervals.begin(), intervals.end(), start,
+      [](const Interval &interval, int32_t value) {
+        return interval.start < value;
+      });
+  it = intervals.insert(it, {start, end});
+  if (it != intervals.begin() && std::prev(it)->end + 1 >= it->start) {
+    it = std::prev(it);
+    it->end = std::max(it->end, std::next(it)->end);
+    intervals.erase(std::next(it));
+  }
+  while (std::next(it) != intervals.end() &&
+         it->end + 1 >= std::next(it)->start) {
+    it->end = std::max(it->end, std::next(it)->end);
+    intervals.erase(std::next(it));
+  }
+}
+
+void CohortEngine::update(const Subscription &subscription) {
+  if (!m_loaded) {
+    return; // La carga inicial ya la incluirá
+  }
+
+  const auto start = static_cast<int32_t>(subscription.startDate.toJulianDay());
+  addPeriod(subscription.memberId, start,
+            start + subscription.planDurationDays);
+  m_dirty = true;
+}
+
+void CohortEngine::refreshMember(int64_t memberId) {
+  if (!m_loaded) {
+    return;
+  }
+
+  m_intervals.remove(memberId);
+  for (const auto &subscription : m_repo.findByMember(memberId)) {
+    const auto start =
+        static_cast<int32_t>(subscription.startDate.toJulianDay());
+    addPeriod(memberId, start, start + subscription.planDurationDays);
+  }
+  m_dirty = true;
+}
+
+void CohortEngine::invalidate() {
+  m_loaded = false;
+  m_dirty = true;
+  m_intervals.clear();
+  m_active.clear();
+}
+
+size_t CohortEngine::memberCount() {
+  ensureLoaded();
+  return static_cast<size_t>(m_intervals.size());
+}
+
+void CohortEngine::rebuild(int currentMonth) {
+  GYM_TRACE_SCOPE("subscriptions", "CohortEngine::rebuild");
+
+  m_firstMonth = currentMonth;
+  for (auto it = m_intervals.cbegin(); it != m_intervals.cend(); ++it) {
+    if (!it->empty()) {
+      m_firstMonth = std::min(m_firstMonth, monthIndex(it->front().start));
+    }
+  }
+
+  // Una fila por cohorte con una columna por mes hasta el actual (+1 para
+  // el -1 que cierra los intervalos vigentes)
+  const int cohorts = currentMonth - m_firstMonth + 1;
+  m_active.assign(cohorts, {});
+  for (int cohort = 0; cohort < cohorts; ++cohort) {
+    m_active[cohort].assign(cohorts - cohort + 1, 0);
+  }
+
+  std::vector<int> members(cohorts, 0);
+  for (auto it = m_intervals.cbegin(); it != m_intervals.cend(); ++it) {
+    if (it->empty()) {
+      continue;
+    }
+    const int cohortMonth = monthIndex(it->front().start);
+    if (cohortMonth > currentMonth) {
+      continue; // Empieza en el futuro
+    }
+    std::vector<int> &row = m_active[cohortMonth - m_firstMonth];
+    members[cohortMonth - m_firstMonth]++;
+
+    // Dos intervalos pueden tocar el mismo mes: se fusionan también en
+    // meses para no contar dos veces al miembro
+    int openMonth = -1;
+    int closeMonth = -1;
+    for (const Interval &interval : *it) {
+      const int first = monthIndex(interval.start);
+      if (first > currentMonth) {
+        break;
+      }
+      const int last = std::min(monthIndex(interval.end), currentMonth);
+      if (openMonth >= 0 && first <= closeMonth + 1) {
+        closeMonth = std::max(closeMonth, last);
+        continue;
+      }
+      if (openMonth >= 0) {
+        row[openMonth - cohortMonth]++;
+        row[closeMonth - cohortMonth + 1]--;
+      }
+      openMonth = first;
+      closeMonth = last;
+    }
+    if (openMonth >= 0) {
+      row[openMonth - cohortMonth]++;
+      row[closeMonth - cohortMonth + 1]--;
+    }
+  }
+
+  // Suma acumulada por fila: diferencias → activos por mes
+  for (std::vector<int> &row : m_active) {
+    for (size_t k = 1; k < row.size(); ++k) {
+      row[k] += row[k - 1];
+    }
+    row.pop_back();
+  }
+  for (int cohort = 0; cohort < cohorts; ++cohort) {
+    // La primera columna es el tamaño de la cohorte
+    m_active[cohort].insert(m_active[cohort].begin(), members[cohort]);
+  }
+
+  m_builtMonth = currentMonth;
+  m_dirty = false;
+}
+
+CohortMatrix CohortEngine::matrix(int cohorts) {
+  GYM_TRACE_SCOPE("subscriptions", "CohortEngine::matrix");
+  ensureLoaded();
+
+  const int currentMonth = monthIndex(
+      static_cast<int32_t>(BusinessClock::instance().today().toJulianDay()));
+  if (m_dirty || m_builtMonth != currentMonth) {
+    rebuild(currentMonth);
+  }
+
+  CohortMatrix matrix;
+  const int first =
+      std::max(m_firstMonth, currentMonth - std::max(cohorts, 1) + 1);
+  for (int month = first; month <= currentMonth; ++month) {
+    const std::vector<int> &counts = m_active[month - m_firstMonth];
+
+    CohortRow row;
+    row.year = kBaseYear + month / 12;
+    row.month = month % 12 + 1;
+    row.members = counts.front();
+    row.active.assign(counts.begin() + 1, counts.end());
+    matrix.maxOffset =
+        std::max(matrix.maxOffset, static_cast<int>(row.active.size()) - 1);
+    matrix.rows.push_back(std::move(row));
+  }
+  return matrix;
+}
+
+} // namespace GymOS::Core::Services
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "../../infrastructure/repositories/SubscriptionRepository.h"
+#include "../models/Subscription.h"
+#include <QDate>
+#include <QHash>
+#include <cstdint>
+#include <vector>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Repositories;
+
+/**
+ * @brief Fila de la matriz de retención: miembros que empezaron en un mes
+ */
+struct CohortRow {
+  int year = 0;
+  int month = 0;
+  int members = 0;
+  /// active[k] = miembros activos k meses después (active[0] == members).
+  /// Solo llega hasta el mes actual.
+  std::vector<int> active;
+};
+
+struct CohortMatrix {
+  std::vector<CohortRow> rows; ///< Del mes más antiguo al más reciente
+  int maxOffset = 0;           ///< Mayor k con datos
+};
+
+/**
+ * @brief Retención mensual por cohorte
+ *
+ * La cohorte de un miembro es el mes de inicio de su primera suscripción.
+ * Un miembro está activo en un mes si alguna de sus suscripciones cubre al
+ * menos un día de ese mes.
+ *
+ * Guarda por miembro sus intervalos de actividad ya fusionados (días
+ * julianos; una renovación antes del vencimiento extiende el intervalo
+ * anterior), por lo que la mayoría de los miembros tiene uno o dos. La
+ * matriz se calcula con un barrido: cada intervalo suma +1 en el mes en
+ * que empieza y -1 en el siguiente al que termina, en la fila de su
+ * cohorte, y una suma acumulada por fila da los activos. El costo es
+ * O(intervalos + cohortes × meses), en lugar de evaluar fechas por
+ * miembro y por mes.
+ *
+ * Se carga la primera vez que se usa; las renovaciones lo actualizan con
+ * update() después de confirmar y la matriz se recalcula en la próxima
+ * consulta. Solo se usa desde el hilo principal.
+ */
+class CohortEngine {
+public:
+  static CohortEngine &instance();
+
+  /**
+   * @brief Agrega el período de una suscripción nueva
+   *
+   * Requiere planDurationDays (la duración efectiva).
+   */
+  void update(const Subscription &subscription);
+
+  /**
+   * @brief Vuelve a leer las suscripciones de un miembro
+   */
+  void refreshMember(int64_t memberId);
+
+  /**
+   * @brief Descarta los intervalos; se recargan en la próxima consulta
+   *
+   * Para cambios en la duración de los planes.
+   */
+  void invalidate();
+
+  /**
+   * @brief Matriz de las últimas `cohorts` cohortes (incluido el mes
+   * actual)
+   */
+  [[nodiscard]] CohortMatrix matrix(int cohorts);
+
+  [[nodiscard]] size_t memberCount();
+
+private:
+  /**
+   * @brief Intervalo de actividad [start, end] en días julianos
+   */
+  struct Interval {
+    int32_t start;
+    int32_t end;
+  };
+
+  CohortEngine() = default;
+
+  CohortEngine(const CohortEngine &) = delete;
+  CohortEngine &operator=(const CohortEngine &) = delete;
+
+  void ensureLoaded();
+  void addPeriod(int64_t memberId, int32_t start, int32_t end);
+  void rebuild(int currentMonth);
+
+  [[nodiscard]] static int monthIndex(int32_t julianDay);
+
+  static constexpr int kBaseYear = 1970; ///< Mes 0 de los índices
+
+  SubscriptionRepository m_repo;
+  QHash<int64_t, std::vector<Interval>> m_intervals; ///< Ordenados, disjuntos
+
+  /// active[cohorte - m_firstMonth][k] para todas las cohortes
+  std::vector<std::vector<int>> m_active;
+  int m_firstMonth = 0;
+  int m_builtMonth = -1; ///< Mes actual con que se calculó m_active
+  bool m_loaded = false;
+  bool m_dirty = true;
+};
+
+} // namespace GymOS::Core::Services
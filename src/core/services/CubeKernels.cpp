@@ -0,0 +1,221 @@
+#include "CubeKernels.h"
+#include "CubeKernelsIsa.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(GYMOS_CUBE_SIMD) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace GymOS::Core::Services::CubeKernels {
+
+// ============================================================================
+// Versión escalar (referencia y fallback)
+// ============================================================================
+
+namespace Scalar {
+
+namespace {
+
+template <typename Key>
+void sumByKeyImpl(const Key *keys, const uint8_t *sel,
+                  const uint8_t *classification, const int64_t *cents,
+                  size_t n, GroupSums sums) {
+  for (size_t i = 0; i < n; ++i) {
+    // Máscaras en lugar de ramas: v = monto si la fila está seleccionada
+    const int64_t selected = -static_cast<int64_t>(sel[i]);
+    const int64_t expense = -static_cast<int64_t>(classification[i]);
+    const int64_t v = cents[i] & selected;
+    const Key k = keys[i];
+    sums.incomeCents[k] += v & ~expense;
+    sums.expenseCents[k] += v & expense;
+    sums.count[k] += sel[i];
+  }
+}
+
+} // namespace
+
+void selectRange(const int32_t *values, size_t n, int32_t from, int32_t to,
+                 uint8_t *sel) {
+  for (size_t i = 0; i < n; ++i) {
+    sel[i] = static_cast<uint8_t>((values[i] >= from) & (values[i] <= to));
+  }
+}
+
+void filterMask(const uint8_t *codes, size_t n, uint32_t mask, uint8_t *sel) {
+  for (size_t i = 0; i < n; ++i) {
+    sel[i] &= static_cast<uint8_t>((mask >> codes[i]) & 1U);
+  }
+}
+
+void filterEqual(const uint16_t *codes, size_t n, uint16_t value,
+                 uint8_t *sel) {
+  for (size_t i = 0; i < n; ++i) {
+    sel[i] &= static_cast<uint8_t>(codes[i] == value);
+  }
+}
+
+MaskedTotals sumSelected(const uint8_t *sel, const uint8_t *classification,
+                         const int64_t *cents, size_t n) {
+  MaskedTotals totals;
+  for (size_t i = 0; i < n; ++i) {
+    const int64_t selected = -static_cast<int64_t>(sel[i]);
+    const int64_t expense = -static_cast<int64_t>(classification[i]);
+    const int64_t v = cents[i] & selected;
+    totals.incomeCents += v & ~expense;
+    totals.expenseCents += v & expense;
+    totals.count += sel[i];
+  }
+  return totals;
+}
+
+void sumByKey8(const uint8_t *keys, const uint8_t *sel,
+               const uint8_t *classification, const int64_t *cents, size_t n,
+               GroupSums sums) {
+  sumByKeyImpl(keys, sel, classification, cents, n, sums);
+}
+
+void sumByKey16(const uint16_t *keys, const uint8_t *sel,
+                const uint8_t *classification, const int64_t *cents, size_t n,
+                GroupSums sums) {
+  sumByKeyImpl(keys, sel, classification, cents, n, sums);
+}
+
+} // namespace Scalar
+
+// ============================================================================
+// Selección en runtime
+// ============================================================================
+
+namespace {
+
+struct KernelTable {
+  const char *name;
+  decltype(&Scalar::selectRange) selectRange;
+  decltype(&Scalar::filterMask) filterMask;
+  decltype(&Scalar::filterEqual) filterEqual;
+  decltype(&Scalar::sumSelected) sumSelected;
+  decltype(&Scalar::sumByKey8) sumByKey8;
+  decltype(&Scalar::sumByKey16) sumByKey16;
+};
+
+const KernelTable kScalar{"scalar",
+                          &Scalar::selectRange,
+                          &Scalar::filterMask,
+                          &Scalar::filterEqual,
+                          &Scalar::sumSelected,
+                          &Scalar::sumByKey8,
+                          &Scalar::sumByKey16};
+
+#ifdef GYMOS_CUBE_SIMD
+const KernelTable kSse41{"sse41",
+                         &Sse41::selectRange,
+                         &Sse41::filterMask,
+                         &Sse41::filterEqual,
+                         &Sse41::sumSelected,
+                         &Sse41::sumByKey8,
+                         &Sse41::sumByKey16};
+
+const KernelTable kAvx2{"avx2",
+                        &Avx2::selectRange,
+                        &Avx2::filterMask,
+                        &Avx2::filterEqual,
+                        &Avx2::sumSelected,
+                        &Avx2::sumByKey8,
+                        &Avx2::sumByKey16};
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) {
+    return false;
+  }
+  __cpuid(info, 1);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  // El sistema operativo debe guardar los registros YMM (XCR0 bits 1 y 2)
+  if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+    return false;
+  }
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool cpuHasSse41() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 19)) != 0;
+#else
+  return __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+#endif
+
+const KernelTable &chooseKernels() {
+  const char *forced = std::getenv("GYMOS_SIMD");
+  const bool force = forced != nullptr && *forced != '\0';
+  if (force && std::strcmp(forced, "scalar") == 0) {
+    return kScalar;
+  }
+
+#ifdef GYMOS_CUBE_SIMD
+  const bool wantAvx2 = !force || std::strcmp(forced, "avx2") == 0;
+  if (wantAvx2 && cpuHasAvx2()) {
+    return kAvx2;
+  }
+  if (cpuHasSse41()) {
+    return kSse41;
+  }
+#endif
+
+  return kScalar;
+}
+
+const KernelTable &kernels() {
+  static const KernelTable &table = chooseKernels();
+  return table;
+}
+
+} // namespace
+
+const char *isaName() { return kernels().name; }
+
+void selectRange(const int32_t *values, size_t n, int32_t from, int32_t to,
+                 uint8_t *sel) {
+  kernels().selectRange(values, n, from, to, sel);
+}
+
+void filterMask(const uint8_t *codes, size_t n, uint32_t mask, uint8_t *sel) {
+  kernels().filterMask(codes, n, mask, sel);
+}
+
+void filterEqual(const uint16_t *codes, size_t n, uint16_t value,
+                 uint8_t *sel) {
+  kernels().filterEqual(codes, n, value, sel);
+}
+
+MaskedTotals sumSelected(const uint8_t *sel, const uint8_t *classification,
+                         const int64_t *cents, size_t n) {
+  return kernels().sumSelected(sel, classification, cents, n);
+}
+
+void sumByKey(const uint8_t *keys, const uint8_t *sel,
+              const uint8_t *classification, const int64_t *cents, size_t n,
+              GroupSums sums) {
+  kernels().sumByKey8(keys, sel, classification, cents, n, sums);
+}
+
+void sumByKey(const uint16_t *keys, const uint8_t *sel,
+              const uint8_t *classification, const int64_t *cents, size_t n,
+              GroupSums sums) {
+  kernels().sumByKey16(keys, sel, classification, cents, n, sums);
+}
+
+} // namespace GymOS::Core::Services::CubeKernels
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Kernels de filtrado y agregación de FinanceCube
+ *
+ * Funciones sobre arreglos planos (una columna por arreglo). El filtrado
+ * produce un vector de selección `sel` (1 = la fila pasa) que los filtros
+ * siguientes van combinando con AND y que la agregación usa como máscara
+ * en lugar de un `if`.
+ *
+ * Cada función tiene una versión escalar y, en x86, versiones SSE4.1 y
+ * AVX2 (CubeKernelsSse41.cpp, CubeKernelsAvx2.cpp) compiladas con sus
+ * propias flags. La primera llamada elige la mejor que soporte la CPU;
+ * GYMOS_SIMD=scalar|sse41|avx2 fuerza una (para comparar resultados o
+ * tiempos).
+ */
+namespace GymOS::Core::Services::CubeKernels {
+
+/**
+ * @brief Acumuladores por clave (arreglos de `keyCount` elementos)
+ */
+struct GroupSums {
+  int64_t *incomeCents;
+  int64_t *expenseCents;
+  int64_t *count;
+};
+
+/**
+ * @brief Totales de las filas seleccionadas
+ */
+struct MaskedTotals {
+  int64_t incomeCents = 0;
+  int64_t expenseCents = 0;
+  int64_t count = 0;
+};
+
+/**
+ * @brief Nombre de la implementación elegida ("avx2", "sse41", "scalar")
+ */
+const char *isaName();
+
+/**
+ * @brief sel[i] = from <= values[i] <= to
+ */
+void selectRange(const int32_t *values, size_t n, int32_t from, int32_t to,
+                 uint8_t *sel);
+
+/**
+ * @brief sel[i] &= bit codes[i] de `mask` (códigos de 0 a 15)
+ */
+void filterMask(const uint8_t *codes, size_t n, uint32_t mask, uint8_t *sel);
+
+/**
+ * @brief sel[i] &= codes[i] == value
+ */
+void filterEqual(const uint16_t *codes, size_t n, uint16_t value,
+                 uint8_t *sel);
+
+/**
+ * @brief Suma montos y cuenta las filas seleccionadas, por clasificación
+ *
+ * `classification` es 0 para ingresos y 1 para gastos.
+ */
+MaskedTotals sumSelected(const uint8_t *sel, const uint8_t *classification,
+                         const int64_t *cents, size_t n);
+
+/**
+ * @brief Suma montos y cuenta filas seleccionadas por clave
+ *
+ * Las claves deben ser menores que el tamaño de los acumuladores. La
+ * versión AVX2 aprovecha las rachas de filas con la misma clave
+ * (el libro se carga en orden de id, casi siempre en orden de fecha).
+ */
+void sumByKey(const uint8_t *keys, const uint8_t *sel,
+              const uint8_t *classification, const int64_t *cents, size_t n,
+              GroupSums sums);
+void sumByKey(const uint16_t *keys, const uint8_t *sel,
+              const uint8_t *classification, const int64_t *cents, size_t n,
+              GroupSums sums);
+
+} // namespace GymOS::Core::Services::CubeKernels
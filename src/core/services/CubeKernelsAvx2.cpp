@@ -0,0 +1,213 @@
+// Compilado con -mavx2 / /arch:AVX2 (ver CMakeLists.txt). Solo se llama si
+// la CPU soporta AVX2; no incluir headers de la biblioteca estándar con
+// código inline, porque el enlazador podría quedarse con esta copia.
+#include "CubeKernelsIsa.h"
+
+#ifdef GYMOS_CUBE_SIMD
+
+#include <cstring>
+#include <immintrin.h>
+
+namespace GymOS::Core::Services::CubeKernels::Avx2 {
+
+namespace {
+
+inline __m128i loadBytes4(const uint8_t *p) {
+  int32_t bytes;
+  std::memcpy(&bytes, p, sizeof(bytes));
+  return _mm_cvtsi32_si128(bytes);
+}
+
+inline int64_t horizontalSum(__m256i v) {
+  const __m128i pair = _mm_add_epi64(_mm256_castsi256_si128(v),
+                                     _mm256_extracti128_si256(v, 1));
+  return _mm_cvtsi128_si64(pair) + _mm_extract_epi64(pair, 1);
+}
+
+/**
+ * @brief Acumuladores vectoriales de 4 filas (una por carril de 64 bits)
+ */
+struct LaneSums {
+  __m256i income = _mm256_setzero_si256();
+  __m256i expense = _mm256_setzero_si256();
+  __m256i count = _mm256_setzero_si256();
+
+  void add(const uint8_t *sel, const uint8_t *classification,
+           const int64_t *cents) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i s = _mm256_cvtepu8_epi64(loadBytes4(sel));
+    const __m256i e = _mm256_cvtepu8_epi64(loadBytes4(classification));
+    const __m256i v = _mm256_and_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cents)),
+        _mm256_sub_epi64(zero, s));
+    const __m256i expenseMask = _mm256_sub_epi64(zero, e);
+    income = _mm256_add_epi64(income, _mm256_andnot_si256(expenseMask, v));
+    expense = _mm256_add_epi64(expense, _mm256_and_si256(expenseMask, v));
+    count = _mm256_add_epi64(count, s);
+  }
+
+  MaskedTotals totals() const {
+    MaskedTotals result;
+    result.incomeCents = horizontalSum(income);
+    result.expenseCents = horizontalSum(expense);
+    result.count = horizontalSum(count);
+    return result;
+  }
+};
+
+/**
+ * @brief Suma por clave aprovechando rachas de la misma clave
+ *
+ * Mientras los bloques de 4 filas tienen todos la clave de la racha
+ * actual, se acumulan en registros; al cambiar la clave se vuelca la
+ * racha en su acumulador y el bloque mixto se procesa fila por fila.
+ */
+template <typename Key>
+void sumByKeyRuns(const Key *keys, const uint8_t *sel,
+                  const uint8_t *classification, const int64_t *cents,
+                  size_t n, GroupSums sums) {
+  size_t i = 0;
+  while (i + 4 <= n) {
+    const Key key = keys[i];
+    LaneSums run;
+    size_t runLength = 0;
+    while (i + 4 <= n && keys[i + 1] == key && keys[i + 2] == key &&
+           keys[i + 3] == key && keys[i] == key) {
+      run.add(sel + i, classification + i, cents + i);
+      i += 4;
+      runLength += 4;
+    }
+
+    if (runLength > 0) {
+      const MaskedTotals totals = run.totals();
+      sums.incomeCents[key] += totals.incomeCents;
+      sums.expenseCents[key] += totals.expenseCents;
+      sums.count[key] += totals.count;
+    } else {
+      // Bloque con más de una clave
+      for (size_t end = i + 4; i < end; ++i) {
+        const int64_t selected = -static_cast<int64_t>(sel[i]);
+        const int64_t expense = -static_cast<int64_t>(classification[i]);
+        const int64_t v = cents[i] & selected;
+        sums.incomeCents[keys[i]] += v & ~expense;
+        sums.expenseCents[keys[i]] += v & expense;
+        sums.count[keys[i]] += sel[i];
+      }
+    }
+  }
+
+  for (; i < n; ++i) {
+    const int64_t selected = -static_cast<int64_t>(sel[i]);
+    const int64_t expense = -static_cast<int64_t>(classification[i]);
+    const int64_t v = cents[i] & selected;
+    sums.incomeCents[keys[i]] += v & ~expense;
+    sums.expenseCents[keys[i]] += v & expense;
+    sums.count[keys[i]] += sel[i];
+  }
+}
+
+} // namespace
+
+void selectRange(const int32_t *values, size_t n, int32_t from, int32_t to,
+                 uint8_t *sel) {
+  const __m256i lower = _mm256_set1_epi32(from);
+  const __m256i upper = _mm256_set1_epi32(to);
+  const __m256i one = _mm256_set1_epi32(1);
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i x =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+    const __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(lower, x),
+                                            _mm256_cmpgt_epi32(x, upper));
+    const __m256i inside = _mm256_andnot_si256(outside, one);
+    // 8 × int32 → 8 bytes, en orden
+    const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(inside),
+                                          _mm256_extracti128_si256(inside, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(sel + i),
+                     _mm_packus_epi16(words, words));
+  }
+  for (; i < n; ++i) {
+    sel[i] = static_cast<uint8_t>((values[i] >= from) & (values[i] <= to));
+  }
+}
+
+void filterMask(const uint8_t *codes, size_t n, uint32_t mask, uint8_t *sel) {
+  // Tabla código → bit: vpshufb la indexa con cada byte de `codes`
+  alignas(16) uint8_t table[16];
+  for (int code = 0; code < 16; ++code) {
+    table[code] = static_cast<uint8_t>((mask >> code) & 1U);
+  }
+  const __m256i lookup = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i *>(table)));
+
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i c =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(codes + i));
+    const __m256i s =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sel + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(sel + i),
+                        _mm256_and_si256(s, _mm256_shuffle_epi8(lookup, c)));
+  }
+  for (; i < n; ++i) {
+    sel[i] &= static_cast<uint8_t>((mask >> codes[i]) & 1U);
+  }
+}
+
+void filterEqual(const uint16_t *codes, size_t n, uint16_t value,
+                 uint8_t *sel) {
+  const __m256i target = _mm256_set1_epi16(static_cast<short>(value));
+  const __m256i one = _mm256_set1_epi16(1);
+
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m256i c =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(codes + i));
+    const __m256i equal =
+        _mm256_and_si256(_mm256_cmpeq_epi16(c, target), one);
+    // 16 × int16 → 16 bytes, en orden
+    const __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(equal),
+                                           _mm256_extracti128_si256(equal, 1));
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(sel + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(sel + i),
+                     _mm_and_si128(s, bytes));
+  }
+  for (; i < n; ++i) {
+    sel[i] &= static_cast<uint8_t>(codes[i] == value);
+  }
+}
+
+MaskedTotals sumSelected(const uint8_t *sel, const uint8_t *classification,
+                         const int64_t *cents, size_t n) {
+  LaneSums lanes;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    lanes.add(sel + i, classification + i, cents + i);
+  }
+
+  MaskedTotals totals = lanes.totals();
+  const MaskedTotals tail =
+      Scalar::sumSelected(sel + i, classification + i, cents + i, n - i);
+  totals.incomeCents += tail.incomeCents;
+  totals.expenseCents += tail.expenseCents;
+  totals.count += tail.count;
+  return totals;
+}
+
+void sumByKey8(const uint8_t *keys, const uint8_t *sel,
+               const uint8_t *classification, const int64_t *cents, size_t n,
+               GroupSums sums) {
+  sumByKeyRuns(keys, sel, classification, cents, n, sums);
+}
+
+void sumByKey16(const uint16_t *keys, const uint8_t *sel,
+                const uint8_t *classification, const int64_t *cents, size_t n,
+                GroupSums sums) {
+  sumByKeyRuns(keys, sel, classification, cents, n, sums);
+}
+
+} // namespace GymOS::Core::Services::CubeKernels::Avx2
+
+#endif
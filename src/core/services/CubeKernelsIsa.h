@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CubeKernels.h"
+
+/**
+ * @brief Implementaciones de CubeKernels por conjunto de instrucciones
+ *
+ * Uso interno de CubeKernels.cpp. Las versiones SSE4.1 y AVX2 solo existen
+ * en builds x86 (GYMOS_CUBE_SIMD) y solo deben llamarse después de
+ * comprobar que la CPU las soporta.
+ */
+namespace GymOS::Core::Services::CubeKernels {
+
+namespace Scalar {
+void selectRange(const int32_t *values, size_t n, int32_t from, int32_t to,
+                 uint8_t *sel);
+void filterMask(const uint8_t *codes, size_t n, uint32_t mask, uint8_t *sel);
+void filterEqual(const uint16_t *codes, size_t n, uint16_t value,
+                 uint8_t *sel);
+MaskedTotals sumSelected(const uint8_t *sel, const uint8_t *classification,
+                         const int64_t *cents, size_t n);
+void sumByKey8(const uint8_t *keys, const uint8_t *sel,
+               const uint8_t *classification, const int64_t *cents, size_t n,
+               GroupSums sums);
+void sumByKey16(const uint16_t *keys, const uint8_t *sel,
+                const uint8_t *classification, const int64_t *cents, size_t n,
+                GroupSums sums);
+} // namespace Scalar
+
+#ifdef GYMOS_CUBE_SIMD
+namespace Sse41 {
+void selectRange(const int32_t *values, size_t n, int32_t from, int32_t to,
+                 uint8_t *sel);
+void filterMask(const uint8_t *codes, size_t n, uint32_t mask, uint8_t *sel);
+void filterEqual(const uint16_t *codes, size_t n, uint16_t value,
+                 uint8_t *sel);
+MaskedTotals sumSelected(const uint8_t *sel, const uint8_t *classification,
+                         const int64_t *cents, size_t n);
+void sumByKey8(const uint8_t *keys, const uint8_t *sel,
+               const uint8_t *classification, const int64_t *cents, size_t n,
+               GroupSums sums);
+void sumByKey16(const uint16_t *keys, const uint8_t *sel,
+                const uint8_t *classification, const int64_t *cents, size_t n,
+                GroupSums sums);
+} // namespace Sse41
+
+namespace Avx2 {
+void selectRange(const int32_t *values, size_t n, int32_t from, int32_t to,
+                 uint8_t *sel);
+void filterMask(const uint8_t *codes, size_t n, uint32_t mask, uint8_t *sel);
+void filterEqual(const uint16_t *codes, size_t n, uint16_t value,
+                 uint8_t *sel);
+MaskedTotals sumSelected(const uint8_t *sel, const uint8_t *classification,
+                         const int64_t *cents, size_t n);
+void sumByKey8(const uint8_t *keys, const uint8_t *sel,
+               const uint8_t *classification, const int64_t *cents, size_t n,
+               GroupSums sums);
+void sumByKey16(const uint16_t *keys, const uint8_t *sel,
+                const uint8_t *classification, const int64_t *cents, size_t n,
+                GroupSums sums);
+} // namespace Avx2
+#endif
+
+} // namespace GymOS::Core::Services::CubeKernels
@@ -0,0 +1,140 @@
+// Compilado con -msse4.1 (ver CMakeLists.txt). Solo se llama si la CPU
+// soporta SSE4.1; no incluir headers de la biblioteca estándar con código
+// inline, porque el enlazador podría quedarse con esta copia.
+#include "CubeKernelsIsa.h"
+
+#ifdef GYMOS_CUBE_SIMD
+
+#include <cstring>
+#include <immintrin.h>
+
+namespace GymOS::Core::Services::CubeKernels::Sse41 {
+
+namespace {
+
+inline __m128i loadBytes2(const uint8_t *p) {
+  uint16_t bytes;
+  std::memcpy(&bytes, p, sizeof(bytes));
+  return _mm_cvtsi32_si128(bytes);
+}
+
+inline int64_t horizontalSum(__m128i v) {
+  return _mm_cvtsi128_si64(v) + _mm_extract_epi64(v, 1);
+}
+
+} // namespace
+
+void selectRange(const int32_t *values, size_t n, int32_t from, int32_t to,
+                 uint8_t *sel) {
+  const __m128i lower = _mm_set1_epi32(from);
+  const __m128i upper = _mm_set1_epi32(to);
+  const __m128i one = _mm_set1_epi32(1);
+
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128i x =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+    const __m128i outside = _mm_or_si128(_mm_cmplt_epi32(x, lower),
+                                         _mm_cmpgt_epi32(x, upper));
+    const __m128i inside = _mm_andnot_si128(outside, one);
+    const __m128i bytes =
+        _mm_packus_epi16(_mm_packs_epi32(inside, inside), inside);
+    const int32_t packed = _mm_cvtsi128_si32(bytes);
+    std::memcpy(sel + i, &packed, sizeof(packed));
+  }
+  for (; i < n; ++i) {
+    sel[i] = static_cast<uint8_t>((values[i] >= from) & (values[i] <= to));
+  }
+}
+
+void filterMask(const uint8_t *codes, size_t n, uint32_t mask, uint8_t *sel) {
+  // Tabla código → bit: pshufb la indexa con cada byte de `codes`
+  alignas(16) uint8_t table[16];
+  for (int code = 0; code < 16; ++code) {
+    table[code] = static_cast<uint8_t>((mask >> code) & 1U);
+  }
+  const __m128i lookup =
+      _mm_load_si128(reinterpret_cast<const __m128i *>(table));
+
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i c =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(codes + i));
+    const __m128i s = _mm_loadu_si128(reinterpret_cast<__m128i *>(sel + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(sel + i),
+                     _mm_and_si128(s, _mm_shuffle_epi8(lookup, c)));
+  }
+  for (; i < n; ++i) {
+    sel[i] &= static_cast<uint8_t>((mask >> codes[i]) & 1U);
+  }
+}
+
+void filterEqual(const uint16_t *codes, size_t n, uint16_t value,
+                 uint8_t *sel) {
+  const __m128i target = _mm_set1_epi16(static_cast<short>(value));
+  const __m128i one = _mm_set1_epi16(1);
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m128i c =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(codes + i));
+    const __m128i equal = _mm_and_si128(_mm_cmpeq_epi16(c, target), one);
+    const __m128i bytes = _mm_packus_epi16(equal, equal);
+    const __m128i s = _mm_loadl_epi64(reinterpret_cast<__m128i *>(sel + i));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(sel + i),
+                     _mm_and_si128(s, bytes));
+  }
+  for (; i < n; ++i) {
+    sel[i] &= static_cast<uint8_t>(codes[i] == value);
+  }
+}
+
+MaskedTotals sumSelected(const uint8_t *sel, const uint8_t *classification,
+                         const int64_t *cents, size_t n) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i income = zero;
+  __m128i expense = zero;
+  __m128i count = zero;
+
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128i s = _mm_cvtepu8_epi64(loadBytes2(sel + i));
+    const __m128i e = _mm_cvtepu8_epi64(loadBytes2(classification + i));
+    const __m128i v = _mm_and_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(cents + i)),
+        _mm_sub_epi64(zero, s));
+    const __m128i expenseMask = _mm_sub_epi64(zero, e);
+    income = _mm_add_epi64(income, _mm_andnot_si128(expenseMask, v));
+    expense = _mm_add_epi64(expense, _mm_and_si128(expenseMask, v));
+    count = _mm_add_epi64(count, s);
+  }
+
+  MaskedTotals totals;
+  totals.incomeCents = horizontalSum(income);
+  totals.expenseCents = horizontalSum(expense);
+  totals.count = horizontalSum(count);
+
+  const MaskedTotals tail =
+      Scalar::sumSelected(sel + i, classification + i, cents + i, n - i);
+  totals.incomeCents += tail.incomeCents;
+  totals.expenseCents += tail.expenseCents;
+  totals.count += tail.count;
+  return totals;
+}
+
+void sumByKey8(const uint8_t *keys, const uint8_t *sel,
+               const uint8_t *classification, const int64_t *cents, size_t n,
+               GroupSums sums) {
+  // Las sumas por clave son escrituras dispersas: sin AVX2 no hay ganancia
+  Scalar::sumByKey8(keys, sel, classification, cents, n, sums);
+}
+
+void sumByKey16(const uint16_t *keys, const uint8_t *sel,
+                const uint8_t *classification, const int64_t *cents, size_t n,
+                GroupSums sums) {
+  Scalar::sumByKey16(keys, sel, classification, cents, n, sums);
+}
+
+} // namespace GymOS::Core::Services::CubeKernels::Sse41
+
+#endif
@@ -0,0 +1,119 @@
+#include "ExpiryIndex.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+#include <algorithm>
+
+namespace GymOS::Core::Services {
+
+ExpiryIndex &ExpiryIndex::instance() {
+  static ExpiryIndex instance;
+  return instance;
+}
+
+void ExpiryIndex::ensureLoaded() {
+  if (m_loaded) {
+    return;
+  }
+
+  m_current.clear();
+  m_byEndDate.clear();
+  for (const auto &subscription : m_repo.findLatestPerMember()) {
+    insert(subscription);
+  }
+  m_loaded = true;
+
+  GYM_TRACE(lcSubscriptions) << "ExpiryIndex loaded:" << m_current.size()
+                             << "members," << m_byEndDate.size()
+                             << "buckets";
+}
+
+void ExpiryIndex::update(const Subscription &subscription) {
+  if (!m_loaded) {
+    return; // La carga inicial ya la incluirá
+  }
+
+  auto it = m_current.constFind(subscription.memberId);
+  if (it != m_current.constEnd() && it->id > subscription.id) {
+    return;
+  }
+  erase(subscription.memberId);
+  insert(subscription);
+}
+
+void ExpiryIndex::refreshMember(int64_t memberId) {
+  if (!m_loaded) {
+    return;
+  }
+
+  erase(memberId);
+  if (auto latest = m_repo.findLatestByMember(memberId)) {
+    insert(*latest);
+  }
+}
+
+void ExpiryIndex::invalidate() {
+  m_loaded = false;
+  m_current.clear();
+  m_byEndDate.clear();
+}
+
+std::vector<Subscription> ExpiryIndex::expiringBetween(const QDate &from,
+                                                       const QDate &to) {
+  ensureLoaded();
+  return collect(from, to);
+}
+
+std::vector<Subscription> ExpiryIndex::expiredBefore(const QDate &before,
+                                                     const QDate &since) {
+  ensureLoaded();
+  const QDate from =
+      since.isValid() ? since
+                      : (m_byEndDate.empty() ? before
+                                             : m_byEndDate.begin()->first);
+  return collect(from, before.addDays(-1));
+}
+
+size_t ExpiryIndex::size() {
+  ensureLoaded();
+  return static_cast<size_t>(m_current.size());
+}
+
+void ExpiryIndex::insert(const Subscription &subscription) {
+  m_current.insert(subscription.memberId, subscription);
+  m_byEndDate[subscription.endDate()].push_back(subscription.memberId);
+}
+
+void ExpiryIndex::erase(int64_t memberId) {
+  auto it = m_current.find(memberId);
+  if (it == m_current.end()) {
+    return;
+  }
+
+  auto bucket = m_byEndDate.find(it->endDate());
+  if (bucket != m_byEndDate.end()) {
+    auto &members = bucket->second;
+    members.erase(std::remove(members.begin(), members.end(), memberId),
+                  members.end());
+    if (members.empty()) {
+      m_byEndDate.erase(bucket);
+    }
+  }
+  m_current.erase(it);
+}
+
+std::vector<Subscription> ExpiryIndex::collect(const QDate &from,
+                                               const QDate &to) const {
+  std::vector<Subscription> result;
+  if (from > to) {
+    return result;
+  }
+
+  const auto end = m_byEndDate.upper_bound(to);
+  for (auto bucket = m_byEndDate.lower_bound(from); bucket != end; ++bucket) {
+    for (int64_t memberId : bucket->second) {
+      result.push_back(m_current.value(memberId));
+    }
+  }
+  return result;
+}
+
+} // namespace GymOS::Core::Services
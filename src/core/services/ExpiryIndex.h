@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../../infrastructure/repositories/SubscriptionRepository.h"
+#include "../models/Subscription.h"
+#include <QDate>
+#include <QHash>
+#include <map>
+#include <vector>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Repositories;
+
+/**
+ * @brief Índice en memoria de vencimientos
+ *
+ * Guarda la suscripción vigente (la más reciente) de cada miembro y un
+ * calendario ordenado de buckets por fecha de vencimiento. "Vence en los
+ * próximos N días" y "venció en los últimos M días" son lecturas de un
+ * rango de buckets: O(log n + resultado), sin recorrer la vista ni
+ * consultar la última suscripción de cada fila.
+ *
+ * Se carga con una sola consulta la primera vez que se usa. Las escrituras
+ * lo mantienen después de confirmar la transacción: SubscriptionManager al
+ * renovar, y el llamador de createSubscription() con refreshMember().
+ * Solo se usa desde el hilo principal.
+ */
+class ExpiryIndex {
+public:
+  static ExpiryIndex &instance();
+
+  /**
+   * @brief Registra la nueva suscripción vigente de un miembro
+   *
+   * Reemplaza la anterior solo si `subscription` es más reciente (mayor
+   * id); debe traer memberName y planName.
+   */
+  void update(const Subscription &subscription);
+
+  /**
+   * @brief Vuelve a leer la suscripción vigente de un miembro
+   *
+   * Para altas hechas dentro de una transacción ajena y cambios de nombre.
+   */
+  void refreshMember(int64_t memberId);
+
+  /**
+   * @brief Descarta el índice; se recarga en la próxima consulta
+   *
+   * Para cambios que afectan a muchas filas (p. ej. renombrar un plan).
+   */
+  void invalidate();
+
+  /**
+   * @brief Suscripciones vigentes que vencen en [from, to], por fecha
+   */
+  [[nodiscard]] std::vector<Subscription> expiringBetween(const QDate &from,
+                                                          const QDate &to);
+
+  /**
+   * @brief Suscripciones vigentes que vencieron antes de `before`
+   * @param since Si es válida, solo las que vencieron desde esa fecha
+   */
+  [[nodiscard]] std::vector<Subscription>
+  expiredBefore(const QDate &before, const QDate &since = QDate());
+
+  [[nodiscard]] size_t size();
+
+private:
+  ExpiryIndex() = default;
+
+  ExpiryIndex(const ExpiryIndex &) = delete;
+  ExpiryIndex &operator=(const ExpiryIndex &) = delete;
+
+  void ensureLoaded();
+  void insert(const Subscription &subscription);
+  void erase(int64_t memberId);
+
+  [[nodiscard]] std::vector<Subscription> collect(const QDate &from,
+                                                  const QDate &to) const;
+
+  SubscriptionRepository m_repo;
+  QHash<int64_t, Subscription> m_current; ///< member_id → vigente
+  std::map<QDate, std::vector<int64_t>> m_byEndDate; ///< Buckets por día
+  bool m_loaded = false;
+};
+
+} // namespace GymOS::Core::Services
@@ -0,0 +1,250 @@
+#include "FinanceCube.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+#include "../../infrastructure/diagnostics/Tracer.h"
+#include "CubeKernels.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <limits>
+
+namespace GymOS::Core::Services {
+
+namespace {
+
+constexpr int kEntryTypeCount = 4;
+constexpr int kWeekdayCount = 7;
+
+} // namespace
+
+FinanceCube &FinanceCube::instance() {
+  static FinanceCube instance;
+  return instance;
+}
+
+void FinanceCube::sync() {
+  if (m_loaded && !m_stale) {
+    return;
+  }
+  GYM_TRACE_SCOPE("finance", "FinanceCube::sync");
+
+  if (!m_loaded) {
+    qCInfo(lcFinance) << "FinanceCube: kernels" << CubeKernels::isaName();
+  }
+
+  const size_t before = m_day.size();
+  if (!m_repo.forEachFactAfter(
+          m_lastId, [this](const LedgerFact &fact) { append(fact); })) {
+    return; // Se reintenta en la próxima consulta
+  }
+  m_loaded = true;
+  m_stale = false;
+
+  GYM_TRACE(lcFinance) << "FinanceCube:" << m_day.size() - before
+                       << "filas nuevas," << m_day.size() << "en total";
+}
+
+void FinanceCube::invalidate() {
+  m_day.clear();
+  m_month.clear();
+  m_cents.clear();
+  m_type.clear();
+  m_class.clear();
+  m_weekday.clear();
+  m_plan.clear();
+  m_planIds.clear();
+  m_planIndex.clear();
+  m_maxMonth = 0;
+  m_lastId = 0;
+  m_loaded = false;
+  m_stale = false;
+}
+
+size_t FinanceCube::size() {
+  sync();
+  return m_day.size();
+}
+
+void FinanceCube::append(const LedgerFact &fact) {
+  const QDate date = QDate::fromJulianDay(fact.julianDay);
+  const int month = std::clamp((date.year() - kBaseYear) * 12 +
+                                   date.month() - 1,
+                               0, int(std::numeric_limits<uint16_t>::max()));
+
+  m_day.push_back(fact.julianDay);
+  m_month.push_back(static_cast<uint16_t>(month));
+  m_cents.push_back(fact.amountCents);
+  m_type.push_back(static_cast<uint8_t>(fact.entryType));
+  m_class.push_back(fact.classification == Classification::Expense ? 1 : 0);
+  m_weekday.push_back(static_cast<uint8_t>(date.dayOfWeek() - 1));
+  m_plan.push_back(planIndex(fact.planId));
+
+  m_maxMonth = std::max(m_maxMonth, static_cast<uint16_t>(month));
+  m_lastId = std::max(m_lastId, fact.id);
+}
+
+uint16_t FinanceCube::planIndex(int64_t planId) {
+  auto it = m_planIndex.constFind(planId);
+  if (it != m_planIndex.constEnd()) {
+    return *it;
+  }
+  const auto index = static_cast<uint16_t>(m_planIds.size());
+  m_planIds.push_back(planId);
+  m_planIndex.insert(planId, index);
+  return index;
+}
+
+void FinanceCube::select(const CubeFilter &filter) {
+  // Cada kernel combina su condición con AND sobre m_sel
+  const size_t n = m_day.size();
+  m_sel.resize(n);
+  const auto from = filter.from.isValid()
+                        ? static_cast<int32_t>(filter.from.toJulianDay())
+                        : std::numeric_limits<int32_t>::min();
+  const auto to = filter.to.isValid()
+                      ? static_cast<int32_t>(filter.to.toJulianDay())
+                      : std::numeric_limits<int32_t>::max();
+  CubeKernels::selectRange(m_day.data(), n, from, to, m_sel.data());
+
+  if ((filter.entryTypes & 0xF) != 0xF) {
+    CubeKernels::filterMask(m_type.data(), n, filter.entryTypes, m_sel.data());
+  }
+  if ((filter.classifications & 0x3) != 0x3) {
+    CubeKernels::filterMask(m_class.data(), n, filter.classifications,
+                            m_sel.data());
+  }
+  if ((filter.weekdays & 0x7F) != 0x7F) {
+    CubeKernels::filterMask(m_weekday.data(), n, filter.weekdays,
+                            m_sel.data());
+  }
+  if (filter.planId >= 0) {
+    auto it = m_planIndex.constFind(filter.planId);
+    if (it == m_planIndex.constEnd()) {
+      std::fill(m_sel.begin(), m_sel.end(), 0); // Plan sin movimientos
+    } else {
+      CubeKernels::filterEqual(m_plan.data(), n, *it, m_sel.data());
+    }
+  }
+}
+
+CubeCell FinanceCube::totals(const CubeFilter &filter) {
+  GYM_TRACE_SCOPE("finance", "FinanceCube::totals");
+  sync();
+  select(filter);
+
+  const CubeKernels::MaskedTotals totals = CubeKernels::sumSelected(
+      m_sel.data(), m_class.data(), m_cents.data(), m_day.size());
+  CubeCell cell;
+  cell.incomeCents = totals.incomeCents;
+  cell.expenseCents = totals.expenseCents;
+  cell.count = totals.count;
+  return cell;
+}
+
+CubeResult FinanceCube::aggregate(CubeDimension dimension,
+                                  const CubeFilter &filter) {
+  GYM_TRACE_SCOPE("finance", "FinanceCube::aggregate");
+  sync();
+
+  QElapsedTimer timer;
+  timer.start();
+
+  CubeResult result;
+  const size_t n = m_day.size();
+  result.scannedRows = n;
+
+  select(filter);
+
+  // Agrupación sobre acumuladores densos indexados por clave
+  size_t keyCount = 0;
+  switch (dimension) {
+  case CubeDimension::Month:
+    keyCount = n > 0 ? size_t(m_maxMonth) + 1 : 0;
+    break;
+  case CubeDimension::EntryType:
+    keyCount = kEntryTypeCount;
+    break;
+  case CubeDimension::Plan:
+    keyCount = m_planIds.size();
+    break;
+  case CubeDimension::Weekday:
+    keyCount = kWeekdayCount;
+    break;
+  }
+
+  std::vector<int64_t> income(keyCount), expense(keyCount), count(keyCount);
+  const CubeKernels::GroupSums sums{income.data(), expense.data(),
+                                    count.data()};
+  switch (dimension) {
+  case CubeDimension::Month:
+    CubeKernels::sumByKey(m_month.data(), m_sel.data(), m_class.data(),
+                          m_cents.data(), n, sums);
+    break;
+  case CubeDimension::EntryType:
+    CubeKernels::sumByKey(m_type.data(), m_sel.data(), m_class.data(),
+                          m_cents.data(), n, sums);
+    break;
+  case CubeDimension::Plan:
+    CubeKernels::sumByKey(m_plan.data(), m_sel.data(), m_class.data(),
+                          m_cents.data(), n, sums);
+    break;
+  case CubeDimension::Weekday:
+    CubeKernels::sumByKey(m_weekday.data(), m_sel.data(), m_class.data(),
+                          m_cents.data(), n, sums);
+    break;
+  }
+
+  auto cellAt = [&](size_t index, int64_t key) {
+    CubeCell cell;
+    cell.key = key;
+    if (index < keyCount) {
+      cell.incomeCents = income[index];
+      cell.expenseCents = expense[index];
+      cell.count = count[index];
+    }
+    return cell;
+  };
+
+  switch (dimension) {
+  case CubeDimension::Month:
+    if (filter.from.isValid() && filter.to.isValid()) {
+      // Todos los meses del rango, con ceros donde no hubo movimientos
+      const int first =
+          (filter.from.year() - kBaseYear) * 12 + filter.from.month() - 1;
+      const int last =
+          (filter.to.year() - kBaseYear) * 12 + filter.to.month() - 1;
+      for (int month = std::max(first, 0); month <= last; ++month) {
+        result.cells.push_back(
+            cellAt(size_t(month), kBaseYear * 12 + int64_t(month)));
+      }
+    } else {
+      for (size_t month = 0; month < keyCount; ++month) {
+        if (count[month] > 0) {
+          result.cells.push_back(
+              cellAt(month, kBaseYear * 12 + int64_t(month)));
+        }
+      }
+    }
+    break;
+  case CubeDimension::EntryType:
+    for (size_t type = 0; type < keyCount; ++type) {
+      result.cells.push_back(cellAt(type, int64_t(type)));
+    }
+    break;
+  case CubeDimension::Plan:
+    for (size_t index = 0; index < keyCount; ++index) {
+      if (count[index] > 0) {
+        result.cells.push_back(cellAt(index, m_planIds[index]));
+      }
+    }
+    break;
+  case CubeDimension::Weekday:
+    for (size_t day = 0; day < keyCount; ++day) {
+      result.cells.push_back(cellAt(day, int64_t(day) + 1));
+    }
+    break;
+  }
+
+  result.elapsedNs = timer.nsecsElapsed();
+  return result;
+}
+
+} // namespace GymOS::Core::Services
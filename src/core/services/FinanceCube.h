@@ -0,0 +1,141 @@
+#pragma once
+
+#include "../../infrastructure/repositories/FinancialEntryRepository.h"
+#include "../models/FinancialEntry.h"
+#include <QDate>
+#include <QHash>
+#include <cstdint>
+#include <vector>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Repositories;
+
+/**
+ * @brief Dimensión por la que se agrupa una consulta al cubo
+ */
+enum class CubeDimension {
+  Month,     ///< Clave: año * 12 + (mes - 1)
+  EntryType, ///< Clave: valor de EntryType
+  Plan,      ///< Clave: id del plan (0 = sin plan)
+  Weekday    ///< Clave: 1 = lunes … 7 = domingo
+};
+
+/**
+ * @brief Filtros de una consulta al cubo
+ */
+struct CubeFilter {
+  QDate from;                     ///< Inválida = sin límite inferior
+  QDate to;                       ///< Inválida = sin límite superior
+  uint32_t entryTypes = 0xF;      ///< Bit por valor de EntryType
+  uint32_t classifications = 0x3; ///< Bit 0 ingresos, bit 1 gastos
+  uint32_t weekdays = 0x7F;       ///< Bit 0 lunes … bit 6 domingo
+  int64_t planId = -1;            ///< -1 = todos, 0 = sin plan
+};
+
+/**
+ * @brief Totales de una celda (montos en centavos)
+ */
+struct CubeCell {
+  int64_t key = 0;
+  int64_t incomeCents = 0;
+  int64_t expenseCents = 0;
+  int64_t count = 0;
+};
+
+struct CubeResult {
+  std::vector<CubeCell> cells;
+  size_t scannedRows = 0;
+  qint64 elapsedNs = 0;
+};
+
+/**
+ * @brief Cubo financiero en memoria, por columnas
+ *
+ * Guarda el libro de movimientos como struct-of-arrays: un arreglo por
+ * dimensión (día, mes, monto en centavos, tipo, clasificación, día de la
+ * semana, plan). Una consulta filtra con los kernels de CubeKernels sobre
+ * las columnas que necesita y agrupa sobre acumuladores densos, sin SQL:
+ * recorrer decenas de miles de filas toma del orden de decenas de
+ * microsegundos.
+ *
+ * El libro es solo de inserción: sync() lee únicamente las filas con id
+ * mayor al último cargado. GymController llama a markStale() al publicar
+ * cambios de finanzas y la próxima consulta sincroniza. Solo se usa desde
+ * el hilo principal.
+ */
+class FinanceCube {
+public:
+  static FinanceCube &instance();
+
+  /**
+   * @brief Carga las filas nuevas del libro (todas, la primera vez)
+   */
+  void sync();
+
+  /**
+   * @brief Indica que hay filas nuevas; se leen en la próxima consulta
+   */
+  void markStale() { m_stale = true; }
+
+  /**
+   * @brief Descarta el cubo; se recarga completo en la próxima consulta
+   */
+  void invalidate();
+
+  /**
+   * @brief Filtra y agrupa por una dimensión
+   *
+   * Mes, tipo y día de la semana devuelven todas las claves del dominio
+   * (con ceros), en orden; para mes, solo si el filtro tiene ambas fechas.
+   * Plan devuelve solo los planes con movimientos.
+   */
+  [[nodiscard]] CubeResult aggregate(CubeDimension dimension,
+                                     const CubeFilter &filter);
+
+  /**
+   * @brief Totales de las filas que pasan el filtro (celda con clave 0)
+   */
+  [[nodiscard]] CubeCell totals(const CubeFilter &filter);
+
+  [[nodiscard]] size_t size();
+
+private:
+  FinanceCube() = default;
+
+  FinanceCube(const FinanceCube &) = delete;
+  FinanceCube &operator=(const FinanceCube &) = delete;
+
+  void append(const LedgerFact &fact);
+
+  /**
+   * @brief Deja en m_sel las filas que pasan el filtro
+   */
+  void select(const CubeFilter &filter);
+  [[nodiscard]] uint16_t planIndex(int64_t planId);
+
+  static constexpr int kBaseYear = 1970; ///< Mes 0 de m_month
+
+  FinancialEntryRepository m_repo;
+
+  // Columnas (una entrada por fila del libro)
+  std::vector<int32_t> m_day;     ///< Día juliano
+  std::vector<uint16_t> m_month;  ///< Meses desde enero de kBaseYear
+  std::vector<int64_t> m_cents;   ///< Monto en centavos (positivo)
+  std::vector<uint8_t> m_type;    ///< EntryType
+  std::vector<uint8_t> m_class;   ///< 0 = ingreso, 1 = gasto
+  std::vector<uint8_t> m_weekday; ///< 0 = lunes … 6 = domingo
+  std::vector<uint16_t> m_plan;   ///< Índice en m_planIds
+
+  std::vector<int64_t> m_planIds;       ///< Índice → plan_id (0 = ninguno)
+  QHash<int64_t, uint16_t> m_planIndex; ///< Id de plan → índice
+  std::vector<uint8_t> m_sel;           ///< Selección reutilizada
+
+  uint16_t m_maxMonth = 0;
+  int64_t m_lastId = 0;
+  bool m_loaded = false;
+  bool m_stale = false;
+};
+
+} // namespace GymOS::Core::Services
@@ -1,7 +1,27 @@
 #include "FinanceEngine.h"
+#include "BusinessClock.h"
+#include "FinanceCube.h"
+#include "../../infrastructure/diagnostics/Logging.h"
 
 namespace GymOS::Core::Services {
 
+namespace {
+
+/**
+ * @brief Resumen de las filas del cubo que pasan el filtro
+ */
+FinancialSummary summaryFromCube(const CubeFilter &filter) {
+  const CubeCell totals = FinanceCube::instance().totals(filter);
+
+  FinancialSummary summary;
+  summary.totalIncome = double(totals.incomeCents) / 100.0;
+  summary.totalExpenses = double(totals.expenseCents) / 100.0;
+  summary.transactionCount = static_cast<int>(totals.count);
+  return summary;
+}
+
+} // namespace
+
 FinanceEngine::FinanceEngine(QObject *parent) : QObject(parent) {}
 
 int64_t FinanceEngine::recordEnrollmentIncome(double amount,
@@ -32,27 +52,53 @@ int64_t FinanceEngine::recordCustomExpense(double amount,
                      description, date);
 }
 
+int64_t FinanceEngine::recordPaymentIncome(const Payment &payment,
+                                           const QString &description) {
+  EntryType type = EntryType::CustomIncome;
+  switch (payment.paymentType) {
+  case PaymentType::Enrollment:
+    type = EntryType::EnrollmentIncome;
+    break;
+  case PaymentType::Renewal:
+    type = EntryType::RenewalIncome;
+    break;
+  case PaymentType::Additional:
+    type = EntryType::CustomIncome;
+    break;
+  }
+
+  return recordEntry(type, Classification::Income, payment.amount, description,
+                     payment.paymentDate, payment.id);
+}
+
 FinancialSummary FinanceEngine::getSummary(const QDate &startDate,
                                            const QDate &endDate) const {
-  return m_repo.getSummary(startDate, endDate);
+  CubeFilter filter;
+  filter.from = startDate;
+  filter.to = endDate;
+  return summaryFromCube(filter);
 }
 
 FinancialSummary FinanceEngine::getTotalSummary() const {
-  return m_repo.getTotalSummary();
+  return m_snapshots.totalsAsOf(QDate()).toSummary();
+}
+
+FinancialSummary FinanceEngine::getSummaryAsOf(const QDate &date) const {
+  return m_snapshots.totalsAsOf(date).toSummary();
 }
 
 FinancialSummary FinanceEngine::getCurrentMonthSummary() const {
-  QDate today = QDate::currentDate();
+  QDate today = BusinessClock::instance().today();
   QDate firstDay(today.year(), today.month(), 1);
   QDate lastDay = firstDay.addMonths(1).addDays(-1);
-  return m_repo.getSummary(firstDay, lastDay);
+  return getSummary(firstDay, lastDay);
 }
 
 FinancialSummary FinanceEngine::getCurrentYearSummary() const {
-  QDate today = QDate::currentDate();
+  QDate today = BusinessClock::instance().today();
   QDate firstDay(today.year(), 1, 1);
   QDate lastDay(today.year(), 12, 31);
-  return m_repo.getSummary(firstDay, lastDay);
+  return m_snapshots.totalsBetween(firstDay, lastDay).toSummary();
 }
 
 std::vector<FinancialEntry>
@@ -62,19 +108,41 @@ FinanceEngine::getLatestTransactions(int limit) const {
 
 std::vector<MonthlyBreakdown>
 FinanceEngine::getMonthlyBreakdown(int months) const {
-  QDate endDate = QDate::currentDate();
+  QDate endDate = BusinessClock::instance().today();
   QDate startDate = endDate.addMonths(-months + 1);
   startDate = QDate(startDate.year(), startDate.month(), 1);
 
-  return m_repo.getMonthlyBreakdown(startDate, endDate);
+  CubeFilter filter;
+  filter.from = startDate;
+  filter.to = endDate;
+  const CubeResult result =
+      FinanceCube::instance().aggregate(CubeDimension::Month, filter);
+
+  // El cubo devuelve todos los meses del rango, incluidos los vacíos
+  std::vector<MonthlyBreakdown> breakdown;
+  breakdown.reserve(result.cells.size());
+  for (const CubeCell &cell : result.cells) {
+    MonthlyBreakdown mb;
+    mb.year = static_cast<int>(cell.key / 12);
+    mb.month = static_cast<int>(cell.key % 12) + 1;
+    mb.income = double(cell.incomeCents) / 100.0;
+    mb.expenses = double(cell.expenseCents) / 100.0;
+    breakdown.push_back(mb);
+  }
+  return breakdown;
+}
+
+int FinanceEngine::closePeriods() {
+  return m_snapshots.closeMonths(BusinessClock::instance().today());
 }
 
 int64_t FinanceEngine::recordEntry(EntryType type,
                                    Classification classification, double amount,
                                    const QString &description,
-                                   const QDate &date) {
+                                   const QDate &date,
+                                   std::optional<int64_t> paymentId) {
   if (amount <= 0) {
-    qWarning() << "El monto debe ser positivo";
+    qCWarning(lcFinance) << "El monto debe ser positivo";
     return -1;
   }
 
@@ -84,6 +152,7 @@ int64_t FinanceEngine::recordEntry(EntryType type,
   entry.amount = amount;
   entry.description = description;
   entry.entryDate = date;
+  entry.paymentId = paymentId;
 
   int64_t entryId = m_repo.insert(entry);
 
@@ -2,6 +2,9 @@
 
 #include "../../infrastructure/repositories/FinancialEntryRepository.h"
 #include "../models/FinancialEntry.h"
+#include "../models/Payment.h"
+#include "BusinessClock.h"
+#include "LedgerSnapshots.h"
 #include <QDate>
 #include <QObject>
 #include <vector>
@@ -19,7 +22,10 @@ using namespace GymOS::Infrastructure::Repositories;
  * financieros y el cálculo dinámico de resúmenes.
  *
  * IMPORTANTE: Todas las entradas son inmutables (append-only).
- * Los balances y totales se calculan dinámicamente.
+ * Los balances y totales se calculan dinámicamente sobre FinanceCube, por
+ * lo que las consultas solo deben hacerse desde el hilo principal. El
+ * total histórico y el del año salen del último cierre mensual
+ * (LedgerSnapshots) más los movimientos posteriores.
  */
 class FinanceEngine : public QObject {
   Q_OBJECT
@@ -34,26 +40,39 @@ public:
   /**
    * @brief Registra un ingreso por inscripción
    */
-  int64_t recordEnrollmentIncome(double amount, const QString &description,
-                                 const QDate &date = QDate::currentDate());
+  int64_t recordEnrollmentIncome(
+      double amount, const QString &description,
+      const QDate &date = BusinessClock::instance().today());
 
   /**
    * @brief Registra un ingreso por renovación
    */
-  int64_t recordRenewalIncome(double amount, const QString &description,
-                              const QDate &date = QDate::currentDate());
+  int64_t recordRenewalIncome(
+      double amount, const QString &description,
+      const QDate &date = BusinessClock::instance().today());
 
   /**
    * @brief Registra un ingreso personalizado
    */
-  int64_t recordCustomIncome(double amount, const QString &description,
-                             const QDate &date = QDate::currentDate());
+  int64_t recordCustomIncome(
+      double amount, const QString &description,
+      const QDate &date = BusinessClock::instance().today());
 
   /**
    * @brief Registra un gasto personalizado
    */
-  int64_t recordCustomExpense(double amount, const QString &description,
-                              const QDate &date = QDate::currentDate());
+  int64_t recordCustomExpense(
+      double amount, const QString &description,
+      const QDate &date = BusinessClock::instance().today());
+
+  /**
+   * @brief Registra el ingreso correspondiente a un pago ya insertado
+   *
+   * El tipo de entrada se deriva del tipo de pago y la entrada queda
+   * enlazada por payment_id.
+   */
+  int64_t recordPaymentIncome(const Payment &payment,
+                              const QString &description);
 
   // ========================================================================
   // Consultas y Cálculos Dinámicos
@@ -70,6 +89,11 @@ public:
    */
   FinancialSummary getTotalSummary() const;
 
+  /**
+   * @brief Resumen de los movimientos con fecha hasta `date` (incluida)
+   */
+  FinancialSummary getSummaryAsOf(const QDate &date) const;
+
   /**
    * @brief Obtiene el resumen del mes actual
    */
@@ -87,9 +111,18 @@ public:
 
   /**
    * @brief Obtiene el desglose mensual para gráficos
+   *
+   * Devuelve exactamente `months` filas, del mes más antiguo al actual;
+   * los meses sin movimientos van con ceros.
    */
   std::vector<MonthlyBreakdown> getMonthlyBreakdown(int months = 6) const;
 
+  /**
+   * @brief Cierra los meses terminados que no tienen cierre
+   * @return Cantidad de meses cerrados
+   */
+  int closePeriods();
+
 signals:
   void incomeRecorded(int64_t entryId, double amount);
   void expenseRecorded(int64_t entryId, double amount);
@@ -97,9 +130,11 @@ signals:
 private:
   int64_t recordEntry(EntryType type, Classification classification,
                       double amount, const QString &description,
-                      const QDate &date);
+                      const QDate &date,
+                      std::optional<int64_t> paymentId = std::nullopt);
 
   FinancialEntryRepository m_repo;
+  LedgerSnapshots m_snapshots;
 };
 
 } // namespace GymOS::Core::Services
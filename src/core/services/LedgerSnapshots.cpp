@@ -0,0 +1,74 @@
+#include "LedgerSnapshots.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+#include "../../infrastructure/diagnostics/Tracer.h"
+#include <limits>
+#include <vector>
+
+namespace GymOS::Core::Services {
+
+int LedgerSnapshots::closeMonths(const QDate &today) {
+  GYM_TRACE_SCOPE("finance", "LedgerSnapshots::closeMonths");
+
+  const QDate currentMonth(today.year(), today.month(), 1);
+  std::optional<LedgerSnapshot> base = m_repo.latestOnOrBefore(QDate());
+
+  QDate month;
+  if (base) {
+    month = base->month.addMonths(1);
+  } else {
+    const QDate first = m_repo.firstEntryDate();
+    if (!first.isValid()) {
+      return 0; // Libro vacío
+    }
+    month = QDate(first.year(), first.month(), 1);
+  }
+  if (month >= currentMonth) {
+    return 0; // Al día
+  }
+
+  // Todos los cierres de esta pasada incluyen hasta el mismo id
+  const int64_t maxId = m_repo.maxEntryId();
+  std::vector<LedgerSnapshot> closed;
+  for (; month < currentMonth; month = month.addMonths(1)) {
+    LedgerSnapshot snapshot;
+    snapshot.month = month;
+    snapshot.periodEnd = month.addMonths(1).addDays(-1);
+    snapshot.lastEntryId = maxId;
+
+    const auto delta = m_repo.totalsSince(base, snapshot.periodEnd, maxId);
+    if (!delta) {
+      return 0; // Sin cierres parciales: se reintenta en la próxima pasada
+    }
+    if (base) {
+      snapshot.totals = base->totals;
+    }
+    snapshot.totals += *delta;
+    closed.push_back(snapshot);
+    base = snapshot;
+  }
+
+  if (closed.empty() || !m_repo.insert(closed)) {
+    return 0;
+  }
+  qCInfo(lcFinance) << "Cierres del libro:" << closed.size() << "meses hasta"
+                    << closed.back().month.toString("yyyy-MM");
+  return static_cast<int>(closed.size());
+}
+
+LedgerTotals LedgerSnapshots::totalsAsOf(const QDate &date) const {
+  const std::optional<LedgerSnapshot> base = m_repo.latestOnOrBefore(date);
+  LedgerTotals totals = base ? base->totals : LedgerTotals{};
+  totals += m_repo
+                .totalsSince(base, date, std::numeric_limits<int64_t>::max())
+                .value_or(LedgerTotals{});
+  return totals;
+}
+
+LedgerTotals LedgerSnapshots::totalsBetween(const QDate &from,
+                                            const QDate &to) const {
+  LedgerTotals totals = totalsAsOf(to);
+  totals -= totalsAsOf(from.addDays(-1));
+  return totals;
+}
+
+} // namespace GymOS::Core::Services
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../../infrastructure/repositories/LedgerSnapshotRepository.h"
+#include "../models/LedgerSnapshot.h"
+#include <QDate>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Repositories;
+
+/**
+ * @brief Cierres mensuales del libro y totales a una fecha
+ *
+ * closeMonths() guarda, para cada mes terminado que todavía no tiene
+ * cierre, los totales acumulados del libro a fin de mes; cada cierre se
+ * calcula desde el anterior más los movimientos del mes, así que cerrar
+ * cuesta lo que el mes y no lo que el historial.
+ *
+ * Los totales a una fecha son el último cierre anterior más los
+ * movimientos que ese cierre no incluye (los del mes en curso y los
+ * registrados después del cierre con fecha anterior). El total histórico y
+ * el del año cuestan O(movimientos desde el último cierre).
+ */
+class LedgerSnapshots {
+public:
+  /**
+   * @brief Cierra los meses anteriores al de `today` que no tienen cierre
+   * @return Cantidad de meses cerrados (0 si no había o si falló)
+   */
+  int closeMonths(const QDate &today);
+
+  /**
+   * @brief Totales de los movimientos con fecha hasta `date` (incluida)
+   * @param date Inválida = todo el libro
+   */
+  [[nodiscard]] LedgerTotals totalsAsOf(const QDate &date) const;
+
+  /**
+   * @brief Totales de los movimientos con fecha en [from, to]
+   */
+  [[nodiscard]] LedgerTotals totalsBetween(const QDate &from,
+                                           const QDate &to) const;
+
+private:
+  LedgerSnapshotRepository m_repo;
+};
+
+} // namespace GymOS::Core::Services
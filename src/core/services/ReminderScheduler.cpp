@@ -0,0 +1,254 @@
+#include "ReminderScheduler.h"
+#include "../../infrastructure/database/DatabaseManager.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+#include "../../infrastructure/diagnostics/Tracer.h"
+#include "BusinessClock.h"
+#include "ExpiryIndex.h"
+#include <QHash>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Infrastructure::Database;
+
+namespace {
+
+const QString kWindowsKey = QStringLiteral("reminder_windows");
+const QString kTemplateKey = QStringLiteral("reminder_template");
+const QString kLastRunKey = QStringLiteral("reminder_last_run");
+
+const QString kDefaultWindows = QStringLiteral("7,3,1");
+const QString kDefaultTemplate = QStringLiteral(
+    "Hola {nombre}, tu plan {plan} vence el {fecha} (en {dias} días). "
+    "¡Te esperamos para renovarlo!");
+
+struct OutboxTotals {
+  int sent = 0;
+  int failed = 0;
+};
+
+} // namespace
+
+ReminderScheduler::ReminderScheduler(QObject *parent) : QObject(parent) {
+  connect(&BusinessClock::instance(), &BusinessClock::dayChanged, this,
+          &ReminderScheduler::runIfDue);
+}
+
+void ReminderScheduler::setSender(std::shared_ptr<ReminderSender> sender) {
+  m_sender = std::move(sender);
+}
+
+QList<int> ReminderScheduler::windows() const {
+  QList<int> result;
+  for (const QString &part :
+       setting(kWindowsKey, kDefaultWindows).split(',', Qt::SkipEmptyParts)) {
+    bool ok = false;
+    const int days = part.trimmed().toInt(&ok);
+    if (ok && days >= 0 && !result.contains(days)) {
+      result.append(days);
+    }
+  }
+  std::sort(result.begin(), result.end(), std::greater<int>());
+  return result;
+}
+
+void ReminderScheduler::setWindows(const QList<int> &windows) {
+  QStringList parts;
+  for (int days : windows) {
+    parts << QString::number(days);
+  }
+  setSetting(kWindowsKey, parts.join(','));
+}
+
+QString ReminderScheduler::messageTemplate() const {
+  return setting(kTemplateKey, kDefaultTemplate);
+}
+
+void ReminderScheduler::setMessageTemplate(const QString &text) {
+  setSetting(kTemplateKey, text);
+}
+
+void ReminderScheduler::runIfDue() {
+  const QDate today = BusinessClock::instance().today();
+  const QString todayKey = today.toString(Qt::ISODate);
+
+  if (setting(kLastRunKey, QString()) != todayKey) {
+    generate(today);
+    setSetting(kLastRunKey, todayKey);
+  }
+  processOutbox();
+}
+
+int ReminderScheduler::generate(const QDate &today) {
+  GYM_TRACE_SCOPE("reminders", __func__);
+
+  const QList<int> windows = this->windows();
+  if (windows.isEmpty()) {
+    return 0;
+  }
+
+  // Cada suscripción recibe el aviso de la ventana más chica que ya
+  // alcanzó (con 7,3,1: a 5 días el de 7, a 2 días el de 3). Si la
+  // aplicación no se abrió algún día, el aviso se genera igual al volver.
+  const auto expiring = ExpiryIndex::instance().expiringBetween(
+      today, today.addDays(windows.first()));
+  if (expiring.empty()) {
+    return 0;
+  }
+
+  std::vector<int64_t> memberIds;
+  memberIds.reserve(expiring.size());
+  for (const auto &subscription : expiring) {
+    memberIds.push_back(subscription.memberId);
+  }
+  QHash<int64_t, Member> members;
+  for (auto &member : m_memberRepo.findByIds(memberIds)) {
+    members.insert(member.id, std::move(member));
+  }
+
+  const QString text = messageTemplate();
+  std::vector<Reminder> reminders;
+  reminders.reserve(expiring.size());
+  for (const auto &subscription : expiring) {
+    const int daysLeft = today.daysTo(subscription.endDate());
+    int window = windows.first();
+    for (int candidate : windows) {
+      if (candidate >= daysLeft) {
+        window = candidate;
+      }
+    }
+
+    Reminder reminder;
+    reminder.memberId = subscription.memberId;
+    reminder.subscriptionId = subscription.id;
+    reminder.windowDays = window;
+    reminder.expiryDate = subscription.endDate();
+    reminder.memberName = subscription.memberName;
+    reminder.planName = subscription.planName;
+    if (auto member = members.constFind(subscription.memberId);
+        member != members.constEnd()) {
+      reminder.phone = member->phone.value_or(QString());
+      reminder.email = member->email.value_or(QString());
+    }
+    reminder.message = render(text, subscription, daysLeft);
+    reminders.push_back(std::move(reminder));
+  }
+
+  const int queued = m_outbox.enqueue(reminders);
+  qCInfo(lcSubscriptions) << "Recordatorios generados:" << qMax(queued, 0)
+                          << "de" << reminders.size() << "vencimientos";
+  if (queued > 0) {
+    emit remindersQueued(queued);
+  }
+  return qMax(queued, 0);
+}
+
+void ReminderScheduler::processOutbox() {
+  if (m_processing || !m_sender) {
+    return;
+  }
+  m_processing = true;
+
+  auto work = [sender = m_sender]() {
+    GYM_TRACE_SCOPE("reminders", "processOutbox");
+    const QString connection = QStringLiteral("gymos_outbox");
+    OutboxTotals totals;
+    {
+      QSqlDatabase db =
+          DatabaseManager::instance().openWorkerConnection(connection, false);
+      // Un lote reclamado sin resultado guardado es de una pasada anterior
+      // que se cortó: se cierra como fallido en lugar de reenviarlo
+      if (db.isOpen()) {
+        const int interrupted = OutboxRepository::failInterrupted(db);
+        if (interrupted > 0) {
+          qCWarning(lcSubscriptions)
+              << "Recordatorios con envío interrumpido:" << interrupted;
+          totals.failed += interrupted;
+        }
+      }
+
+      int64_t lastId = 0;
+      while (db.isOpen()) {
+        auto batch = OutboxRepository::fetchPending(db, lastId, kBatchSize);
+        if (batch.empty()) {
+          break;
+        }
+        lastId = batch.back().id;
+
+        // Reclamar antes de enviar: si después no se puede guardar el
+        // resultado, el lote queda en `sending` y no se reenvía
+        if (!OutboxRepository::claim(db, batch)) {
+          qCWarning(lcSubscriptions)
+              << "No se pudo reclamar el lote del outbox; envío detenido";
+          break;
+        }
+        for (Reminder &reminder : batch) {
+          reminder.attempts++;
+        }
+
+        sender->send(batch);
+        for (Reminder &reminder : batch) {
+          if (reminder.status == ReminderStatus::Sent) {
+            totals.sent++;
+          } else if (reminder.attempts >= kMaxAttempts) {
+            reminder.status = ReminderStatus::Failed;
+            totals.failed++;
+          } else {
+            reminder.status = ReminderStatus::Pending;
+          }
+        }
+
+        if (!OutboxRepository::saveResults(db, batch)) {
+          qCWarning(lcSubscriptions)
+              << "No se pudo guardar el resultado del lote del outbox; "
+                 "envío detenido";
+          break;
+        }
+      }
+    }
+    DatabaseManager::closeWorkerConnection(connection);
+    return totals;
+  };
+
+  QtConcurrent::run(work).then(this, [this](const OutboxTotals &totals) {
+    m_processing = false;
+    if (totals.sent > 0 || totals.failed > 0) {
+      qCInfo(lcSubscriptions) << "Outbox procesado:" << totals.sent
+                              << "enviados," << totals.failed << "fallidos";
+      emit outboxProcessed(totals.sent, totals.failed);
+    }
+  });
+}
+
+QString ReminderScheduler::render(const QString &text,
+                                  const Subscription &subscription,
+                                  int daysLeft) {
+  QString message = text;
+  message.replace("{nombre}", subscription.memberName);
+  message.replace("{plan}", subscription.planName);
+  message.replace("{fecha}", subscription.endDate().toString("dd/MM/yyyy"));
+  message.replace("{dias}", QString::number(daysLeft));
+  return message;
+}
+
+QString ReminderScheduler::setting(const QString &key,
+                                   const QString &fallback) const {
+  QSqlQuery query = DatabaseManager::instance().executeQuery(
+      "SELECT value FROM settings WHERE key = ?", {key});
+  if (query.next() && !query.value(0).isNull()) {
+    return query.value(0).toString();
+  }
+  return fallback;
+}
+
+void ReminderScheduler::setSetting(const QString &key, const QString &value) {
+  DatabaseManager::instance().executeQuery(
+      "INSERT INTO settings (key, value, updated_at) VALUES (?, ?, "
+      "datetime('now')) "
+      "ON CONFLICT(key) DO UPDATE SET value = excluded.value, updated_at = "
+      "excluded.updated_at",
+      {key, value});
+}
+
+} // namespace GymOS::Core::Services
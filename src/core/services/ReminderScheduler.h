@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../../infrastructure/repositories/MemberRepository.h"
+#include "../../infrastructure/repositories/OutboxRepository.h"
+#include "../models/Reminder.h"
+#include "../models/Subscription.h"
+#include "ReminderSender.h"
+#include <QDate>
+#include <QList>
+#include <QObject>
+#include <memory>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Repositories;
+
+/**
+ * @brief Genera y envía recordatorios de vencimiento
+ *
+ * Una vez por día (al arrancar y en cada BusinessClock::dayChanged) busca
+ * en ExpiryIndex los miembros cuya suscripción vigente vence dentro de
+ * alguna de las ventanas configuradas (`reminder_windows`, p. ej. "7,3,1")
+ * y escribe un recordatorio por suscripción y ventana en el outbox, con el
+ * mensaje renderizado desde `reminder_template`.
+ *
+ * El envío recorre los pendientes en lotes desde un hilo de trabajo, con
+ * su propia conexión, y delega cada lote en el ReminderSender configurado.
+ * Cada lote se reclama (`sending`) antes de enviarlo y su resultado se
+ * guarda después; si una de las dos escrituras falla, la pasada se corta.
+ */
+class ReminderScheduler : public QObject {
+  Q_OBJECT
+
+public:
+  /// Recordatorios por lote de envío
+  static constexpr int kBatchSize = 50;
+  /// Intentos antes de marcar un recordatorio como fallido
+  static constexpr int kMaxAttempts = 3;
+
+  explicit ReminderScheduler(QObject *parent = nullptr);
+
+  /**
+   * @brief Define el canal de envío (nullptr deshabilita el envío)
+   */
+  void setSender(std::shared_ptr<ReminderSender> sender);
+
+  /**
+   * @brief Días de anticipación de los avisos, de mayor a menor
+   */
+  [[nodiscard]] QList<int> windows() const;
+  void setWindows(const QList<int> &windows);
+
+  /**
+   * @brief Plantilla del mensaje
+   *
+   * Marcadores: {nombre}, {plan}, {fecha} (dd/MM/yyyy) y {dias}.
+   */
+  [[nodiscard]] QString messageTemplate() const;
+  void setMessageTemplate(const QString &text);
+
+  /**
+   * @brief Genera los recordatorios del día si todavía no se generaron
+   * y procesa el outbox
+   */
+  void runIfDue();
+
+  /**
+   * @brief Genera los recordatorios para la fecha indicada
+   * @return Cantidad de recordatorios nuevos en el outbox
+   */
+  int generate(const QDate &today);
+
+  /**
+   * @brief Envía los pendientes en un hilo de trabajo (no hace nada si ya
+   * hay un envío en curso o no hay sender)
+   */
+  void processOutbox();
+
+  [[nodiscard]] bool isProcessing() const { return m_processing; }
+
+  /**
+   * @brief Reemplaza los marcadores de la plantilla
+   */
+  [[nodiscard]] static QString render(const QString &text,
+                                      const Subscription &subscription,
+                                      int daysLeft);
+
+signals:
+  void remindersQueued(int count);
+  void outboxProcessed(int sent, int failed);
+
+private:
+  [[nodiscard]] QString setting(const QString &key,
+                                const QString &fallback) const;
+  void setSetting(const QString &key, const QString &value);
+
+  OutboxRepository m_outbox;
+  MemberRepository m_memberRepo;
+  std::shared_ptr<ReminderSender> m_sender;
+  bool m_processing = false;
+};
+
+} // namespace GymOS::Core::Services
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../models/Reminder.h"
+#include <QString>
+#include <vector>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Core::Models;
+
+/**
+ * @brief Canal de envío de recordatorios
+ *
+ * ReminderScheduler llama a send() desde un hilo de trabajo, con lotes del
+ * outbox y nunca en paralelo. La implementación marca cada recordatorio
+ * como enviado (status Sent, sentAt) o deja el error en lastError; los
+ * intentos y el paso a Failed los maneja el scheduler.
+ */
+class ReminderSender {
+public:
+  virtual ~ReminderSender() = default;
+
+  /**
+   * @brief Nombre del canal (para logs)
+   */
+  [[nodiscard]] virtual QString name() const = 0;
+
+  /**
+   * @brief Envía un lote de recordatorios pendientes
+   */
+  virtual void send(std::vector<Reminder> &batch) = 0;
+};
+
+} // namespace GymOS::Core::Services
@@ -0,0 +1,74 @@
+#include "RenewalForecast.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+#include "../../infrastructure/diagnostics/Tracer.h"
+#include "BusinessClock.h"
+#include "ExpiryIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GymOS::Core::Services {
+
+int64_t RevenueForecast::projectedCents(int count) const {
+  if (days.empty() || count <= 0) {
+    return 0;
+  }
+  const size_t last = std::min(days.size(), static_cast<size_t>(count)) - 1;
+  return days[last].cumulativeCents;
+}
+
+const RevenueForecast &RenewalForecast::forecast() {
+  const QDate today = BusinessClock::instance().today();
+  if (m_dirty || m_forecast.from != today) {
+    rebuild(today);
+  }
+  return m_forecast;
+}
+
+void RenewalForecast::rebuild(const QDate &today) {
+  GYM_TRACE_SCOPE("subscriptions", "RenewalForecast::rebuild");
+
+  RevenueForecast forecast;
+  forecast.from = today;
+
+  QHash<int64_t, double> probabilities;
+  for (const auto &counts : m_repo.renewalCountsByPlan(today, kGraceDays)) {
+    PlanRenewalRate rate;
+    rate.planId = counts.planId;
+    rate.ended = counts.ended;
+    rate.renewed = counts.renewed;
+    rate.probability = (counts.renewed + 1.0) / (counts.ended + 2.0);
+    probabilities.insert(rate.planId, rate.probability);
+    forecast.rates.push_back(rate);
+  }
+
+  forecast.days.resize(kHorizonDays);
+  for (int k = 0; k < kHorizonDays; ++k) {
+    forecast.days[k].date = today.addDays(k);
+  }
+
+  // Los vencimientos llegan ordenados por fecha: un solo recorrido
+  std::vector<double> cents(kHorizonDays, 0.0);
+  for (const auto &subscription : ExpiryIndex::instance().expiringBetween(
+           today, today.addDays(kHorizonDays - 1))) {
+    const auto k = static_cast<int>(today.daysTo(subscription.endDate()));
+    const double probability = probabilities.value(subscription.planId, 0.5);
+    ForecastDay &day = forecast.days[k];
+    day.expiring++;
+    day.expectedRenewals += probability;
+    cents[k] += subscription.planPrice * 100.0 * probability;
+  }
+
+  int64_t cumulative = 0;
+  for (int k = 0; k < kHorizonDays; ++k) {
+    forecast.days[k].projectedCents = std::llround(cents[k]);
+    cumulative += forecast.days[k].projectedCents;
+    forecast.days[k].cumulativeCents = cumulative;
+  }
+
+  GYM_TRACE(lcSubscriptions) << "RenewalForecast:" << kHorizonDays
+                             << "days," << forecast.rates.size() << "plans";
+  m_forecast = std::move(forecast);
+  m_dirty = false;
+}
+
+} // namespace GymOS::Core::Services
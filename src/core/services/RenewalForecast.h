@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../../infrastructure/repositories/SubscriptionRepository.h"
+#include <QDate>
+#include <QHash>
+#include <cstdint>
+#include <vector>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Infrastructure::Repositories;
+
+/**
+ * @brief Ingresos esperados por renovaciones en un día
+ */
+struct ForecastDay {
+  QDate date;
+  int expiring = 0;              ///< Suscripciones vigentes que vencen ese día
+  double expectedRenewals = 0.0; ///< Suma de probabilidades de renovación
+  int64_t projectedCents = 0;
+  int64_t cumulativeCents = 0; ///< Desde el primer día del pronóstico
+};
+
+/**
+ * @brief Probabilidad histórica de renovación de un plan
+ */
+struct PlanRenewalRate {
+  int64_t planId = 0;
+  int ended = 0;
+  int renewed = 0;
+  double probability = 0.0;
+};
+
+/**
+ * @brief Pronóstico diario desde `from` (incluido)
+ */
+struct RevenueForecast {
+  QDate from;
+  std::vector<ForecastDay> days; ///< days[k] corresponde a from + k
+  std::vector<PlanRenewalRate> rates;
+
+  /**
+   * @brief Ingresos esperados en los primeros `days` días
+   */
+  [[nodiscard]] int64_t projectedCents(int days) const;
+};
+
+/**
+ * @brief Pronóstico de ingresos por renovaciones
+ *
+ * Recorre una sola vez, en orden de fecha, las suscripciones vigentes que
+ * vencen dentro del horizonte (buckets de ExpiryIndex) y suma para cada día
+ * el precio actual del plan por la probabilidad histórica de renovación de
+ * ese plan. La probabilidad sale de SubscriptionRepository::
+ * renewalCountsByPlan() con suavizado de Laplace, (renovadas + 1) /
+ * (terminadas + 2), para que un plan sin historial no pronostique 0 ni el
+ * 100 %.
+ *
+ * El resultado se guarda hasta la próxima escritura (invalidate(), desde
+ * GymController::markDirty) o hasta que cambia la fecha de negocio.
+ * Solo se usa desde el hilo principal.
+ */
+class RenewalForecast {
+public:
+  static constexpr int kHorizonDays = 90;
+  /// Días después del vencimiento en que una suscripción nueva cuenta como
+  /// renovación
+  static constexpr int kGraceDays = 15;
+
+  /**
+   * @brief Pronóstico de los próximos kHorizonDays días (incluido hoy)
+   */
+  [[nodiscard]] const RevenueForecast &forecast();
+
+  /**
+   * @brief Descarta el pronóstico; se recalcula en la próxima consulta
+   */
+  void invalidate() { m_dirty = true; }
+
+private:
+  void rebuild(const QDate &today);
+
+  SubscriptionRepository m_repo;
+  RevenueForecast m_forecast;
+  bool m_dirty = true;
+};
+
+} // namespace GymOS::Core::Services
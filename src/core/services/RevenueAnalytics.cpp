@@ -0,0 +1,36 @@
+#include "RevenueAnalytics.h"
+#include "BusinessClock.h"
+#include <algorithm>
+
+namespace GymOS::Core::Services {
+
+QDate RevenueAnalytics::firstDayOfWindow(int months) {
+  const QDate start =
+      BusinessClock::instance().today().addMonths(-std::max(months, 1) + 1);
+  return QDate(start.year(), start.month(), 1);
+}
+
+std::vector<PlanRevenue> RevenueAnalytics::planRevenue(int months) const {
+  return m_repo.planRevenue(firstDayOfWindow(months),
+                            BusinessClock::instance().today());
+}
+
+std::vector<MemberValue> RevenueAnalytics::topMembers(int limit) const {
+  return m_repo.topMembers(limit);
+}
+
+std::optional<MemberValue>
+RevenueAnalytics::memberValue(int64_t memberId) const {
+  return m_repo.memberValue(memberId);
+}
+
+std::vector<PaymentCohort> RevenueAnalytics::cohorts(int months) const {
+  return m_repo.cohorts(firstDayOfWindow(months),
+                        BusinessClock::instance().today());
+}
+
+LifetimeValueSummary RevenueAnalytics::lifetimeSummary() const {
+  return m_repo.lifetimeSummary();
+}
+
+} // namespace GymOS::Core::Services
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../../infrastructure/repositories/RevenueRepository.h"
+#include "../models/Revenue.h"
+#include <optional>
+#include <vector>
+
+namespace GymOS::Core::Services {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Repositories;
+
+/**
+ * @brief Analítica de ingresos por plan y por miembro
+ *
+ * Los movimientos solo guardan una descripción de texto ("Nombre - Plan");
+ * el plan y el miembro salen del pago enlazado (payment_id → suscripción).
+ * Las consultas leen los agregados plan_revenue_monthly y member_revenue,
+ * que se actualizan con cada movimiento, así que su costo depende de la
+ * cantidad de planes, meses y miembros y no del tamaño del libro.
+ */
+class RevenueAnalytics {
+public:
+  /**
+   * @brief Ingresos por plan de los últimos `months` meses (incluido el
+   * actual)
+   */
+  [[nodiscard]] std::vector<PlanRevenue> planRevenue(int months) const;
+
+  /**
+   * @brief Miembros de mayor valor de vida (ingresos acumulados)
+   */
+  [[nodiscard]] std::vector<MemberValue> topMembers(int limit = 10) const;
+
+  [[nodiscard]] std::optional<MemberValue> memberValue(int64_t memberId) const;
+
+  /**
+   * @brief Retención y valor por cohorte (mes del primer pago) de los
+   * últimos `months` meses
+   */
+  [[nodiscard]] std::vector<PaymentCohort> cohorts(int months) const;
+
+  [[nodiscard]] LifetimeValueSummary lifetimeSummary() const;
+
+private:
+  /**
+   * @brief Primer día del mes que está `months - 1` meses antes del actual
+   */
+  [[nodiscard]] static QDate firstDayOfWindow(int months);
+
+  RevenueRepository m_repo;
+};
+
+} // namespace GymOS::Core::Services
@@ -1,6 +1,8 @@
 #include "SubscriptionManager.h"
+#include "CohortEngine.h"
 #include "../../infrastructure/database/DatabaseManager.h"
-#include "FinanceEngine.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+#include <stdexcept>
 
 namespace GymOS::Core::Services {
 
@@ -39,10 +41,11 @@ int64_t SubscriptionManager::createSubscription(int64_t memberId,
 
     int64_t subscriptionId = m_subscriptionRepo.insert(subscription);
 
-    // Registrar el ingreso en finanzas
-    FinanceEngine financeEngine;
-    financeEngine.recordEnrollmentIncome(
-        plan->price, member->fullName() + " - " + plan->name, startDate);
+    // Registrar los pagos (plan e inscripción) y sus ingresos
+    recordPayment(subscriptionId, PaymentType::Enrollment, plan->price,
+                  startDate, member->fullName() + " - " + plan->name);
+    recordPayment(subscriptionId, PaymentType::Additional, enrollmentFee,
+                  startDate, "Inscripción - " + member->fullName());
 
     emit subscriptionCreated(subscriptionId);
     return subscriptionId;
@@ -56,22 +59,23 @@ int64_t SubscriptionManager::createSubscription(int64_t memberId,
 int64_t SubscriptionManager::renewSubscription(int64_t memberId, int64_t planId,
                                                const QDate &startDate,
                                                double priceOverride) {
-  qDebug() << "[SubscriptionManager] renewSubscription called for member:"
-           << memberId;
+  GYM_TRACE(lcSubscriptions) << "renewSubscription called for member:"
+                             << memberId;
 
   // Obtener la suscripción actual
   auto currentSub = m_subscriptionRepo.findLatestByMember(memberId);
 
   // Calcular días restantes de la suscripción actual (si todavía está activa)
   int remainingDays = 0;
-  if (currentSub && currentSub->endDate() > QDate::currentDate()) {
-    remainingDays = QDate::currentDate().daysTo(currentSub->endDate());
-    qDebug() << "[SubscriptionManager] Current subscription has"
-             << remainingDays << "days remaining";
+  const QDate today = BusinessClock::instance().today();
+  if (currentSub && currentSub->endDate() > today) {
+    remainingDays = today.daysTo(currentSub->endDate());
+    GYM_TRACE(lcSubscriptions) << "Current subscription has" << remainingDays
+                               << "days remaining";
   }
 
   // La nueva suscripción SIEMPRE empieza HOY (o en la fecha especificada)
-  QDate newStartDate = startDate.isValid() ? startDate : QDate::currentDate();
+  QDate newStartDate = startDate.isValid() ? startDate : today;
 
   // Verificar que el plan existe
   auto plan = m_planRepo.findById(planId);
@@ -84,15 +88,19 @@ int64_t SubscriptionManager::renewSubscription(int64_t memberId, int64_t planId,
   // actual
   int totalDurationDays = plan->durationDays + remainingDays;
 
-  qDebug() << "[SubscriptionManager] Day accumulation:" << plan->durationDays
-           << "(plan) +" << remainingDays
-           << "(remaining) =" << totalDurationDays << "days";
-  qDebug() << "[SubscriptionManager] New subscription: Start:"
-           << newStartDate.toString("dd/MM/yyyy") << "End:"
-           << newStartDate.addDays(totalDurationDays).toString("dd/MM/yyyy");
+  GYM_TRACE(lcSubscriptions) << "Day accumulation:" << plan->durationDays
+                             << "(plan) +" << remainingDays
+                             << "(remaining) =" << totalDurationDays << "days";
+  GYM_TRACE(lcSubscriptions)
+      << "New subscription: Start:" << newStartDate.toString("dd/MM/yyyy")
+      << "End:"
+      << newStartDate.addDays(totalDurationDays).toString("dd/MM/yyyy");
 
   auto &db = DatabaseManager::instance();
-  db.beginTransaction();
+  if (!db.beginTransaction()) {
+    emit error("No se pudo iniciar la transacción");
+    return -1;
+  }
 
   try {
     // Crear nueva suscripción con duración acumulada
@@ -104,19 +112,36 @@ int64_t SubscriptionManager::renewSubscription(int64_t memberId, int64_t planId,
     subscription.planDurationDays = totalDurationDays; // ← Duración ACUMULADA
 
     int64_t subscriptionId = m_subscriptionRepo.insert(subscription);
+    if (subscriptionId <= 0) {
+      throw std::runtime_error("No se pudo crear la suscripción");
+    }
 
     // Registrar el ingreso
     double finalPrice = (priceOverride >= 0) ? priceOverride : plan->price;
 
     auto member = m_memberRepo.findById(memberId);
-    FinanceEngine financeEngine;
-    financeEngine.recordRenewalIncome(
-        finalPrice,
-        (member ? member->fullName() : "Miembro") + " - Renovación " +
-            plan->name,
-        newStartDate);
-
-    db.commitTransaction();
+    recordPayment(subscriptionId, PaymentType::Renewal, finalPrice,
+                  newStartDate,
+                  (member ? member->fullName() : "Miembro") +
+                      " - Renovación " + plan->name);
+
+    // Los avisos de la suscripción anterior ya no corresponden
+    if (!m_outboxRepo.dropSuperseded(memberId, subscriptionId)) {
+      throw std::runtime_error("No se pudieron cancelar los recordatorios");
+    }
+
+    if (!db.commitTransaction()) {
+      throw std::runtime_error("No se pudo confirmar la transacción");
+    }
+
+    // Los índices en memoria solo ven renovaciones confirmadas
+    subscription.id = subscriptionId;
+    subscription.memberName = member ? member->fullName() : QString();
+    subscription.planName = plan->name;
+    subscription.planPrice = plan->price;
+    ExpiryIndex::instance().update(subscription);
+    CohortEngine::instance().update(subscription);
+
     emit subscriptionRenewed(subscriptionId);
     return subscriptionId;
 
@@ -127,40 +152,161 @@ int64_t SubscriptionManager::renewSubscription(int64_t memberId, int64_t planId,
   }
 }
 
-std::vector<Subscription> SubscriptionManager::getExpiringSoon(int days) {
-  auto expiring = m_subscriptionRepo.findExpiringSoon(days);
-  std::vector<Subscription> filtered;
+std::vector<SubscriptionManager::Renewal>
+SubscriptionManager::renewMany(const std::vector<int64_t> &memberIds,
+                               int64_t planId, double priceOverride) {
+  GYM_TRACE(lcSubscriptions) << "renewMany called for" << memberIds.size()
+                             << "members";
+  if (memberIds.empty()) {
+    return {};
+  }
 
-  for (const auto &sub : expiring) {
-    auto latest = m_subscriptionRepo.findLatestByMember(sub.memberId);
-    // Si existe una suscripción posterior (ej: renovada), ignoramos la que
-    // vence
-    if (latest && latest->endDate() > sub.endDate()) {
-      continue;
+  auto plan = m_planRepo.findById(planId);
+  if (!plan || !plan->isActive) {
+    emit error("El plan no existe o no está activo");
+    return {};
+  }
+
+  // Prefetch: últimas suscripciones y nombres en consultas por conjuntos
+  QHash<int64_t, Subscription> latestByMember;
+  for (auto &sub : m_subscriptionRepo.findLatestByMembers(memberIds)) {
+    latestByMember.insert(sub.memberId, std::move(sub));
+  }
+
+  QHash<int64_t, QString> names;
+  for (const auto &member : m_memberRepo.findByIds(memberIds)) {
+    names.insert(member.id, member.fullName());
+  }
+
+  const QDate today = BusinessClock::instance().today();
+  const double finalPrice = (priceOverride >= 0) ? priceOverride : plan->price;
+
+  auto &db = DatabaseManager::instance();
+  if (!db.beginTransaction()) {
+    emit error("No se pudo iniciar la transacción");
+    return {};
+  }
+
+  std::vector<Renewal> renewals;
+  renewals.reserve(memberIds.size());
+  std::vector<Subscription> created;
+  created.reserve(memberIds.size());
+  QSet<int64_t> renewed;
+
+  try {
+    for (int64_t memberId : memberIds) {
+      if (renewed.contains(memberId)) {
+        continue; // IDs repetidos en la selección
+      }
+      renewed.insert(memberId);
+
+      auto name = names.constFind(memberId);
+      if (name == names.constEnd()) {
+        qCWarning(lcSubscriptions) << "renewMany: miembro inexistente"
+                                   << memberId;
+        continue;
+      }
+
+      int remainingDays = 0;
+      auto current = latestByMember.constFind(memberId);
+      if (current != latestByMember.constEnd() &&
+          current->endDate() > today) {
+        remainingDays = today.daysTo(current->endDate());
+      }
+
+      Subscription subscription;
+      subscription.memberId = memberId;
+      subscription.planId = planId;
+      subscription.startDate = today;
+      subscription.enrollmentFee = 0;
+      subscription.planDurationDays = plan->durationDays + remainingDays;
+
+      const int64_t subscriptionId = m_subscriptionRepo.insert(subscription);
+      if (subscriptionId <= 0) {
+        throw std::runtime_error("No se pudo crear la suscripción");
+      }
+
+      recordPayment(subscriptionId, PaymentType::Renewal, finalPrice, today,
+                    name.value() + " - Renovación " + plan->name);
+      if (!m_outboxRepo.dropSuperseded(memberId, subscriptionId)) {
+        throw std::runtime_error("No se pudieron cancelar los recordatorios");
+      }
+
+      renewals.push_back(
+          {memberId, subscriptionId, name.value(), subscription.endDate()});
+
+      subscription.id = subscriptionId;
+      subscription.memberName = name.value();
+      subscription.planName = plan->name;
+      subscription.planPrice = plan->price;
+      created.push_back(std::move(subscription));
     }
-    filtered.push_back(sub);
+
+    if (!db.commitTransaction()) {
+      throw std::runtime_error("No se pudo confirmar la transacción");
+    }
+  } catch (const std::exception &e) {
+    db.rollbackTransaction();
+    emit error(QString("Error al renovar suscripciones: %1").arg(e.what()));
+    return {};
   }
-  return filtered;
+
+  auto &index = ExpiryIndex::instance();
+  auto &cohorts = CohortEngine::instance();
+  for (const auto &subscription : created) {
+    index.update(subscription);
+    cohorts.update(subscription);
+  }
+
+  qCInfo(lcSubscriptions) << "Renovadas" << renewals.size()
+                          << "suscripciones al plan" << plan->name;
+  emit subscriptionsRenewed(static_cast<int>(renewals.size()));
+  return renewals;
 }
 
-std::vector<Subscription> SubscriptionManager::getExpired() {
-  auto expired = m_subscriptionRepo.findByStatus(SubscriptionStatus::Expired);
-  std::vector<Subscription> filtered;
+void SubscriptionManager::recordPayment(int64_t subscriptionId,
+                                        PaymentType type, double amount,
+                                        const QDate &date,
+                                        const QString &description) {
+  if (amount <= 0) {
+    return;
+  }
 
-  for (const auto &sub : expired) {
-    auto latest = m_subscriptionRepo.findLatestByMember(sub.memberId);
-    // Si el miembro tiene una suscripción más reciente (activa o futura),
-    // ignoramos la expirada
-    if (latest && latest->endDate() > sub.endDate()) {
-      continue;
-    }
-    filtered.push_back(sub);
+  Payment payment;
+  payment.subscriptionId = subscriptionId;
+  payment.amount = amount;
+  payment.paymentDate = date;
+  payment.paymentType = type;
+
+  payment.id = m_paymentRepo.insert(payment);
+  if (payment.id <= 0) {
+    throw std::runtime_error("No se pudo registrar el pago");
   }
-  return filtered;
+
+  if (m_financeEngine.recordPaymentIncome(payment, description) <= 0) {
+    throw std::runtime_error("No se pudo registrar el ingreso del pago");
+  }
+}
+
+std::vector<Subscription> SubscriptionManager::getExpiringSoon(int days) {
+  // Solo la suscripción vigente de cada miembro: una renovada no aparece
+  const QDate today = BusinessClock::instance().today();
+  return ExpiryIndex::instance().expiringBetween(today, today.addDays(days));
+}
+
+std::vector<Subscription> SubscriptionManager::getExpired() {
+  return ExpiryIndex::instance().expiredBefore(
+      BusinessClock::instance().today());
+}
+
+std::vector<Subscription> SubscriptionManager::getRecentlyExpired(int days) {
+  const QDate today = BusinessClock::instance().today();
+  return ExpiryIndex::instance().expiredBefore(today, today.addDays(-days));
 }
 
 std::vector<Subscription> SubscriptionManager::getActive() {
-  return m_subscriptionRepo.findByStatus(SubscriptionStatus::Active);
+  return m_subscriptionRepo.findByStatus(SubscriptionStatus::Active,
+                                         BusinessClock::instance().today());
 }
 
 std::vector<Subscription> SubscriptionManager::getAll() {
@@ -182,10 +328,21 @@ std::vector<Subscription> SubscriptionManager::getAll() {
 }
 
 SubscriptionManager::Stats SubscriptionManager::getStats() {
+  return statsFrom(
+      m_subscriptionRepo.countByExpiry(BusinessClock::instance().today()));
+}
+
+SubscriptionManager::Stats SubscriptionManager::computeStats(
+    const QSqlDatabase &db, const QDate &today) {
+  return statsFrom(SubscriptionRepository::countByExpiry(db, today));
+}
+
+SubscriptionManager::Stats SubscriptionManager::statsFrom(
+    const SubscriptionRepository::ExpiryCounts &counts) {
   Stats stats;
-  stats.activeCount = m_subscriptionRepo.countActive();
-  stats.expiringCount = m_subscriptionRepo.countExpiringSoon(7);
-  stats.expiredCount = m_subscriptionRepo.countExpired();
+  stats.activeCount = counts.active;
+  stats.expiringCount = counts.expiring;
+  stats.expiredCount = counts.expired;
   return stats;
 }
 
@@ -2,11 +2,19 @@
 
 #include "../../infrastructure/repositories/FinancialEntryRepository.h"
 #include "../../infrastructure/repositories/MemberRepository.h"
+#include "../../infrastructure/repositories/OutboxRepository.h"
+#include "../../infrastructure/repositories/PaymentRepository.h"
 #include "../../infrastructure/repositories/PlanRepository.h"
 #include "../../infrastructure/repositories/SubscriptionRepository.h"
 #include "../models/FinancialEntry.h"
+#include "../models/Payment.h"
 #include "../models/Subscription.h"
+#include "BusinessClock.h"
+#include "ExpiryIndex.h"
+#include "FinanceEngine.h"
 #include <QDate>
+#include <QHash>
+#include <QSet>
 #include <QObject>
 #include <memory>
 
@@ -31,6 +39,12 @@ public:
 
   /**
    * @brief Crea una nueva suscripción con pago inicial
+   *
+   * Registra el pago del plan y, si corresponde, el de la inscripción,
+   * cada uno con su entrada financiera enlazada. La transacción la abre el
+   * llamador; ante un error lanza una excepción para que haga rollback.
+   * Después de confirmar, el llamador actualiza ExpiryIndex con
+   * refreshMember().
    * @param memberId ID del miembro
    * @param planId ID del plan
    * @param startDate Fecha de inicio
@@ -52,8 +66,33 @@ public:
                             const QDate &startDate = QDate(),
                             double priceOverride = -1.0);
 
+  /**
+   * @brief Resultado de una renovación dentro de renewMany()
+   */
+  struct Renewal {
+    int64_t memberId;
+    int64_t subscriptionId;
+    QString memberName;
+    QDate endDate;
+  };
+
+  /**
+   * @brief Renueva varias suscripciones al mismo plan
+   *
+   * Aplica la misma regla que renewSubscription() (los días restantes se
+   * acumulan) pero con el plan y las últimas suscripciones leídos en
+   * consultas por conjuntos, todas las escrituras en una transacción y una
+   * sola señal subscriptionsRenewed al final.
+   * @return Renovaciones realizadas; vacío si falló (se hace rollback)
+   */
+  std::vector<Renewal> renewMany(const std::vector<int64_t> &memberIds,
+                                 int64_t planId, double priceOverride = -1.0);
+
   /**
    * @brief Obtiene suscripciones que vencen pronto
+   *
+   * Este método y los de vencidas leen ExpiryIndex (sin consultar la base
+   * salvo en la carga inicial del índice).
    */
   std::vector<Subscription> getExpiringSoon(int days = 7);
 
@@ -62,6 +101,11 @@ public:
    */
   std::vector<Subscription> getExpired();
 
+  /**
+   * @brief Obtiene suscripciones que vencieron en los últimos N días
+   */
+  std::vector<Subscription> getRecentlyExpired(int days);
+
   /**
    * @brief Obtiene suscripciones activas
    */
@@ -82,15 +126,38 @@ public:
   };
   Stats getStats();
 
+  /**
+   * @brief Calcula las estadísticas sobre una conexión explícita
+   *
+   * Para recalcular los conteos en un hilo de trabajo (p. ej. al cambiar
+   * el día) sin usar la conexión del hilo principal.
+   */
+  static Stats computeStats(const QSqlDatabase &db, const QDate &today);
+
 signals:
   void subscriptionCreated(int64_t subscriptionId);
   void subscriptionRenewed(int64_t subscriptionId);
+  void subscriptionsRenewed(int count);
   void error(const QString &message);
 
 private:
+  static Stats statsFrom(const SubscriptionRepository::ExpiryCounts &counts);
+
+  /**
+   * @brief Inserta un pago y su entrada financiera enlazada
+   *
+   * Los montos no positivos no generan pago (p. ej. renovación bonificada).
+   * @throws std::runtime_error si alguna inserción falla
+   */
+  void recordPayment(int64_t subscriptionId, PaymentType type, double amount,
+                     const QDate &date, const QString &description);
+
   SubscriptionRepository m_subscriptionRepo;
+  PaymentRepository m_paymentRepo;
+  FinanceEngine m_financeEngine;
   PlanRepository m_planRepo;
   MemberRepository m_memberRepo;
+  OutboxRepository m_outboxRepo;
 };
 
 } // namespace GymOS::Core::Services
@@ -1,7 +1,11 @@
 #include "DatabaseManager.h"
+#include "../diagnostics/Logging.h"
+#include "../diagnostics/Tracer.h"
+#include "Migrations.h"
 #include <QCoreApplication>
 #include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QStandardPaths>
 
 namespace GymOS::Infrastructure::Database {
@@ -14,6 +18,8 @@ DatabaseManager &DatabaseManager::instance() {
 DatabaseManager::DatabaseManager() : QObject(nullptr) {}
 
 DatabaseManager::~DatabaseManager() {
+  // Las sentencias en caché deben liberarse antes de cerrar la conexión
+  m_preparedCache.clear();
   if (m_database.isOpen()) {
     m_database.close();
   }
@@ -39,25 +45,22 @@ bool DatabaseManager::initialize(const QString &dbPath) {
   m_database.setDatabaseName(fullPath);
 
   if (!m_database.open()) {
-    qCritical() << "Error al abrir la base de datos:"
-                << m_database.lastError().text();
+    qCCritical(lcDatabase) << "Error al abrir la base de datos:"
+                           << m_database.lastError().text();
     emit databaseError(m_database.lastError().text());
     return false;
   }
 
-  qInfo() << "Base de datos abierta en:" << fullPath;
+  qCInfo(lcDatabase) << "Base de datos abierta en:" << fullPath;
 
   // Habilitar foreign keys
   executeQuery("PRAGMA foreign_keys = ON");
 
-  // Crear tablas
-  if (!createTables()) {
-    return false;
-  }
-
-  // Ejecutar migraciones
-  if (!runMigrations()) {
-    return false;
+  {
+    GYM_TRACE_SCOPE("startup", "runMigrations");
+    if (!runMigrations()) {
+      return false;
+    }
   }
 
   m_initialized = true;
@@ -69,11 +72,40 @@ bool DatabaseManager::isConnected() const { return m_database.isOpen(); }
 
 QSqlDatabase &DatabaseManager::database() { return m_database; }
 
+QSqlDatabase DatabaseManager::openWorkerConnection(const QString &name,
+                                                   bool readOnly) {
+  // cloneDatabase() por nombre es seguro desde otro hilo
+  QSqlDatabase db =
+      QSqlDatabase::cloneDatabase(m_database.connectionName(), name);
+  db.setConnectOptions(readOnly
+                           ? "QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=5000"
+                           : "QSQLITE_BUSY_TIMEOUT=5000");
+  if (!db.open()) {
+    qCWarning(lcDatabase) << "No se pudo abrir la conexión" << name << ":"
+                          << db.lastError().text();
+    return db;
+  }
+  if (!readOnly) {
+    QSqlQuery(db).exec("PRAGMA foreign_keys = ON");
+  }
+  return db;
+}
+
+void DatabaseManager::closeWorkerConnection(const QString &name) {
+  {
+    QSqlDatabase db = QSqlDatabase::database(name, false);
+    db.close();
+  }
+  QSqlDatabase::removeDatabase(name);
+}
+
 QSqlQuery DatabaseManager::executeQuery(const QString &sql) {
+  GYM_TRACE_SCOPE("sql", sql);
   QSqlQuery query(m_database);
   if (!query.exec(sql)) {
-    qWarning() << "Error en consulta SQL:" << query.lastError().text();
-    qWarning() << "SQL:" << sql;
+    qCWarning(lcDatabase) << "Error en consulta SQL:"
+                          << query.lastError().text();
+    qCWarning(lcDatabase) << "SQL:" << sql;
     emit databaseError(query.lastError().text());
   }
   return query;
@@ -81,6 +113,7 @@ QSqlQuery DatabaseManager::executeQuery(const QString &sql) {
 
 QSqlQuery DatabaseManager::executeQuery(const QString &sql,
                                         const QVariantList &params) {
+  GYM_TRACE_SCOPE("sql", sql);
   QSqlQuery query(m_database);
   query.prepare(sql);
 
@@ -89,285 +122,119 @@ QSqlQuery DatabaseManager::executeQuery(const QString &sql,
   }
 
   if (!query.exec()) {
-    qWarning() << "Error en consulta SQL:" << query.lastError().text();
-    qWarning() << "SQL:" << sql;
+    qCWarning(lcDatabase) << "Error en consulta SQL:"
+                          << query.lastError().text();
+    qCWarning(lcDatabase) << "SQL:" << sql;
     emit databaseError(query.lastError().text());
   }
   return query;
 }
 
-bool DatabaseManager::beginTransaction() { return m_database.transaction(); }
-
-bool DatabaseManager::commitTransaction() { return m_database.commit(); }
-
-bool DatabaseManager::rollbackTransaction() { return m_database.rollback(); }
-
-bool DatabaseManager::createTables() {
-  // Tabla de miembros
-  QString createMembers = R"(
-        CREATE TABLE IF NOT EXISTS members (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            first_name TEXT NOT NULL,
-            last_name TEXT NOT NULL,
-            email TEXT UNIQUE,
-            phone TEXT,
-            social_media TEXT,
-            health_notes TEXT,
-            weight_kg REAL,
-            height_cm REAL,
-            observations TEXT,
-            created_at TEXT NOT NULL DEFAULT (datetime('now')),
-            updated_at TEXT NOT NULL DEFAULT (datetime('now'))
-        )
-    )";
-
-  // Tabla de planes
-  QString createPlans = R"(
-        CREATE TABLE IF NOT EXISTS plans (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            name TEXT NOT NULL UNIQUE,
-            duration_days INTEGER NOT NULL CHECK (duration_days > 0),
-            price REAL NOT NULL CHECK (price >= 0),
-            is_active INTEGER NOT NULL DEFAULT 1,
-            created_at TEXT NOT NULL DEFAULT (datetime('now')),
-            updated_at TEXT NOT NULL DEFAULT (datetime('now'))
-        )
-    )";
-
-  // Tabla de configuraciones globales
-  QString createSettings = R"(
-        CREATE TABLE IF NOT EXISTS settings (
-            key TEXT PRIMARY KEY,
-            value TEXT,
-            updated_at TEXT NOT NULL DEFAULT (datetime('now'))
-        )
-    )";
-
-  // Tabla de suscripciones
-  QString createSubscriptions = R"(
-        CREATE TABLE IF NOT EXISTS subscriptions (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            member_id INTEGER NOT NULL,
-            plan_id INTEGER NOT NULL,
-            start_date TEXT NOT NULL,
-            plan_duration_days INTEGER,
-            enrollment_fee REAL NOT NULL DEFAULT 0,
-            created_at TEXT NOT NULL DEFAULT (datetime('now')),
-            FOREIGN KEY (member_id) REFERENCES members(id) ON DELETE RESTRICT,
-            FOREIGN KEY (plan_id) REFERENCES plans(id) ON DELETE RESTRICT
-        )
-    )";
-
-  // Tabla de pagos (INMUTABLE)
-  QString createPayments = R"(
-        CREATE TABLE IF NOT EXISTS payments (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            subscription_id INTEGER NOT NULL,
-            amount REAL NOT NULL CHECK (amount > 0),
-            payment_date TEXT NOT NULL,
-            payment_type TEXT NOT NULL CHECK (payment_type IN ('enrollment', 'renewal', 'additional')),
-            notes TEXT,
-            created_at TEXT NOT NULL DEFAULT (datetime('now')),
-            FOREIGN KEY (subscription_id) REFERENCES subscriptions(id) ON DELETE RESTRICT
-        )
-    )";
-
-  // Tabla de entradas financieras (INMUTABLE - Event Sourcing Lite)
-  QString createFinancialEntries = R"(
-        CREATE TABLE IF NOT EXISTS financial_entries (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            entry_type TEXT NOT NULL CHECK (
-                entry_type IN ('enrollment_income', 'renewal_income', 'custom_income', 'custom_expense')
-            ),
-            classification TEXT NOT NULL CHECK (classification IN ('income', 'expense')),
-            amount REAL NOT NULL CHECK (amount > 0),
-            description TEXT NOT NULL,
-            payment_id INTEGER,
-            entry_date TEXT NOT NULL,
-            created_at TEXT NOT NULL DEFAULT (datetime('now')),
-            FOREIGN KEY (payment_id) REFERENCES payments(id) ON DELETE RESTRICT
-        )
-    )";
-
-  // Vista de suscripciones con fecha de vencimiento calculada
-  // COALESCE usa la duración personalizada de la suscripción si existe,
-  // sino usa la duración del plan original
-  QString createSubscriptionsView = R"(
-        CREATE VIEW IF NOT EXISTS v_subscriptions_with_expiry AS
-        SELECT 
-            s.id,
-            s.member_id,
-            s.plan_id,
-            s.start_date,
-            s.plan_duration_days,
-            date(s.start_date, '+' || COALESCE(s.plan_duration_days, p.duration_days) || ' days') AS end_date,
-            s.enrollment_fee,
-            m.first_name || ' ' || m.last_name AS member_name,
-            p.name AS plan_name,
-            COALESCE(s.plan_duration_days, p.duration_days) AS duration_days,
-            p.price AS plan_price,
-            CASE 
-                WHEN date(s.start_date, '+' || COALESCE(s.plan_duration_days, p.duration_days) || ' days') < date('now') THEN 'expired'
-                WHEN date(s.start_date, '+' || COALESCE(s.plan_duration_days, p.duration_days) || ' days') <= date('now', '+7 days') THEN 'expiring'
-                ELSE 'active'
-            END AS status,
-            CAST(julianday(date(s.start_date, '+' || COALESCE(s.plan_duration_days, p.duration_days) || ' days')) - julianday(date('now')) AS INTEGER) AS days_until_expiry
-        FROM subscriptions s
-        JOIN plans p ON s.plan_id = p.id
-        JOIN members m ON s.member_id = m.id
-    )";
-
-  // Ejecutar todas las creaciones
-  QStringList queries = {createMembers,  createPlans,
-                         createSettings, createSubscriptions,
-                         createPayments, createFinancialEntries};
-
-  for (const QString &sql : queries) {
-    QSqlQuery query = executeQuery(sql);
-    if (query.lastError().isValid()) {
-      qCritical() << "Error creando tabla:" << query.lastError().text();
-      return false;
+PreparedQuery DatabaseManager::executePrepared(const QString &sql,
+                                              const QVariantList &params) {
+  GYM_TRACE_SCOPE("sql", sql);
+  auto it = m_preparedCache.find(sql);
+  if (it == m_preparedCache.end()) {
+    QSqlQuery query(m_database);
+    if (!query.prepare(sql)) {
+      qCWarning(lcDatabase) << "Error preparando consulta SQL:"
+                            << query.lastError().text();
+      qCWarning(lcDatabase) << "SQL:" << sql;
+      emit databaseError(query.lastError().text());
+      return PreparedQuery(query);
     }
+    it = m_preparedCache.insert(sql, query);
   }
 
-  // Inicializar configuraciones por defecto
-  QSqlQuery checkSettings = executeQuery("SELECT count(*) FROM settings");
-  if (checkSettings.next() && checkSettings.value(0).toInt() == 0) {
-    executeQuery(
-        "INSERT INTO settings (key, value) VALUES ('enrollment_fee', '0.0')");
-  }
-
-  // Crear vista (DROP primero para actualizarla)
-  executeQuery("DROP VIEW IF EXISTS v_subscriptions_with_expiry");
-  QSqlQuery viewQuery = executeQuery(createSubscriptionsView);
-  if (viewQuery.lastError().isValid()) {
-    qCritical() << "Error creando vista:" << viewQuery.lastError().text();
-    return false;
+  QSqlQuery &query = it.value();
+  for (int i = 0; i < params.size(); ++i) {
+    query.bindValue(i, params[i]);
   }
 
-  // Crear índices
-  QStringList indexes = {
-      "CREATE INDEX IF NOT EXISTS idx_members_name ON members(last_name, "
-      "first_name)",
-      "CREATE INDEX IF NOT EXISTS idx_members_email ON members(email)",
-      "CREATE INDEX IF NOT EXISTS idx_plans_active ON plans(is_active)",
-      "CREATE INDEX IF NOT EXISTS idx_subscriptions_member ON "
-      "subscriptions(member_id)",
-      "CREATE INDEX IF NOT EXISTS idx_subscriptions_start ON "
-      "subscriptions(start_date)",
-      "CREATE INDEX IF NOT EXISTS idx_payments_subscription ON "
-      "payments(subscription_id)",
-      "CREATE INDEX IF NOT EXISTS idx_payments_date ON payments(payment_date)",
-      "CREATE INDEX IF NOT EXISTS idx_payments_type ON payments(payment_type)",
-      "CREATE INDEX IF NOT EXISTS idx_financial_entries_date ON "
-      "financial_entries(entry_date)",
-      "CREATE INDEX IF NOT EXISTS idx_financial_entries_type ON "
-      "financial_entries(entry_type)",
-      "CREATE INDEX IF NOT EXISTS idx_financial_entries_classification ON "
-      "financial_entries(classification)"};
-
-  for (const QString &sql : indexes) {
-    executeQuery(sql);
+  if (!query.exec()) {
+    qCWarning(lcDatabase) << "Error en consulta SQL:"
+                          << query.lastError().text();
+    qCWarning(lcDatabase) << "SQL:" << sql;
+    emit databaseError(query.lastError().text());
   }
-
-  qInfo() << "Tablas e índices creados correctamente";
-  return true;
+  return PreparedQuery(query);
 }
 
-bool DatabaseManager::createMigrationsTable() {
-  QString sql = R"(
-        CREATE TABLE IF NOT EXISTS _migrations (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            name TEXT NOT NULL UNIQUE,
-            applied_at TEXT NOT NULL DEFAULT (datetime('now'))
-        )
-    )";
+bool DatabaseManager::beginTransaction() { return m_database.transaction(); }
 
-  QSqlQuery query = executeQuery(sql);
-  return !query.lastError().isValid();
-}
+bool DatabaseManager::commitTransaction() { return m_database.commit(); }
 
-bool DatabaseManager::isMigrationApplied(const QString &migrationName) {
-  QSqlQuery query = executeQuery(
-      "SELECT COUNT(*) FROM _migrations WHERE name = ?", {migrationName});
+bool DatabaseManager::rollbackTransaction() { return m_database.rollback(); }
 
+int DatabaseManager::schemaVersion() {
+  QSqlQuery query = executeQuery("PRAGMA user_version");
   if (query.next()) {
-    return query.value(0).toInt() > 0;
+    return query.value(0).toInt();
   }
-  return false;
+  return 0;
 }
 
-bool DatabaseManager::recordMigration(const QString &migrationName) {
-  QSqlQuery query = executeQuery("INSERT INTO _migrations (name) VALUES (?)",
-                                 {migrationName});
+bool DatabaseManager::setSchemaVersion(int version) {
+  // PRAGMA no admite parámetros enlazados
+  QSqlQuery query =
+      executeQuery(QString("PRAGMA user_version = %1").arg(version));
   return !query.lastError().isValid();
 }
 
 bool DatabaseManager::runMigrations() {
-  if (!createMigrationsTable()) {
-    return false;
+  const int currentVersion = schemaVersion();
+  const int latestVersion = latestSchemaVersion();
+
+  // Con el esquema al día no se ejecuta DDL en el arranque
+  if (currentVersion >= latestVersion) {
+    qCInfo(lcDatabase) << "Esquema al día (versión" << currentVersion << ")";
+    return true;
   }
 
-  // Lista de migraciones (en orden)
-  QStringList migrations = {"001_convert_months_to_days"};
-
-  for (const QString &migration : migrations) {
-    if (!isMigrationApplied(migration)) {
-      qInfo() << "Aplicando migración:" << migration;
-
-      bool success = true;
-      if (migration == "001_convert_months_to_days") {
-        // Verificar si la columna duration_months existe usando PRAGMA
-        QSqlQuery pragma = executeQuery("PRAGMA table_info(plans)");
-        bool hasDurationMonths = false;
-        while (pragma.next()) {
-          if (pragma.value("name").toString() == "duration_months") {
-            hasDurationMonths = true;
-            break;
-          }
-        }
-
-        if (hasDurationMonths) {
-          // La columna existe, necesitamos migrar
-          beginTransaction();
-
-          // Verificar si ya existe duration_days para no fallar
-          bool hasDurationDays = false;
-          pragma.first(); // Rewind if possible or re-query. PRAGMA is small,
-                          // re-querying is safer/easier code wise but let's
-                          // just check the log.
-          // SQLite PRAGMA results are forward only usually. Let's re-run or
-          // just proceed with ALTER which ignores if exists? No, ALTER TABLE
-          // ADD COLUMN fails if exists.
-
-          // Let's rely on hasDurationMonths. If checking column existed, we
-          // assume we need to migrate. But we must check if duration_days
-          // exists to avoid error on ADD COLUMN. Let's just catch the error of
-          // ADD COLUMN gracefully or check both.
-
-          QSqlQuery addCol = executeQuery(
-              "ALTER TABLE plans ADD COLUMN duration_days INTEGER DEFAULT 0");
-          // If it fails, maybe it exists. We proceed to update.
-
-          executeQuery("UPDATE plans SET duration_days = duration_months * 30");
-          commitTransaction();
-          qInfo() << "Migración 001 completada: Meses convertidos a días";
-        } else {
-          qInfo() << "La columna duration_months no existe o es una "
-                     "instalación nueva.";
-        }
-      }
-
-      if (success && !recordMigration(migration)) {
-        qCritical() << "Error registrando migración:" << migration;
-        return false;
-      }
-
-      emit migrationCompleted(migration);
+  qCInfo(lcDatabase) << "Actualizando esquema de la versión" << currentVersion
+                     << "a la" << latestVersion;
+
+  for (const Migration &migration : migrations()) {
+    if (migration.version <= currentVersion) {
+      continue;
+    }
+
+    const QString name = QString("%1_%2")
+                             .arg(migration.version, 3, 10, QChar('0'))
+                             .arg(QLatin1String(migration.name));
+    GYM_TRACE_SCOPE("migration", migration.name);
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!beginTransaction()) {
+      qCCritical(lcDatabase) << "No se pudo iniciar la transacción para"
+                             << name << ":" << m_database.lastError().text();
+      return false;
     }
+
+    // user_version se guarda dentro de la misma transacción: una migración
+    // queda aplicada por completo o no queda aplicada
+    MigrationContext context(*this, name);
+    if (!migration.apply(context) || !setSchemaVersion(migration.version) ||
+        !commitTransaction()) {
+      qCCritical(lcDatabase) << "Error aplicando migración" << name << ":"
+                             << m_database.lastError().text();
+      rollbackTransaction();
+      emit databaseError(QString("Migración %1 fallida").arg(name));
+      return false;
+    }
+
+    qCInfo(lcDatabase) << "Migración" << name << "aplicada en"
+                       << timer.elapsed() << "ms";
+    emit migrationCompleted(name);
   }
 
   return true;
 }
 
+int DatabaseManager::latestSchemaVersion() {
+  const auto &list = migrations();
+  return list.empty() ? 0 : list.back().version;
+}
+
 } // namespace GymOS::Infrastructure::Database
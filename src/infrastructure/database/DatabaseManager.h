@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QObject>
 #include <QSqlDatabase>
 #include <QSqlQuery>
@@ -12,6 +13,33 @@
 
 namespace GymOS::Infrastructure::Database {
 
+/**
+ * @brief Resultado de una sentencia de la caché de executePrepared()
+ *
+ * Comparte el statement con la caché y lo reinicia (finish()) al salir de
+ * alcance: un SELECT del que solo se leyó una fila no queda abierto
+ * reteniendo el lock SHARED de la conexión principal. No se copia ni se
+ * convierte a QSqlQuery, para que el reinicio no ocurra antes de leer;
+ * query() da acceso al QSqlQuery para funciones que mapean filas.
+ */
+class PreparedQuery : private QSqlQuery {
+public:
+    explicit PreparedQuery(const QSqlQuery& query) : QSqlQuery(query) {}
+    ~PreparedQuery() { finish(); }
+    
+    PreparedQuery(const PreparedQuery&) = delete;
+    PreparedQuery& operator=(const PreparedQuery&) = delete;
+    
+    using QSqlQuery::isActive;
+    using QSqlQuery::lastError;
+    using QSqlQuery::lastInsertId;
+    using QSqlQuery::next;
+    using QSqlQuery::numRowsAffected;
+    using QSqlQuery::value;
+    
+    QSqlQuery& query() { return *this; }
+};
+
 /**
  * @brief Gestor de base de datos SQLite
  * 
@@ -44,6 +72,24 @@ public:
      */
     QSqlDatabase& database();
     
+    /**
+     * @brief Abre una conexión para el hilo actual
+     *
+     * Las conexiones de Qt SQL no pueden usarse fuera del hilo que las
+     * creó; los cálculos en segundo plano abren la suya con este método
+     * (misma base, con busy timeout) y la cierran con
+     * closeWorkerConnection() desde el mismo hilo.
+     * @param name Nombre único de la conexión
+     * @param readOnly false para trabajos que escriben (p. ej. el outbox)
+     */
+    QSqlDatabase openWorkerConnection(const QString& name,
+                                      bool readOnly = true);
+    
+    /**
+     * @brief Cierra una conexión abierta con openWorkerConnection()
+     */
+    static void closeWorkerConnection(const QString& name);
+    
     /**
      * @brief Ejecuta una consulta SQL
      * @param sql Consulta SQL
@@ -59,12 +105,36 @@ public:
      */
     QSqlQuery executeQuery(const QString& sql, const QVariantList& params);
     
+    /**
+     * @brief Ejecuta una sentencia preparada reutilizable
+     *
+     * La sentencia se prepara una sola vez por texto SQL y se guarda en
+     * caché; las llamadas siguientes solo enlazan parámetros. Pensado para
+     * escrituras frecuentes (INSERT de pagos y movimientos) y lecturas
+     * repetidas. El resultado se comparte con la caché: leerlo antes de
+     * volver a ejecutar el mismo SQL. El statement se reinicia cuando el
+     * PreparedQuery devuelto sale de alcance.
+     * @param sql Consulta SQL con placeholders
+     * @param params Lista de parámetros
+     * @return PreparedQuery con el resultado
+     */
+    PreparedQuery executePrepared(const QString& sql,
+                                  const QVariantList& params);
+    
     /**
      * @brief Ejecuta las migraciones pendientes
+     *
+     * Compara PRAGMA user_version con la última migración registrada en
+     * migrations() y aplica las que faltan, cada una en su transacción.
      * @return true si todas las migraciones fueron exitosas
      */
     bool runMigrations();
     
+    /**
+     * @brief Versión del esquema esperada por esta build
+     */
+    static int latestSchemaVersion();
+    
     /**
      * @brief Inicia una transacción
      */
@@ -83,6 +153,8 @@ public:
 signals:
     void databaseInitialized();
     void migrationCompleted(const QString& migrationName);
+    void migrationProgress(const QString& migrationName, qint64 done,
+                           qint64 total);
     void databaseError(const QString& error);
     
 private:
@@ -94,26 +166,17 @@ private:
     DatabaseManager& operator=(const DatabaseManager&) = delete;
     
     /**
-     * @brief Crea las tablas de la base de datos
-     */
-    bool createTables();
-    
-    /**
-     * @brief Crea la tabla de migraciones si no existe
-     */
-    bool createMigrationsTable();
-    
-    /**
-     * @brief Verifica si una migración ya fue aplicada
+     * @brief Lee la versión del esquema (PRAGMA user_version)
      */
-    bool isMigrationApplied(const QString& migrationName);
+    int schemaVersion();
     
     /**
-     * @brief Registra una migración como aplicada
+     * @brief Guarda la versión del esquema (PRAGMA user_version)
      */
-    bool recordMigration(const QString& migrationName);
+    bool setSchemaVersion(int version);
     
     QSqlDatabase m_database;
+    QHash<QString, QSqlQuery> m_preparedCache;
     bool m_initialized = false;
 };
 
@@ -0,0 +1,614 @@
+#include "Migrations.h"
+#include "../diagnostics/Logging.h"
+#include "DatabaseManager.h"
+#include <QSqlError>
+#include <QSqlQuery>
+
+namespace GymOS::Infrastructure::Database {
+
+MigrationContext::MigrationContext(DatabaseManager &db, const QString &name)
+    : m_db(db), m_name(name) {}
+
+QSqlQuery MigrationContext::query(const QString &sql,
+                                  const QVariantList &params) {
+  return params.isEmpty() ? m_db.executeQuery(sql)
+                          : m_db.executeQuery(sql, params);
+}
+
+bool MigrationContext::exec(const QString &sql, const QVariantList &params) {
+  return !query(sql, params).lastError().isValid();
+}
+
+bool MigrationContext::execAll(const QStringList &statements) {
+  for (const QString &sql : statements) {
+    if (!exec(sql)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MigrationContext::hasColumn(const QString &table, const QString &column) {
+  QSqlQuery pragma = query(QString("PRAGMA table_info(%1)").arg(table));
+  while (pragma.next()) {
+    if (pragma.value("name").toString() == column) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MigrationContext::forEachBatch(
+    const QString &table, int batchSize,
+    const std::function<bool(qint64 fromId, qint64 toId)> &fn) {
+  QSqlQuery bounds =
+      query(QString("SELECT MIN(id), MAX(id) FROM %1").arg(table));
+  if (!bounds.next() || bounds.value(0).isNull()) {
+    return true; // Tabla vacía
+  }
+
+  const qint64 minId = bounds.value(0).toLongLong();
+  const qint64 maxId = bounds.value(1).toLongLong();
+  const qint64 total = maxId - minId + 1;
+
+  for (qint64 fromId = minId; fromId <= maxId; fromId += batchSize) {
+    const qint64 toId = qMin(fromId + batchSize - 1, maxId);
+    if (!fn(fromId, toId)) {
+      return false;
+    }
+    emit m_db.migrationProgress(m_name, toId - minId + 1, total);
+  }
+  return true;
+}
+
+namespace {
+
+/**
+ * @brief Versión 1: tablas, vista e índices base
+ *
+ * Usa IF NOT EXISTS para adoptar bases creadas antes de que existiera
+ * PRAGMA user_version.
+ */
+bool migrateBaseSchema(MigrationContext &context) {
+  // Tabla de miembros
+  QString createMembers = R"(
+        CREATE TABLE IF NOT EXISTS members (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            first_name TEXT NOT NULL,
+            last_name TEXT NOT NULL,
+            email TEXT UNIQUE,
+            phone TEXT,
+            social_media TEXT,
+            health_notes TEXT,
+            weight_kg REAL,
+            height_cm REAL,
+            observations TEXT,
+            created_at TEXT NOT NULL DEFAULT (datetime('now')),
+            updated_at TEXT NOT NULL DEFAULT (datetime('now'))
+        )
+    )";
+
+  // Tabla de planes
+  QString createPlans = R"(
+        CREATE TABLE IF NOT EXISTS plans (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            name TEXT NOT NULL UNIQUE,
+            duration_days INTEGER NOT NULL CHECK (duration_days > 0),
+            price REAL NOT NULL CHECK (price >= 0),
+            is_active INTEGER NOT NULL DEFAULT 1,
+            created_at TEXT NOT NULL DEFAULT (datetime('now')),
+            updated_at TEXT NOT NULL DEFAULT (datetime('now'))
+        )
+    )";
+
+  // Tabla de configuraciones globales
+  QString createSettings = R"(
+        CREATE TABLE IF NOT EXISTS settings (
+            key TEXT PRIMARY KEY,
+            value TEXT,
+            updated_at TEXT NOT NULL DEFAULT (datetime('now'))
+        )
+    )";
+
+  // Tabla de suscripciones
+  QString createSubscriptions = R"(
+        CREATE TABLE IF NOT EXISTS subscriptions (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            member_id INTEGER NOT NULL,
+            plan_id INTEGER NOT NULL,
+            start_date TEXT NOT NULL,
+            plan_duration_days INTEGER,
+            enrollment_fee REAL NOT NULL DEFAULT 0,
+            created_at TEXT NOT NULL DEFAULT (datetime('now')),
+            FOREIGN KEY (member_id) REFERENCES members(id) ON DELETE RESTRICT,
+            FOREIGN KEY (plan_id) REFERENCES plans(id) ON DELETE RESTRICT
+        )
+    )";
+
+  // Tabla de pagos (INMUTABLE)
+  QString createPayments = R"(
+        CREATE TABLE IF NOT EXISTS payments (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            subscription_id INTEGER NOT NULL,
+            amount REAL NOT NULL CHECK (amount > 0),
+            payment_date TEXT NOT NULL,
+            payment_type TEXT NOT NULL CHECK (payment_type IN ('enrollment', 'renewal', 'additional')),
+            notes TEXT,
+            created_at TEXT NOT NULL DEFAULT (datetime('now')),
+            FOREIGN KEY (subscription_id) REFERENCES subscriptions(id) ON DELETE RESTRICT
+        )
+    )";
+
+  // Tabla de entradas financieras (INMUTABLE - Event Sourcing Lite)
+  QString createFinancialEntries = R"(
+        CREATE TABLE IF NOT EXISTS financial_entries (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            entry_type TEXT NOT NULL CHECK (
+                entry_type IN ('enrollment_income', 'renewal_income', 'custom_income', 'custom_expense')
+            ),
+            classification TEXT NOT NULL CHECK (classification IN ('income', 'expense')),
+            amount REAL NOT NULL CHECK (amount > 0),
+            description TEXT NOT NULL,
+            payment_id INTEGER,
+            entry_date TEXT NOT NULL,
+            created_at TEXT NOT NULL DEFAULT (datetime('now')),
+            FOREIGN KEY (payment_id) REFERENCES payments(id) ON DELETE RESTRICT
+        )
+    )";
+
+  // Vista de suscripciones con fecha de vencimiento calculada
+  // COALESCE usa la duración personalizada de la suscripción si existe,
+  // sino usa la duración del plan original
+  QString createSubscriptionsView = R"(
+        CREATE VIEW IF NOT EXISTS v_subscriptions_with_expiry AS
+        SELECT 
+            s.id,
+            s.member_id,
+            s.plan_id,
+            s.start_date,
+            s.plan_duration_days,
+            date(s.start_date, '+' || COALESCE(s.plan_duration_days, p.duration_days) || ' days') AS end_date,
+            s.enrollment_fee,
+            m.first_name || ' ' || m.last_name AS member_name,
+            p.name AS plan_name,
+            COALESCE(s.plan_duration_days, p.duration_days) AS duration_days,
+            p.price AS plan_price,
+            CASE 
+                WHEN date(s.start_date, '+' || COALESCE(s.plan_duration_days, p.duration_days) || ' days') < date('now') THEN 'expired'
+                WHEN date(s.start_date, '+' || COALESCE(s.plan_duration_days, p.duration_days) || ' days') <= date('now', '+7 days') THEN 'expiring'
+                ELSE 'active'
+            END AS status,
+            CAST(julianday(date(s.start_date, '+' || COALESCE(s.plan_duration_days, p.duration_days) || ' days')) - julianday(date('now')) AS INTEGER) AS days_until_expiry
+        FROM subscriptions s
+        JOIN plans p ON s.plan_id = p.id
+        JOIN members m ON s.member_id = m.id
+    )";
+
+  if (!context.execAll({createMembers, createPlans, createSettings,
+                        createSubscriptions, createPayments,
+                        createFinancialEntries})) {
+    return false;
+  }
+
+  // Configuración por defecto
+  if (!context.exec("INSERT OR IGNORE INTO settings (key, value) "
+                    "VALUES ('enrollment_fee', '0.0')")) {
+    return false;
+  }
+
+  // Vista (DROP primero por si existe una definición anterior)
+  if (!context.execAll({"DROP VIEW IF EXISTS v_subscriptions_with_expiry",
+                        createSubscriptionsView})) {
+    return false;
+  }
+
+  QStringList indexes = {
+      "CREATE INDEX IF NOT EXISTS idx_members_name ON members(last_name, "
+      "first_name)",
+      "CREATE INDEX IF NOT EXISTS idx_members_email ON members(email)",
+      "CREATE INDEX IF NOT EXISTS idx_plans_active ON plans(is_active)",
+      "CREATE INDEX IF NOT EXISTS idx_subscriptions_member ON "
+      "subscriptions(member_id)",
+      "CREATE INDEX IF NOT EXISTS idx_subscriptions_start ON "
+      "subscriptions(start_date)",
+      "CREATE INDEX IF NOT EXISTS idx_payments_subscription ON "
+      "payments(subscription_id)",
+      "CREATE INDEX IF NOT EXISTS idx_payments_date ON payments(payment_date)",
+      "CREATE INDEX IF NOT EXISTS idx_payments_type ON payments(payment_type)",
+      "CREATE INDEX IF NOT EXISTS idx_financial_entries_date ON "
+      "financial_entries(entry_date)",
+      "CREATE INDEX IF NOT EXISTS idx_financial_entries_type ON "
+      "financial_entries(entry_type)",
+      "CREATE INDEX IF NOT EXISTS idx_financial_entries_classification ON "
+      "financial_entries(classification)"};
+
+  return context.execAll(indexes);
+}
+
+/**
+ * @brief Versión 2: planes en meses a planes en días
+ *
+ * Antes se registraba en la tabla _migrations como
+ * "001_convert_months_to_days"; si ya figura ahí no se vuelve a aplicar.
+ */
+bool migrateMonthsToDays(MigrationContext &context) {
+  if (!context.hasColumn("plans", "duration_months")) {
+    qCInfo(lcDatabase) << "La columna duration_months no existe o es una "
+                          "instalación nueva.";
+    return true;
+  }
+
+  QSqlQuery legacy =
+      context.query("SELECT name FROM sqlite_master WHERE type = 'table' AND "
+                    "name = '_migrations'");
+  if (legacy.next()) {
+    QSqlQuery applied =
+        context.query("SELECT COUNT(*) FROM _migrations WHERE name = ?",
+                      {"001_convert_months_to_days"});
+    if (applied.next() && applied.value(0).toInt() > 0) {
+      return true;
+    }
+  }
+
+  if (!context.hasColumn("plans", "duration_days") &&
+      !context.exec(
+          "ALTER TABLE plans ADD COLUMN duration_days INTEGER DEFAULT 0")) {
+    return false;
+  }
+
+  return context.forEachBatch("plans", 500, [&](qint64 fromId, qint64 toId) {
+    return context.exec("UPDATE plans SET duration_days = duration_months * 30 "
+                        "WHERE id BETWEEN ? AND ?",
+                        {fromId, toId});
+  });
+}
+
+/**
+ * @brief Versión 3: asistencia (check-in) y tarjetas de miembro
+ */
+bool migrateAttendance(MigrationContext &context) {
+  // Tabla de asistencia (INMUTABLE - append-only)
+  QString createAttendance = R"(
+        CREATE TABLE IF NOT EXISTS attendance (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            member_id INTEGER NOT NULL,
+            checked_in_at TEXT NOT NULL,
+            granted INTEGER NOT NULL DEFAULT 1,
+            FOREIGN KEY (member_id) REFERENCES members(id) ON DELETE RESTRICT
+        )
+    )";
+
+  if (!context.exec(createAttendance)) {
+    return false;
+  }
+
+  if (!context.hasColumn("members", "card_code") &&
+      !context.exec("ALTER TABLE members ADD COLUMN card_code TEXT")) {
+    return false;
+  }
+
+  return context.execAll(
+      {"CREATE INDEX IF NOT EXISTS idx_attendance_member ON "
+       "attendance(member_id, checked_in_at)",
+       "CREATE INDEX IF NOT EXISTS idx_attendance_time ON "
+       "attendance(checked_in_at)",
+       "CREATE UNIQUE INDEX IF NOT EXISTS idx_members_card_code ON "
+       "members(card_code) WHERE card_code IS NOT NULL"});
+}
+
+/**
+ * @brief Versión 4: índice para enlazar movimientos con pagos
+ *
+ * Los movimientos anteriores no tienen payment_id; no se intenta
+ * reconstruir el enlace a partir de la descripción.
+ */
+bool migratePaymentLinks(MigrationContext &context) {
+  return context.exec("CREATE INDEX IF NOT EXISTS "
+                      "idx_financial_entries_payment ON "
+                      "financial_entries(payment_id)");
+}
+
+/**
+ * @brief Versión 5: vista de suscripciones sin date('now')
+ *
+ * Las columnas status y days_until_expiry se evaluaban contra date('now')
+ * (UTC) en cada lectura. El estado se calcula ahora con la fecha de negocio
+ * (BusinessClock), enlazada como parámetro en las consultas.
+ */
+bool migrateExpiryViewWithoutNow(MigrationContext &context) {
+  QString createSubscriptionsView = R"(
+        CREATE VIEW v_subscriptions_with_expiry AS
+        SELECT 
+            s.id,
+            s.member_id,
+            s.plan_id,
+            s.start_date,
+            s.plan_duration_days,
+            date(s.start_date, '+' || COALESCE(s.plan_duration_days, p.duration_days) || ' days') AS end_date,
+            s.enrollment_fee,
+            m.first_name || ' ' || m.last_name AS member_name,
+            p.name AS plan_name,
+            COALESCE(s.plan_duration_days, p.duration_days) AS duration_days,
+            p.price AS plan_price
+        FROM subscriptions s
+        JOIN plans p ON s.plan_id = p.id
+        JOIN members m ON s.member_id = m.id
+    )";
+
+  return context.execAll({"DROP VIEW IF EXISTS v_subscriptions_with_expiry",
+                          createSubscriptionsView});
+}
+
+/**
+ * @brief Versión 6: outbox de recordatorios de vencimiento
+ *
+ * UNIQUE(subscription_id, window_days) hace idempotente la generación
+ * diaria: volver a correrla el mismo día no duplica recordatorios.
+ */
+bool migrateReminderOutbox(MigrationContext &context) {
+  QString createOutbox = R"(
+        CREATE TABLE IF NOT EXISTS outbox (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            member_id INTEGER NOT NULL,
+            subscription_id INTEGER NOT NULL,
+            window_days INTEGER NOT NULL,
+            expiry_date TEXT NOT NULL,
+            member_name TEXT NOT NULL,
+            plan_name TEXT,
+            phone TEXT,
+            email TEXT,
+            message TEXT NOT NULL,
+            status TEXT NOT NULL DEFAULT 'pending' CHECK(status IN ('pending', 'sent', 'failed')),
+            attempts INTEGER NOT NULL DEFAULT 0,
+            last_error TEXT,
+            created_at TEXT NOT NULL DEFAULT (datetime('now')),
+            sent_at TEXT,
+            UNIQUE (subscription_id, window_days),
+            FOREIGN KEY (member_id) REFERENCES members(id) ON DELETE CASCADE,
+            FOREIGN KEY (subscription_id) REFERENCES subscriptions(id) ON DELETE CASCADE
+        )
+    )";
+
+  return context.execAll(
+      {createOutbox,
+       "CREATE INDEX IF NOT EXISTS idx_outbox_status ON outbox(status, id)",
+       "INSERT OR IGNORE INTO settings (key, value) "
+       "VALUES ('reminder_windows', '7,3,1')",
+       "INSERT OR IGNORE INTO settings (key, value) "
+       "VALUES ('reminder_template', 'Hola {nombre}, tu plan {plan} vence "
+       "el {fecha} (en {dias} días). ¡Te esperamos para renovarlo!')"});
+}
+
+/**
+ * @brief Versión 7: índices para paginar el libro de movimientos
+ *
+ * FinancialEntryRepository::findPage ordena y pagina por (entry_date, id).
+ * Los índices compuestos reemplazan a los de una sola columna (que son
+ * prefijos de estos) para que cada página, con o sin filtro por tipo o
+ * clasificación, sea un seek seguido de una lectura en orden.
+ */
+bool migrateLedgerIndexes(MigrationContext &context) {
+  return context.execAll(
+      {"DROP INDEX IF EXISTS idx_financial_entries_date",
+       "DROP INDEX IF EXISTS idx_financial_entries_type",
+       "DROP INDEX IF EXISTS idx_financial_entries_classification",
+       "CREATE INDEX IF NOT EXISTS idx_financial_entries_ledger ON "
+       "financial_entries(entry_date, id)",
+       "CREATE INDEX IF NOT EXISTS idx_financial_entries_type_ledger ON "
+       "financial_entries(entry_type, entry_date, id)",
+       "CREATE INDEX IF NOT EXISTS idx_financial_entries_classification_ledger "
+       "ON financial_entries(classification, entry_date, id)"});
+}
+
+/**
+ * @brief Versión 8: agregados de ingresos por plan y por miembro
+ *
+ * Los ingresos enlazados a un pago (payment_id) se acumulan por plan y
+ * mes en plan_revenue_monthly y por miembro en member_revenue. Como el
+ * libro es solo de inserción, un trigger AFTER INSERT los mantiene al día
+ * en la misma transacción que el movimiento; las consultas de análisis
+ * leen pocas filas aunque el historial crezca. La migración carga los
+ * agregados con los movimientos existentes.
+ */
+bool migrateRevenueAggregates(MigrationContext &context) {
+  QString createPlanRevenue = R"(
+        CREATE TABLE IF NOT EXISTS plan_revenue_monthly (
+            plan_id INTEGER NOT NULL,
+            month TEXT NOT NULL,
+            revenue_cents INTEGER NOT NULL DEFAULT 0,
+            payments INTEGER NOT NULL DEFAULT 0,
+            renewals INTEGER NOT NULL DEFAULT 0,
+            PRIMARY KEY (plan_id, month)
+        ) WITHOUT ROWID
+    )";
+
+  QString createMemberRevenue = R"(
+        CREATE TABLE IF NOT EXISTS member_revenue (
+            member_id INTEGER PRIMARY KEY,
+            revenue_cents INTEGER NOT NULL DEFAULT 0,
+            payments INTEGER NOT NULL DEFAULT 0,
+            renewals INTEGER NOT NULL DEFAULT 0,
+            first_payment TEXT NOT NULL,
+            last_payment TEXT NOT NULL
+        )
+    )";
+
+  QString backfillPlanRevenue = R"(
+        INSERT OR REPLACE INTO plan_revenue_monthly
+            (plan_id, month, revenue_cents, payments, renewals)
+        SELECT s.plan_id,
+               substr(f.entry_date, 1, 7),
+               SUM(CAST(ROUND(f.amount * 100) AS INTEGER)),
+               COUNT(*),
+               SUM(f.entry_type = 'renewal_income')
+        FROM financial_entries f
+        JOIN payments p ON p.id = f.payment_id
+        JOIN subscriptions s ON s.id = p.subscription_id
+        WHERE f.classification = 'income'
+        GROUP BY s.plan_id, substr(f.entry_date, 1, 7)
+    )";
+
+  QString backfillMemberRevenue = R"(
+        INSERT OR REPLACE INTO member_revenue
+            (member_id, revenue_cents, payments, renewals, first_payment,
+             last_payment)
+        SELECT s.member_id,
+               SUM(CAST(ROUND(f.amount * 100) AS INTEGER)),
+               COUNT(*),
+               SUM(f.entry_type = 'renewal_income'),
+               MIN(f.entry_date),
+               MAX(f.entry_date)
+        FROM financial_entries f
+        JOIN payments p ON p.id = f.payment_id
+        JOIN subscriptions s ON s.id = p.subscription_id
+        WHERE f.classification = 'income'
+        GROUP BY s.member_id
+    )";
+
+  QString createTrigger = R"(
+        CREATE TRIGGER IF NOT EXISTS trg_financial_entries_revenue
+        AFTER INSERT ON financial_entries
+        WHEN NEW.payment_id IS NOT NULL AND NEW.classification = 'income'
+        BEGIN
+            INSERT INTO plan_revenue_monthly
+                (plan_id, month, revenue_cents, payments, renewals)
+            SELECT s.plan_id,
+                   substr(NEW.entry_date, 1, 7),
+                   CAST(ROUND(NEW.amount * 100) AS INTEGER),
+                   1,
+                   NEW.entry_type = 'renewal_income'
+            FROM payments p
+            JOIN subscriptions s ON s.id = p.subscription_id
+            WHERE p.id = NEW.payment_id
+            ON CONFLICT (plan_id, month) DO UPDATE SET
+                revenue_cents = revenue_cents + excluded.revenue_cents,
+                payments = payments + 1,
+                renewals = renewals + excluded.renewals;
+
+            INSERT INTO member_revenue
+                (member_id, revenue_cents, payments, renewals, first_payment,
+                 last_payment)
+            SELECT s.member_id,
+                   CAST(ROUND(NEW.amount * 100) AS INTEGER),
+                   1,
+                   NEW.entry_type = 'renewal_income',
+                   NEW.entry_date,
+                   NEW.entry_date
+            FROM payments p
+            JOIN subscriptions s ON s.id = p.subscription_id
+            WHERE p.id = NEW.payment_id
+            ON CONFLICT (member_id) DO UPDATE SET
+                revenue_cents = revenue_cents + excluded.revenue_cents,
+                payments = payments + 1,
+                renewals = renewals + excluded.renewals,
+                first_payment = min(first_payment, excluded.first_payment),
+                last_payment = max(last_payment, excluded.last_payment);
+        END
+    )";
+
+  return context.execAll(
+      {createPlanRevenue, createMemberRevenue,
+       "CREATE INDEX IF NOT EXISTS idx_plan_revenue_month ON "
+       "plan_revenue_monthly(month)",
+       "CREATE INDEX IF NOT EXISTS idx_member_revenue_first ON "
+       "member_revenue(first_payment)",
+       "CREATE INDEX IF NOT EXISTS idx_member_revenue_value ON "
+       "member_revenue(revenue_cents)",
+       backfillPlanRevenue, backfillMemberRevenue, createTrigger});
+}
+
+/**
+ * @brief Versión 9: cierres mensuales del libro
+ *
+ * Cada fila guarda los totales acumulados del libro al último día de un
+ * mes cerrado (ingresos, gastos, saldo de cierre y monto por tipo) y el
+ * mayor id incluido. Los totales a una fecha se obtienen del último cierre
+ * más los movimientos que no cubre. Las filas no se modifican: los
+ * triggers rechazan UPDATE y DELETE. LedgerSnapshots genera los cierres
+ * pendientes al iniciar y al cambiar de día.
+ */
+bool migrateLedgerSnapshots(MigrationContext &context) {
+  QString createSnapshots = R"(
+        CREATE TABLE IF NOT EXISTS ledger_snapshots (
+            month TEXT PRIMARY KEY,
+            period_end TEXT NOT NULL,
+            last_entry_id INTEGER NOT NULL,
+            income_cents INTEGER NOT NULL,
+            expense_cents INTEGER NOT NULL,
+            closing_balance_cents INTEGER NOT NULL,
+            entries INTEGER NOT NULL,
+            enrollment_income_cents INTEGER NOT NULL,
+            renewal_income_cents INTEGER NOT NULL,
+            custom_income_cents INTEGER NOT NULL,
+            custom_expense_cents INTEGER NOT NULL,
+            created_at TEXT NOT NULL DEFAULT (datetime('now'))
+        ) WITHOUT ROWID
+    )";
+
+  return context.execAll(
+      {createSnapshots,
+       "CREATE TRIGGER IF NOT EXISTS trg_ledger_snapshots_no_update "
+       "BEFORE UPDATE ON ledger_snapshots "
+       "BEGIN SELECT RAISE(ABORT, 'ledger_snapshots es inmutable'); END",
+       "CREATE TRIGGER IF NOT EXISTS trg_ledger_snapshots_no_delete "
+       "BEFORE DELETE ON ledger_snapshots "
+       "BEGIN SELECT RAISE(ABORT, 'ledger_snapshots es inmutable'); END"});
+}
+
+/**
+ * @brief Versión 10: estado `sending` en el outbox
+ *
+ * El envío reclama cada lote (status = 'sending' y attempts + 1) antes de
+ * entregarlo al sender, así un lote cuyo resultado no se pudo guardar no
+ * vuelve a salir como pendiente. SQLite no permite cambiar un CHECK, por
+ * lo que la tabla se reconstruye con los mismos datos.
+ */
+bool migrateOutboxSending(MigrationContext &context) {
+  QString createOutbox = R"(
+        CREATE TABLE outbox_new (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            member_id INTEGER NOT NULL,
+            subscription_id INTEGER NOT NULL,
+            window_days INTEGER NOT NULL,
+            expiry_date TEXT NOT NULL,
+            member_name TEXT NOT NULL,
+            plan_name TEXT,
+            phone TEXT,
+            email TEXT,
+            message TEXT NOT NULL,
+            status TEXT NOT NULL DEFAULT 'pending' CHECK(status IN ('pending', 'sending', 'sent', 'failed')),
+            attempts INTEGER NOT NULL DEFAULT 0,
+            last_error TEXT,
+            created_at TEXT NOT NULL DEFAULT (datetime('now')),
+            sent_at TEXT,
+            UNIQUE (subscription_id, window_days),
+            FOREIGN KEY (member_id) REFERENCES members(id) ON DELETE CASCADE,
+            FOREIGN KEY (subscription_id) REFERENCES subscriptions(id) ON DELETE CASCADE
+        )
+    )";
+
+  return context.execAll(
+      {createOutbox, "INSERT INTO outbox_new SELECT * FROM outbox",
+       "DROP TABLE outbox", "ALTER TABLE outbox_new RENAME TO outbox",
+       "CREATE INDEX IF NOT EXISTS idx_outbox_status ON outbox(status, id)"});
+}
+
+} // namespace
+
+const std::vector<Migration> &migrations() {
+  static const std::vector<Migration> list = {
+      {1, "base_schema", migrateBaseSchema},
+      {2, "convert_months_to_days", migrateMonthsToDays},
+      {3, "attendance", migrateAttendance},
+      {4, "payment_links", migratePaymentLinks},
+      {5, "expiry_view_without_now", migrateExpiryViewWithoutNow},
+      {6, "reminder_outbox", migrateReminderOutbox},
+      {7, "ledger_indexes", migrateLedgerIndexes},
+      {8, "revenue_aggregates", migrateRevenueAggregates},
+      {9, "ledger_snapshots", migrateLedgerSnapshots},
+      {10, "outbox_sending", migrateOutboxSending},
+  };
+  return list;
+}
+
+} // namespace GymOS::Infrastructure::Database
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QSqlQuery>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <functional>
+#include <vector>
+
+namespace GymOS::Infrastructure::Database {
+
+class DatabaseManager;
+
+/**
+ * @brief Operaciones disponibles para una migración
+ *
+ * Cada migración corre dentro de su propia transacción (ver
+ * DatabaseManager::runMigrations); cualquier fallo revierte la unidad
+ * completa y deja PRAGMA user_version sin cambios.
+ */
+class MigrationContext {
+public:
+  MigrationContext(DatabaseManager &db, const QString &name);
+
+  /**
+   * @brief Ejecuta una consulta y devuelve el resultado
+   */
+  QSqlQuery query(const QString &sql, const QVariantList &params = {});
+
+  /**
+   * @brief Ejecuta una sentencia
+   * @return false si la sentencia falló
+   */
+  bool exec(const QString &sql, const QVariantList &params = {});
+
+  /**
+   * @brief Ejecuta varias sentencias en orden, deteniéndose en la primera
+   * que falle
+   */
+  bool execAll(const QStringList &statements);
+
+  /**
+   * @brief Indica si la tabla tiene la columna indicada
+   */
+  bool hasColumn(const QString &table, const QString &column);
+
+  /**
+   * @brief Recorre una tabla en bloques de ids consecutivos
+   *
+   * Pensado para migraciones de datos grandes (p. ej. cambiar la
+   * representación de montos o fechas): `fn` recibe el rango [fromId, toId]
+   * y debe procesar solo esas filas, de modo que cada sentencia toca un
+   * bloque acotado. Emite DatabaseManager::migrationProgress después de
+   * cada bloque.
+   *
+   * @param table Tabla con clave primaria `id`
+   * @param batchSize Cantidad de ids por bloque
+   * @param fn Procesa un bloque; devolver false aborta la migración
+   */
+  bool forEachBatch(const QString &table, int batchSize,
+                    const std::function<bool(qint64 fromId, qint64 toId)> &fn);
+
+private:
+  DatabaseManager &m_db;
+  QString m_name;
+};
+
+/**
+ * @brief Unidad de migración numerada
+ *
+ * `version` es el valor de PRAGMA user_version que queda guardado al
+ * aplicarla. Las versiones son consecutivas a partir de 1.
+ */
+struct Migration {
+  int version;
+  const char *name;
+  bool (*apply)(MigrationContext &context);
+};
+
+/**
+ * @brief Lista de migraciones en orden de versión
+ *
+ * Para modificar el esquema se agrega una migración al final; las
+ * existentes no se editan porque ya fueron aplicadas en bases instaladas.
+ */
+const std::vector<Migration> &migrations();
+
+} // namespace GymOS::Infrastructure::Database
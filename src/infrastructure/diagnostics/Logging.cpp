@@ -0,0 +1,8 @@
+#include "Logging.h"
+
+Q_LOGGING_CATEGORY(lcStartup, "gymos.startup")
+Q_LOGGING_CATEGORY(lcDatabase, "gymos.database")
+Q_LOGGING_CATEGORY(lcController, "gymos.controller")
+Q_LOGGING_CATEGORY(lcSubscriptions, "gymos.subscriptions")
+Q_LOGGING_CATEGORY(lcFinance, "gymos.finance")
+Q_LOGGING_CATEGORY(lcCheckIn, "gymos.checkin")
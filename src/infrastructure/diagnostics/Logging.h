@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QDebug>
+#include <QLoggingCategory>
+
+/**
+ * @brief Categorías de log de GymOS
+ *
+ * Cada subsistema registra sus mensajes en su propia categoría
+ * (`gymos.<subsistema>`), de modo que el message handler puede filtrar por
+ * categoría en lugar de inspeccionar el texto del mensaje, y los mensajes
+ * deshabilitados no se formatean.
+ */
+Q_DECLARE_LOGGING_CATEGORY(lcStartup)
+Q_DECLARE_LOGGING_CATEGORY(lcDatabase)
+Q_DECLARE_LOGGING_CATEGORY(lcController)
+Q_DECLARE_LOGGING_CATEGORY(lcSubscriptions)
+Q_DECLARE_LOGGING_CATEGORY(lcFinance)
+Q_DECLARE_LOGGING_CATEGORY(lcCheckIn)
+
+/**
+ * @brief Log de nivel trace (detalle por operación)
+ *
+ * Se usa igual que qCDebug: `GYM_TRACE(lcController) << "valor:" << x;`
+ *
+ * Con GYMOS_NO_TRACE_LOGS definido (builds de release, ver la opción
+ * GYMOS_TRACE_LOGS en CMakeLists.txt) la sentencia queda dentro de un
+ * `while (false)`: los argumentos no se evalúan y el compilador la elimina.
+ */
+#ifdef GYMOS_NO_TRACE_LOGS
+#define GYM_TRACE(category) QT_NO_QDEBUG_MACRO()
+#else
+#define GYM_TRACE(category) qCDebug(category)
+#endif
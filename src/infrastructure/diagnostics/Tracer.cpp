@@ -0,0 +1,198 @@
+#include "Tracer.h"
+#include "Logging.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QQmlEngine>
+
+namespace GymOS::Infrastructure::Diagnostics {
+
+namespace {
+
+constexpr size_t kDefaultCapacity = 65536;
+
+quint32 currentThreadTraceId() {
+  // IDs pequeños y estables por hilo, asignados en orden de primer uso
+  static std::atomic<quint32> nextId{1};
+  thread_local const quint32 id = nextId.fetch_add(1);
+  return id;
+}
+
+} // namespace
+
+Tracer &Tracer::instance() {
+  static Tracer instance;
+  return instance;
+}
+
+Tracer *Tracer::create(QQmlEngine *qmlEngine, QJSEngine *jsEngine) {
+  Q_UNUSED(qmlEngine)
+  Q_UNUSED(jsEngine)
+
+  Tracer *tracer = &instance();
+  QJSEngine::setObjectOwnership(tracer, QJSEngine::CppOwnership);
+  return tracer;
+}
+
+Tracer::Tracer() : QObject(nullptr) { m_clock.start(); }
+
+void Tracer::configureFromEnvironment() {
+  const QString value = qEnvironmentVariable("GYMOS_TRACE");
+  if (value.isEmpty() || value == "0") {
+    return;
+  }
+
+  if (value == "1") {
+    m_outputPath = QString("runtime-logs/trace_%1.json")
+                       .arg(QDateTime::currentDateTime().toString(
+                           "yyyy-MM-dd_HH-mm-ss"));
+  } else {
+    m_outputPath = value;
+  }
+
+  bool ok = false;
+  const int capacity =
+      qEnvironmentVariableIntValue("GYMOS_TRACE_CAPACITY", &ok);
+
+  QMutexLocker locker(&m_mutex);
+  m_ring.assign(ok && capacity > 0 ? static_cast<size_t>(capacity)
+                                   : kDefaultCapacity,
+                TraceEvent{});
+  m_next = 0;
+  m_wrapped = false;
+  m_enabled.store(true, std::memory_order_relaxed);
+
+  qCInfo(lcStartup) << "Traza habilitada, exportando a:" << m_outputPath;
+}
+
+qint64 Tracer::nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+void Tracer::record(TraceEvent event) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  event.threadId = currentThreadTraceId();
+
+  QMutexLocker locker(&m_mutex);
+  m_ring[m_next] = std::move(event);
+  m_next = (m_next + 1) % m_ring.size();
+  if (m_next == 0) {
+    m_wrapped = true;
+  }
+}
+
+void Tracer::completeSpan(const char *category, const char *name,
+                          qint64 startUs) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  TraceEvent event;
+  event.category = category;
+  event.name = name;
+  event.startUs = startUs;
+  event.durationUs = nowUs() - startUs;
+  record(std::move(event));
+}
+
+void Tracer::instant(const QString &name) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  TraceEvent event;
+  event.category = "qml";
+  event.dynamicName = name;
+  event.startUs = nowUs();
+  event.phase = 'i';
+  record(std::move(event));
+}
+
+bool Tracer::exportChromeTrace() {
+  if (!isEnabled() || m_outputPath.isEmpty()) {
+    return false;
+  }
+  return exportChromeTrace(m_outputPath);
+}
+
+bool Tracer::exportChromeTrace(const QString &path) {
+  // Copiar el buffer para no bloquear a los productores mientras se escribe
+  std::vector<TraceEvent> events;
+  {
+    QMutexLocker locker(&m_mutex);
+    if (m_wrapped) {
+      events.reserve(m_ring.size());
+      events.insert(events.end(), m_ring.begin() + m_next, m_ring.end());
+    }
+    events.insert(events.end(), m_ring.begin(), m_ring.begin() + m_next);
+  }
+
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qCWarning(lcStartup) << "No se pudo escribir la traza:" << path;
+    return false;
+  }
+
+  file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  bool first = true;
+  for (const TraceEvent &event : events) {
+    QJsonObject json;
+    json["name"] = event.name ? QString::fromUtf8(event.name)
+                              : event.dynamicName;
+    json["cat"] = QString::fromUtf8(event.category);
+    json["ph"] = QString(QChar(event.phase));
+    json["ts"] = event.startUs;
+    json["pid"] = 1;
+    json["tid"] = static_cast<qint64>(event.threadId);
+    if (event.phase == 'X') {
+      json["dur"] = event.durationUs;
+    } else {
+      json["s"] = "g";
+    }
+
+    if (!first) {
+      file.write(",\n");
+    }
+    first = false;
+    file.write(QJsonDocument(json).toJson(QJsonDocument::Compact));
+  }
+  file.write("\n]}\n");
+
+  qCInfo(lcStartup) << "Traza exportada:" << events.size() << "eventos en"
+                    << path;
+  return true;
+}
+
+TraceScope::TraceScope(const char *category, const char *name)
+    : m_active(Tracer::instance().isEnabled()) {
+  if (m_active) {
+    m_event.category = category;
+    m_event.name = name;
+    m_event.startUs = Tracer::instance().nowUs();
+  }
+}
+
+TraceScope::TraceScope(const char *category, const QString &name)
+    : m_active(Tracer::instance().isEnabled()) {
+  if (m_active) {
+    m_event.category = category;
+    m_event.dynamicName = name.simplified().left(120);
+    m_event.startUs = Tracer::instance().nowUs();
+  }
+}
+
+TraceScope::~TraceScope() {
+  if (m_active) {
+    auto &tracer = Tracer::instance();
+    m_event.durationUs = tracer.nowUs() - m_event.startUs;
+    tracer.record(std::move(m_event));
+  }
+}
+
+} // namespace GymOS::Infrastructure::Diagnostics
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QtQml/qqmlregistration.h>
+#include <atomic>
+#include <vector>
+
+class QQmlEngine;
+class QJSEngine;
+
+namespace GymOS::Infrastructure::Diagnostics {
+
+/**
+ * @brief Evento de traza (formato Chrome Trace / Perfetto)
+ *
+ * `name` y `category` apuntan a literales estáticos; los nombres dinámicos
+ * (SQL, vistas QML) se guardan en `dynamicName` solo cuando la traza está
+ * habilitada.
+ */
+struct TraceEvent {
+  const char *category = "";
+  const char *name = nullptr;
+  QString dynamicName;
+  qint64 startUs = 0;
+  qint64 durationUs = 0;
+  quint32 threadId = 0;
+  char phase = 'X'; ///< 'X' = span completo, 'i' = evento instantáneo
+};
+
+/**
+ * @brief Trazador de rendimiento
+ *
+ * Registra spans en un buffer circular de tamaño fijo y los exporta como
+ * JSON de Chrome Trace (abrir en chrome://tracing o ui.perfetto.dev).
+ *
+ * Se habilita con la variable de entorno GYMOS_TRACE:
+ * - `GYMOS_TRACE=1` exporta a runtime-logs/trace_<fecha>.json
+ * - `GYMOS_TRACE=<ruta>.json` exporta a la ruta indicada
+ * GYMOS_TRACE_CAPACITY define el tamaño del buffer (por defecto 65536).
+ *
+ * Deshabilitado, cada span cuesta una lectura atómica. En QML está
+ * disponible como el singleton `Tracer` del módulo GymOSQml.
+ */
+class Tracer : public QObject {
+  Q_OBJECT
+  QML_ELEMENT
+  QML_SINGLETON
+
+public:
+  static Tracer &instance();
+
+  /**
+   * @brief Fábrica del singleton QML (devuelve la instancia global)
+   */
+  static Tracer *create(QQmlEngine *qmlEngine, QJSEngine *jsEngine);
+
+  /**
+   * @brief Lee GYMOS_TRACE y habilita la traza si corresponde
+   */
+  void configureFromEnvironment();
+
+  [[nodiscard]] bool isEnabled() const {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Microsegundos desde el inicio de la traza
+   */
+  [[nodiscard]] qint64 nowUs() const;
+
+  /**
+   * @brief Agrega un evento al buffer circular (thread-safe)
+   */
+  void record(TraceEvent event);
+
+  /**
+   * @brief Registra un span que empezó en `startUs` y termina ahora
+   *
+   * Para fases que no encajan en un scope (p. ej. las de main()).
+   */
+  void completeSpan(const char *category, const char *name, qint64 startUs);
+
+  /**
+   * @brief Registra un evento instantáneo (p. ej. vista QML cargada)
+   */
+  Q_INVOKABLE void instant(const QString &name);
+
+  /**
+   * @brief Exporta los eventos registrados a la ruta configurada
+   * @return true si se escribió el archivo
+   */
+  bool exportChromeTrace();
+
+  /**
+   * @brief Exporta los eventos registrados como JSON de Chrome Trace
+   */
+  bool exportChromeTrace(const QString &path);
+
+  [[nodiscard]] QString outputPath() const { return m_outputPath; }
+
+private:
+  Tracer();
+
+  Tracer(const Tracer &) = delete;
+  Tracer &operator=(const Tracer &) = delete;
+
+  std::atomic<bool> m_enabled{false};
+  QString m_outputPath;
+  QElapsedTimer m_clock;
+
+  mutable QMutex m_mutex;
+  std::vector<TraceEvent> m_ring;
+  size_t m_next = 0;
+  bool m_wrapped = false;
+};
+
+/**
+ * @brief Span RAII: registra su duración al salir del scope
+ */
+class TraceScope {
+public:
+  TraceScope(const char *category, const char *name);
+  TraceScope(const char *category, const QString &name);
+  ~TraceScope();
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+  TraceEvent m_event;
+  bool m_active;
+};
+
+} // namespace GymOS::Infrastructure::Diagnostics
+
+#define GYM_TRACE_CONCAT_INNER(a, b) a##b
+#define GYM_TRACE_CONCAT(a, b) GYM_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Abre un span que dura hasta el final del scope actual
+ *
+ * `GYM_TRACE_SCOPE("controller", __func__);`
+ */
+#define GYM_TRACE_SCOPE(category, name)                                        \
+  ::GymOS::Infrastructure::Diagnostics::TraceScope GYM_TRACE_CONCAT(           \
+      gymTraceScope_, __LINE__)(category, name)
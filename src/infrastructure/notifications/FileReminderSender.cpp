@@ -0,0 +1,43 @@
+#include "FileReminderSender.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+namespace GymOS::Infrastructure::Notifications {
+
+FileReminderSender::FileReminderSender(QString directory)
+    : m_directory(std::move(directory)) {}
+
+void FileReminderSender::send(std::vector<Reminder> &batch) {
+  const QDateTime now = QDateTime::currentDateTime();
+
+  QDir().mkpath(m_directory);
+  QFile file(QDir(m_directory).filePath(
+      QString("recordatorios_%1.txt").arg(now.date().toString(Qt::ISODate))));
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+    for (Reminder &reminder : batch) {
+      reminder.lastError = file.errorString();
+    }
+    return;
+  }
+
+  QTextStream out(&file);
+  for (Reminder &reminder : batch) {
+    const QString recipient =
+        !reminder.phone.isEmpty() ? reminder.phone : reminder.email;
+    if (recipient.isEmpty()) {
+      reminder.lastError = "El miembro no tiene teléfono ni email";
+      continue;
+    }
+
+    out << now.toString("hh:mm") << " | " << reminder.memberName << " <"
+        << recipient << ">\n"
+        << reminder.message << "\n\n";
+    reminder.status = ReminderStatus::Sent;
+    reminder.sentAt = now;
+    reminder.lastError.clear();
+  }
+}
+
+} // namespace GymOS::Infrastructure::Notifications
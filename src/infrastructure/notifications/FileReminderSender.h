@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../../core/services/ReminderSender.h"
+#include <QString>
+
+namespace GymOS::Infrastructure::Notifications {
+
+using namespace GymOS::Core::Services;
+
+/**
+ * @brief Sender local: agrega cada recordatorio a un archivo de texto
+ *
+ * Reemplazo de un canal real (WhatsApp, email) mientras no haya uno
+ * configurado: escribe un archivo por día en `directory`
+ * (`recordatorios_<fecha>.txt`) con destinatario y mensaje, de modo que el
+ * personal pueda copiarlos o el archivo pueda procesarse con otra
+ * herramienta.
+ */
+class FileReminderSender : public ReminderSender {
+public:
+  explicit FileReminderSender(QString directory);
+
+  [[nodiscard]] QString name() const override { return "file"; }
+  void send(std::vector<Reminder> &batch) override;
+
+private:
+  QString m_directory;
+};
+
+} // namespace GymOS::Infrastructure::Notifications
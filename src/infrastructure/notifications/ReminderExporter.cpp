@@ -0,0 +1,120 @@
+#include "ReminderExporter.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStringList>
+
+namespace GymOS::Infrastructure::Notifications {
+
+namespace {
+
+QString csvField(const QString &value) {
+  if (!value.contains(QLatin1Char(',')) && !value.contains(QLatin1Char('"')) &&
+      !value.contains(QLatin1Char('\n'))) {
+    return value;
+  }
+  QString escaped = value;
+  escaped.replace(QLatin1String("\""), QLatin1String("\"\""));
+  return QLatin1Char('"') + escaped + QLatin1Char('"');
+}
+
+QString vCardText(QString value) {
+  value.replace(QLatin1String("\\"), QLatin1String("\\\\"));
+  value.replace(QLatin1String("\n"), QLatin1String("\\n"));
+  value.replace(QLatin1String(","), QLatin1String("\\,"));
+  value.replace(QLatin1String(";"), QLatin1String("\\;"));
+  return value;
+}
+
+} // namespace
+
+QString ReminderExporter::extension(Format format) {
+  switch (format) {
+  case Format::Csv:
+    return "csv";
+  case Format::VCard:
+    return "vcf";
+  case Format::Messages:
+    return "txt";
+  }
+  return "txt";
+}
+
+bool ReminderExporter::write(const std::vector<Reminder> &reminders,
+                             Format format, const QString &path,
+                             QString *error) {
+  QByteArray content;
+  switch (format) {
+  case Format::Csv:
+    content = toCsv(reminders);
+    break;
+  case Format::VCard:
+    content = toVCard(reminders);
+    break;
+  case Format::Messages:
+    content = toMessages(reminders);
+    break;
+  }
+
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly) || file.write(content) < 0 ||
+      !file.commit()) {
+    if (error) {
+      *error = file.errorString();
+    }
+    return false;
+  }
+  return true;
+}
+
+QByteArray ReminderExporter::toCsv(const std::vector<Reminder> &reminders) {
+  QStringList lines;
+  lines << "miembro,plan,vence,aviso_dias,telefono,email,mensaje";
+  for (const Reminder &reminder : reminders) {
+    lines << QStringList{csvField(reminder.memberName),
+                         csvField(reminder.planName),
+                         reminder.expiryDate.toString(Qt::ISODate),
+                         QString::number(reminder.windowDays),
+                         csvField(reminder.phone), csvField(reminder.email),
+                         csvField(reminder.message)}
+                 .join(QLatin1Char(','));
+  }
+  // BOM para que Excel detecte UTF-8
+  return QByteArray("\xEF\xBB\xBF") + lines.join("\r\n").toUtf8() + "\r\n";
+}
+
+QByteArray ReminderExporter::toVCard(const std::vector<Reminder> &reminders) {
+  QString out;
+  for (const Reminder &reminder : reminders) {
+    out += "BEGIN:VCARD\r\nVERSION:3.0\r\n";
+    out += "FN:" + vCardText(reminder.memberName) + "\r\n";
+    out += "N:" + vCardText(reminder.memberName) + ";;;;\r\n";
+    if (!reminder.phone.isEmpty()) {
+      out += "TEL;TYPE=CELL:" + vCardText(reminder.phone) + "\r\n";
+    }
+    if (!reminder.email.isEmpty()) {
+      out += "EMAIL:" + vCardText(reminder.email) + "\r\n";
+    }
+    out += "NOTE:" + vCardText(reminder.message) + "\r\n";
+    out += "END:VCARD\r\n";
+  }
+  return out.toUtf8();
+}
+
+QByteArray
+ReminderExporter::toMessages(const std::vector<Reminder> &reminders) {
+  QString out;
+  for (const Reminder &reminder : reminders) {
+    const QString recipient =
+        !reminder.phone.isEmpty() ? reminder.phone : reminder.email;
+    out += reminder.memberName;
+    if (!recipient.isEmpty()) {
+      out += " <" + recipient + ">";
+    }
+    out += "\n" + reminder.message + "\n\n";
+  }
+  return out.toUtf8();
+}
+
+} // namespace GymOS::Infrastructure::Notifications
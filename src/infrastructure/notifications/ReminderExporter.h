@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../../core/models/Reminder.h"
+#include <QString>
+#include <vector>
+
+namespace GymOS::Infrastructure::Notifications {
+
+using namespace GymOS::Core::Models;
+
+/**
+ * @brief Exporta recordatorios del outbox a archivos
+ *
+ * - CSV (UTF-8 con BOM, para abrir en Excel): contacto, vencimiento y
+ *   mensaje
+ * - vCard 3.0: un contacto por miembro, con el mensaje en NOTE, para
+ *   importar en el teléfono
+ * - Mensajes: texto plano listo para copiar y pegar
+ */
+class ReminderExporter {
+public:
+  enum class Format { Csv, VCard, Messages };
+
+  /**
+   * @brief Extensión de archivo del formato (sin punto)
+   */
+  [[nodiscard]] static QString extension(Format format);
+
+  /**
+   * @brief Escribe los recordatorios en `path`
+   * @param error Si no es nulo, recibe el motivo del fallo
+   * @return true si se escribió el archivo
+   */
+  static bool write(const std::vector<Reminder> &reminders, Format format,
+                    const QString &path, QString *error = nullptr);
+
+private:
+  static QByteArray toCsv(const std::vector<Reminder> &reminders);
+  static QByteArray toVCard(const std::vector<Reminder> &reminders);
+  static QByteArray toMessages(const std::vector<Reminder> &reminders);
+};
+
+} // namespace GymOS::Infrastructure::Notifications
@@ -0,0 +1,298 @@
+#include "FinancialReportExporter.h"
+#include "../database/DatabaseManager.h"
+#include "../diagnostics/Logging.h"
+#include "../diagnostics/Tracer.h"
+#include "../repositories/FinancialEntryRepository.h"
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QPointer>
+#include <QSaveFile>
+#include <QtConcurrent/QtConcurrentRun>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+namespace GymOS::Infrastructure::Reports {
+
+using GymOS::Infrastructure::Database::DatabaseManager;
+using GymOS::Infrastructure::Repositories::FinancialEntryRepository;
+
+namespace {
+
+QByteArray csvField(const QString &value) {
+  if (!value.contains(QLatin1Char(',')) && !value.contains(QLatin1Char('"')) &&
+      !value.contains(QLatin1Char('\n'))) {
+    return value.toUtf8();
+  }
+  QString escaped = value;
+  escaped.replace(QLatin1String("\""), QLatin1String("\"\""));
+  return (QLatin1Char('"') + escaped + QLatin1Char('"')).toUtf8();
+}
+
+/**
+ * @brief Escritor del formato columnar
+ *
+ * Disposición del archivo (little-endian):
+ *
+ *     "GYMCOL1\0"
+ *     grupo*:  int32 filas
+ *              id           int64[filas]
+ *              entry_date   int32[filas]   (día juliano)
+ *              entry_type   uint8[filas]   (índice en el diccionario)
+ *              class        uint8[filas]   (0 = income, 1 = expense)
+ *              amount       float64[filas]
+ *              payment_id   int64[filas]   (0 = sin pago)
+ *              description  int32[filas+1] offsets + bytes UTF-8
+ *     footer:  int32 grupos, por grupo int64 offset + int32 filas
+ *              int32 tipos, por tipo int32 largo + bytes (entry_type)
+ *     int64 offset del footer
+ *     "GYMCOL1\0"
+ *
+ * Cada grupo se acumula en memoria (kRowGroupSize filas) y se escribe
+ * columna por columna.
+ */
+class ColumnarWriter {
+public:
+  explicit ColumnarWriter(QIODevice &device) : m_device(device) {
+    m_out.setDevice(&device);
+    m_out.setByteOrder(QDataStream::LittleEndian);
+    m_out.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    m_out.writeRawData(kMagic, sizeof(kMagic));
+    m_textOffsets.push_back(0);
+  }
+
+  void append(const FinancialEntry &entry) {
+    m_ids.push_back(entry.id);
+    m_dates.push_back(static_cast<qint32>(entry.entryDate.toJulianDay()));
+    m_types.push_back(static_cast<quint8>(entry.entryType));
+    m_classes.push_back(static_cast<quint8>(entry.classification));
+    m_amounts.push_back(entry.amount);
+    m_payments.push_back(entry.paymentId.value_or(0));
+    m_text.append(entry.description.toUtf8());
+    m_textOffsets.push_back(static_cast<qint32>(m_text.size()));
+
+    if (m_ids.size() >= FinancialReportExporter::kRowGroupSize) {
+      flushGroup();
+    }
+  }
+
+  bool finish() {
+    flushGroup();
+
+    const qint64 footerOffset = m_device.pos();
+    m_out << static_cast<qint32>(m_groups.size());
+    for (const auto &[offset, rows] : m_groups) {
+      m_out << static_cast<qint64>(offset) << static_cast<qint32>(rows);
+    }
+
+    // Diccionario de entry_type en el orden de EntryType
+    const EntryType types[] = {EntryType::EnrollmentIncome,
+                               EntryType::RenewalIncome,
+                               EntryType::CustomIncome,
+                               EntryType::CustomExpense};
+    m_out << static_cast<qint32>(std::size(types));
+    for (EntryType type : types) {
+      FinancialEntry probe;
+      probe.entryType = type;
+      const QByteArray id = probe.entryTypeId().toUtf8();
+      m_out << static_cast<qint32>(id.size());
+      m_out.writeRawData(id.constData(), id.size());
+    }
+
+    m_out << footerOffset;
+    m_out.writeRawData(kMagic, sizeof(kMagic));
+    return m_out.status() == QDataStream::Ok;
+  }
+
+private:
+  static constexpr char kMagic[8] = {'G', 'Y', 'M', 'C', 'O', 'L', '1', '\0'};
+
+  template <typename T> void writeColumn(const std::vector<T> &values) {
+    for (const T &value : values) {
+      m_out << value;
+    }
+  }
+
+  void flushGroup() {
+    if (m_ids.empty()) {
+      return;
+    }
+    m_groups.emplace_back(m_device.pos(), m_ids.size());
+
+    m_out << static_cast<qint32>(m_ids.size());
+    writeColumn(m_ids);
+    writeColumn(m_dates);
+    writeColumn(m_types);
+    writeColumn(m_classes);
+    writeColumn(m_amounts);
+    writeColumn(m_payments);
+    writeColumn(m_textOffsets);
+    m_out.writeRawData(m_text.constData(), m_text.size());
+
+    // clear() conserva la capacidad: los grupos siguientes no reservan
+    m_ids.clear();
+    m_dates.clear();
+    m_types.clear();
+    m_classes.clear();
+    m_amounts.clear();
+    m_payments.clear();
+    m_textOffsets.assign(1, 0);
+    m_text.clear();
+  }
+
+  QIODevice &m_device;
+  QDataStream m_out;
+  std::vector<std::pair<qint64, size_t>> m_groups;
+
+  std::vector<qint64> m_ids;
+  std::vector<qint32> m_dates;
+  std::vector<quint8> m_types;
+  std::vector<quint8> m_classes;
+  std::vector<double> m_amounts;
+  std::vector<qint64> m_payments;
+  std::vector<qint32> m_textOffsets;
+  QByteArray m_text;
+};
+
+} // namespace
+
+FinancialReportExporter::FinancialReportExporter(QObject *parent)
+    : QObject(parent) {}
+
+QString FinancialReportExporter::extension(Format format) {
+  return format == Format::Columnar ? "gymcol" : "csv";
+}
+
+bool FinancialReportExporter::start(const QDate &from, const QDate &to,
+                                    Format format, const QString &path) {
+  if (m_running) {
+    return false;
+  }
+  m_running = true;
+  m_cancelled = std::make_shared<std::atomic<bool>>(false);
+  emit runningChanged();
+
+  // El progreso se publica en el hilo del exportador
+  QPointer<FinancialReportExporter> guard(this);
+  auto onProgress = [guard](qint64 written, qint64 total) {
+    QMetaObject::invokeMethod(
+        guard,
+        [guard, written, total] { emit guard->progress(written, total); },
+        Qt::QueuedConnection);
+  };
+
+  QtConcurrent::run(&FinancialReportExporter::run, from, to, format, path,
+                    m_cancelled, onProgress)
+      .then(this, [this, path](const Result &result) {
+        m_running = false;
+        emit runningChanged();
+
+        if (result.cancelled) {
+          qCInfo(lcFinance) << "Exportación cancelada:" << path;
+          emit failed("Exportación cancelada");
+        } else if (!result.error.isEmpty()) {
+          qCWarning(lcFinance) << "Error exportando:" << result.error;
+          emit failed(result.error);
+        } else {
+          qCInfo(lcFinance) << "Exportadas" << result.rows << "filas a"
+                            << path;
+          emit finished(path, result.rows);
+        }
+      });
+  return true;
+}
+
+void FinancialReportExporter::cancel() {
+  if (m_cancelled) {
+    m_cancelled->store(true, std::memory_order_relaxed);
+  }
+}
+
+FinancialReportExporter::Result FinancialReportExporter::run(
+    const QDate &from, const QDate &to, Format format, const QString &path,
+    const std::shared_ptr<std::atomic<bool>> &cancelled,
+    const std::function<void(qint64, qint64)> &onProgress) {
+  GYM_TRACE_SCOPE("finance", "exportReport");
+  Result result;
+
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    result.error = file.errorString();
+    return result;
+  }
+
+  const QString connection = QStringLiteral("gymos_report");
+  {
+    QSqlDatabase db =
+        DatabaseManager::instance().openWorkerConnection(connection);
+    if (!db.isOpen()) {
+      result.error = "No se pudo abrir la base de datos";
+    } else {
+      const qint64 total =
+          FinancialEntryRepository::countByDateRange(db, from, to);
+      onProgress(0, total);
+
+      std::optional<ColumnarWriter> columnar;
+      if (format == Format::Columnar) {
+        columnar.emplace(file);
+      } else {
+        file.write("\xEF\xBB\xBF"
+                   "id,fecha,tipo,clasificacion,monto,descripcion,pago_id\n");
+      }
+
+      QByteArray line;
+      const bool ok = FinancialEntryRepository::forEachInRange(
+          db, from, to, [&](const FinancialEntry &entry) {
+            if (cancelled->load(std::memory_order_relaxed)) {
+              result.cancelled = true;
+              return false;
+            }
+
+            if (columnar) {
+              columnar->append(entry);
+            } else {
+              line.clear();
+              line += QByteArray::number(static_cast<qint64>(entry.id));
+              line += ',' + entry.entryDate.toString(Qt::ISODate).toUtf8();
+              line += ',' + entry.entryTypeId().toUtf8();
+              line += ',' + entry.classificationId().toUtf8();
+              line += ',' + QByteArray::number(entry.amount, 'f', 2);
+              line += ',' + csvField(entry.description);
+              line += ',';
+              if (entry.paymentId) {
+                line += QByteArray::number(
+                    static_cast<qint64>(*entry.paymentId));
+              }
+              line += '\n';
+              file.write(line);
+            }
+
+            if (++result.rows % kProgressInterval == 0) {
+              onProgress(result.rows, total);
+            }
+            return true;
+          });
+
+      if (!ok) {
+        result.error = "Error leyendo los movimientos";
+      } else if (columnar && !result.cancelled && !columnar->finish()) {
+        result.error = "Error escribiendo el archivo";
+      }
+      onProgress(result.rows, total);
+    }
+  }
+  DatabaseManager::closeWorkerConnection(connection);
+
+  if (result.cancelled || !result.error.isEmpty()) {
+    file.cancelWriting();
+    return result;
+  }
+  if (!file.commit()) {
+    result.error = file.errorString();
+  }
+  return result;
+}
+
+} // namespace GymOS::Infrastructure::Reports
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../../core/models/FinancialEntry.h"
+#include <QDate>
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace GymOS::Infrastructure::Reports {
+
+using namespace GymOS::Core::Models;
+
+/**
+ * @brief Exporta el libro de movimientos a archivo en segundo plano
+ *
+ * Recorre `financial_entries` de un rango de fechas con un cursor
+ * forward-only (FinancialEntryRepository::forEachInRange) desde un hilo de
+ * trabajo con su propia conexión de solo lectura, y escribe cada fila a
+ * medida que la lee: la memoria usada no depende del tamaño del libro.
+ *
+ * Formatos:
+ * - Csv: UTF-8 con BOM (Excel lo abre con acentos correctos).
+ * - Columnar: archivo binario por columnas en grupos de filas (ver
+ *   ColumnarWriter en el .cpp), para cargar el libro en herramientas de
+ *   análisis sin parsear texto.
+ *
+ * El archivo se escribe con QSaveFile: si la exportación falla o se
+ * cancela, el destino queda como estaba.
+ */
+class FinancialReportExporter : public QObject {
+  Q_OBJECT
+
+public:
+  enum class Format { Csv, Columnar };
+
+  /// Filas entre notificaciones de progreso
+  static constexpr int kProgressInterval = 2000;
+  /// Filas por grupo en el formato columnar
+  static constexpr int kRowGroupSize = 8192;
+
+  explicit FinancialReportExporter(QObject *parent = nullptr);
+
+  [[nodiscard]] static QString extension(Format format);
+
+  /**
+   * @brief Inicia la exportación (no hace nada si ya hay una en curso)
+   * @return false si ya había una exportación en curso
+   */
+  bool start(const QDate &from, const QDate &to, Format format,
+             const QString &path);
+
+  /**
+   * @brief Pide detener la exportación en curso
+   */
+  void cancel();
+
+  [[nodiscard]] bool isRunning() const { return m_running; }
+
+signals:
+  void runningChanged();
+  void progress(qint64 written, qint64 total);
+  void finished(const QString &path, qint64 rows);
+  void failed(const QString &error);
+
+private:
+  struct Result {
+    qint64 rows = 0;
+    bool cancelled = false;
+    QString error;
+  };
+
+  static Result run(const QDate &from, const QDate &to, Format format,
+                    const QString &path,
+                    const std::shared_ptr<std::atomic<bool>> &cancelled,
+                    const std::function<void(qint64, qint64)> &onProgress);
+
+  bool m_running = false;
+  std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+} // namespace GymOS::Infrastructure::Reports
@@ -0,0 +1,268 @@
+#include "StatementEngine.h"
+#include "../database/DatabaseManager.h"
+#include "../diagnostics/Logging.h"
+#include "../diagnostics/Tracer.h"
+#include <QDate>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QHash>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace GymOS::Infrastructure::Reports {
+
+using GymOS::Infrastructure::Database::DatabaseManager;
+
+namespace {
+
+/**
+ * @brief Agregados de un worker
+ *
+ * `months` tiene una posición por partición; cada partición la procesa un
+ * solo worker, así que al combinar basta con sumar.
+ */
+struct Partial {
+  std::vector<StatementMonth> months;
+  std::map<std::pair<int, int64_t>, StatementPlan> plans; ///< (año, plan)
+  std::vector<QHash<int64_t, int64_t>> members; ///< Por año: miembro → cents
+  QString error;
+};
+
+/**
+ * @brief Particiones pendientes, compartidas entre los workers
+ */
+struct Job {
+  int fromYear = 0;
+  int partitions = 0;
+  std::atomic<int> next{0};
+};
+
+QDate partitionStart(const Job &job, int partition) {
+  return QDate(job.fromYear + partition / 12, partition % 12 + 1, 1);
+}
+
+Partial scan(const std::shared_ptr<Job> &job, int worker) {
+  GYM_TRACE_SCOPE("finance", "StatementEngine::scan");
+
+  Partial partial;
+  partial.months.resize(job->partitions);
+  partial.members.resize(job->partitions / 12);
+
+  const QString connection = QString("gymos_statement_%1").arg(worker);
+  {
+    QSqlDatabase db =
+        DatabaseManager::instance().openWorkerConnection(connection);
+    if (!db.isOpen()) {
+      partial.error = "No se pudo abrir la base de datos";
+    } else {
+      QSqlQuery query(db);
+      query.setForwardOnly(true);
+      query.prepare(R"(
+            SELECT f.classification,
+                   COALESCE(s.plan_id, 0) AS plan_id,
+                   COALESCE(s.member_id, 0) AS member_id,
+                   SUM(CAST(ROUND(f.amount * 100) AS INTEGER)) AS cents,
+                   COUNT(*) AS entries
+            FROM financial_entries f
+            LEFT JOIN payments p ON p.id = f.payment_id
+            LEFT JOIN subscriptions s ON s.id = p.subscription_id
+            WHERE f.entry_date BETWEEN ? AND ?
+            GROUP BY f.classification, plan_id, member_id
+        )");
+
+      for (int partition = job->next.fetch_add(1);
+           partition < job->partitions; partition = job->next.fetch_add(1)) {
+        const QDate from = partitionStart(*job, partition);
+        const QDate to = from.addMonths(1).addDays(-1);
+        query.addBindValue(from.toString(Qt::ISODate));
+        query.addBindValue(to.toString(Qt::ISODate));
+        if (!query.exec()) {
+          partial.error = query.lastError().text();
+          break;
+        }
+
+        const int yearIndex = partition / 12;
+        StatementMonth &month = partial.months[partition];
+        month.year = from.year();
+        month.month = from.month();
+        while (query.next()) {
+          const bool expense = query.value(0).toString() == "expense";
+          const int64_t planId = query.value(1).toLongLong();
+          const int64_t memberId = query.value(2).toLongLong();
+          const int64_t cents = query.value(3).toLongLong();
+          const int64_t count = query.value(4).toLongLong();
+
+          month.count += count;
+          if (expense) {
+            month.expenseCents += cents;
+            continue;
+          }
+          month.incomeCents += cents;
+
+          StatementPlan &plan = partial.plans[{from.year(), planId}];
+          plan.revenueCents += cents;
+          plan.count += count;
+          if (memberId > 0) {
+            partial.members[yearIndex][memberId] += cents;
+          }
+        }
+      }
+    }
+  }
+  DatabaseManager::closeWorkerConnection(connection);
+  return partial;
+}
+
+struct Result {
+  Statement statement;
+  QString error;
+};
+
+Result merge(const Job &job, const QList<QFuture<Partial>> &futures) {
+  Result result;
+  Statement &statement = result.statement;
+  statement.fromYear = job.fromYear;
+  statement.toYear = job.fromYear + job.partitions / 12 - 1;
+  statement.partitions = job.partitions;
+  statement.workers = static_cast<int>(futures.size());
+
+  std::vector<QHash<int64_t, int64_t>> members(job.partitions / 12);
+  std::map<std::pair<int, int64_t>, StatementPlan> plans;
+  statement.months.resize(job.partitions);
+  for (int partition = 0; partition < job.partitions; ++partition) {
+    const QDate from = partitionStart(job, partition);
+    statement.months[partition].year = from.year();
+    statement.months[partition].month = from.month();
+  }
+
+  for (const QFuture<Partial> &future : futures) {
+    const Partial partial = future.result();
+    if (!partial.error.isEmpty()) {
+      result.error = partial.error;
+      return result;
+    }
+    for (int partition = 0; partition < job.partitions; ++partition) {
+      StatementMonth &month = statement.months[partition];
+      month.incomeCents += partial.months[partition].incomeCents;
+      month.expenseCents += partial.months[partition].expenseCents;
+      month.count += partial.months[partition].count;
+    }
+    for (const auto &[key, plan] : partial.plans) {
+      StatementPlan &total = plans[key];
+      total.revenueCents += plan.revenueCents;
+      total.count += plan.count;
+    }
+    for (size_t year = 0; year < members.size(); ++year) {
+      for (auto it = partial.members[year].cbegin();
+           it != partial.members[year].cend(); ++it) {
+        members[year][it.key()] += it.value();
+      }
+    }
+  }
+
+  // Totales por año y valor de cada miembro en todo el período
+  QHash<int64_t, int64_t> lifetime;
+  for (size_t index = 0; index < members.size(); ++index) {
+    StatementYear year;
+    year.year = job.fromYear + static_cast<int>(index);
+    for (int month = 0; month < 12; ++month) {
+      const StatementMonth &totals = statement.months[index * 12 + month];
+      year.incomeCents += totals.incomeCents;
+      year.expenseCents += totals.expenseCents;
+      year.count += totals.count;
+    }
+    year.payingMembers = members[index].size();
+    for (auto it = members[index].cbegin(); it != members[index].cend();
+         ++it) {
+      year.memberRevenueCents += it.value();
+      lifetime[it.key()] += it.value();
+    }
+    statement.years.push_back(year);
+  }
+
+  for (const auto &[key, plan] : plans) {
+    StatementPlan row = plan;
+    row.year = key.first;
+    row.planId = key.second;
+    statement.plans.push_back(row);
+  }
+  std::sort(statement.plans.begin(), statement.plans.end(),
+            [](const StatementPlan &a, const StatementPlan &b) {
+              return a.year != b.year ? a.year < b.year
+                                      : a.revenueCents > b.revenueCents;
+            });
+
+  std::vector<StatementMember> ranking;
+  ranking.reserve(lifetime.size());
+  for (auto it = lifetime.cbegin(); it != lifetime.cend(); ++it) {
+    ranking.push_back({it.key(), it.value()});
+    statement.memberRevenueCents += it.value();
+  }
+  statement.payingMembers = static_cast<int64_t>(ranking.size());
+  const size_t top = std::min(
+      ranking.size(), static_cast<size_t>(StatementEngine::kTopMembers));
+  std::partial_sort(ranking.begin(), ranking.begin() + top, ranking.end(),
+                    [](const StatementMember &a, const StatementMember &b) {
+                      return a.revenueCents > b.revenueCents;
+                    });
+  ranking.resize(top);
+  statement.topMembers = std::move(ranking);
+  return result;
+}
+
+} // namespace
+
+StatementEngine::StatementEngine(QObject *parent) : QObject(parent) {
+  m_pool.setMaxThreadCount(QThread::idealThreadCount());
+}
+
+bool StatementEngine::start(int fromYear, int toYear) {
+  if (m_running || fromYear > toYear || fromYear < 1900) {
+    return false;
+  }
+  m_running = true;
+  emit runningChanged();
+
+  auto job = std::make_shared<Job>();
+  job->fromYear = fromYear;
+  job->partitions = (toYear - fromYear + 1) * 12;
+
+  const int workers = std::min(m_pool.maxThreadCount(), job->partitions);
+  QList<QFuture<Partial>> futures;
+  for (int worker = 0; worker < workers; ++worker) {
+    futures.append(QtConcurrent::run(&m_pool, scan, job, worker));
+  }
+
+  auto timer = std::make_shared<QElapsedTimer>();
+  timer->start();
+
+  QtFuture::whenAll(futures.begin(), futures.end())
+      .then([job](const QList<QFuture<Partial>> &results) {
+        return merge(*job, results);
+      })
+      .then(this, [this, timer](Result result) {
+        m_running = false;
+        emit runningChanged();
+        if (!result.error.isEmpty()) {
+          qCWarning(lcFinance) << "Error generando el estado:" << result.error;
+          emit failed(result.error);
+          return;
+        }
+        Statement &statement = result.statement;
+        statement.elapsedMs = timer->elapsed();
+        qCInfo(lcFinance) << "Estado" << statement.fromYear << "-"
+                          << statement.toYear << "en" << statement.elapsedMs
+                          << "ms con" << statement.workers << "hilos";
+        emit finished(statement);
+      });
+  return true;
+}
+
+} // namespace GymOS::Infrastructure::Reports
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <cstdint>
+#include <vector>
+
+namespace GymOS::Infrastructure::Reports {
+
+/**
+ * @brief Totales de un mes del estado (montos en centavos)
+ */
+struct StatementMonth {
+  int year = 0;
+  int month = 0;
+  int64_t incomeCents = 0;
+  int64_t expenseCents = 0;
+  int64_t count = 0;
+};
+
+/**
+ * @brief Ingresos de un plan en un año
+ */
+struct StatementPlan {
+  int year = 0;
+  int64_t planId = 0; ///< 0 = movimientos sin plan
+  int64_t revenueCents = 0;
+  int64_t count = 0;
+};
+
+/**
+ * @brief Totales de un año
+ */
+struct StatementYear {
+  int year = 0;
+  int64_t incomeCents = 0;
+  int64_t expenseCents = 0;
+  int64_t count = 0;
+  int64_t payingMembers = 0;      ///< Miembros con al menos un pago
+  int64_t memberRevenueCents = 0; ///< Ingresos enlazados a un miembro
+};
+
+/**
+ * @brief Ingresos acumulados de un miembro en el período del estado
+ */
+struct StatementMember {
+  int64_t memberId = 0;
+  int64_t revenueCents = 0;
+};
+
+/**
+ * @brief Estado financiero de varios años
+ */
+struct Statement {
+  int fromYear = 0;
+  int toYear = 0;
+  std::vector<StatementMonth> months; ///< Todos los meses, en orden
+  std::vector<StatementYear> years;
+  std::vector<StatementPlan> plans; ///< Por año, de mayor a menor ingreso
+  /// Miembros de mayor valor (ingresos en todo el período)
+  std::vector<StatementMember> topMembers;
+  int64_t payingMembers = 0;
+  int64_t memberRevenueCents = 0;
+  int partitions = 0;
+  int workers = 0;
+  qint64 elapsedMs = 0;
+};
+
+/**
+ * @brief Genera estados financieros de varios años en paralelo
+ *
+ * El rango se divide en particiones de un mes. Se lanzan tantos workers
+ * como núcleos (sin superar la cantidad de particiones) en un pool propio;
+ * cada uno abre su conexión de solo lectura y toma particiones de un
+ * contador compartido hasta agotarlas, de modo que un mes con muchos
+ * movimientos no deja a los demás hilos esperando. Cada worker acumula sus
+ * agregados parciales y al terminar todos se combinan fuera del hilo de la
+ * UI.
+ *
+ * Por partición se ejecuta una sola consulta agrupada sobre
+ * `financial_entries` (índice por fecha) con el plan y el miembro del pago
+ * enlazado, de la que salen los totales del mes, los ingresos por plan y
+ * los ingresos por miembro.
+ */
+class StatementEngine : public QObject {
+  Q_OBJECT
+
+public:
+  /// Miembros incluidos en Statement::topMembers
+  static constexpr int kTopMembers = 10;
+
+  explicit StatementEngine(QObject *parent = nullptr);
+
+  /**
+   * @brief Inicia el cálculo de los años [fromYear, toYear]
+   * @return false si ya hay un cálculo en curso o el rango es inválido
+   */
+  bool start(int fromYear, int toYear);
+
+  [[nodiscard]] bool isRunning() const { return m_running; }
+
+signals:
+  void runningChanged();
+  void finished(const GymOS::Infrastructure::Reports::Statement &statement);
+  void failed(const QString &error);
+
+private:
+  QThreadPool m_pool;
+  bool m_running = false;
+};
+
+} // namespace GymOS::Infrastructure::Reports
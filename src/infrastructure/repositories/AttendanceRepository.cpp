@@ -0,0 +1,161 @@
+#include "AttendanceRepository.h"
+#include "../diagnostics/Logging.h"
+#include "../diagnostics/Tracer.h"
+#include <QSqlError>
+
+namespace GymOS::Infrastructure::Repositories {
+
+AttendanceRepository::AttendanceRepository()
+    : m_db(DatabaseManager::instance()) {}
+
+void AttendanceRepository::prepareInsert(
+    QSqlQuery &query, const std::vector<Attendance> &records) {
+  QVariantList memberIds;
+  QVariantList timestamps;
+  QVariantList granted;
+  memberIds.reserve(static_cast<qsizetype>(records.size()));
+  timestamps.reserve(static_cast<qsizetype>(records.size()));
+  granted.reserve(static_cast<qsizetype>(records.size()));
+  for (const Attendance &record : records) {
+    memberIds << record.memberId;
+    timestamps << record.checkedInAt.toString(Qt::ISODate);
+    granted << (record.granted ? 1 : 0);
+  }
+
+  query.prepare("INSERT INTO attendance (member_id, checked_in_at, granted) "
+                "VALUES (?, ?, ?)");
+  query.addBindValue(memberIds);
+  query.addBindValue(timestamps);
+  query.addBindValue(granted);
+}
+
+bool AttendanceRepository::insertMany(const std::vector<Attendance> &records) {
+  if (records.empty()) {
+    return true;
+  }
+  GYM_TRACE_SCOPE("sql", "attendance.insertMany");
+
+  // Si el llamador ya abrió una transacción, el lote se suma a ella
+  const bool ownsTransaction = m_db.beginTransaction();
+
+  QSqlQuery query(m_db.database());
+  prepareInsert(query, records);
+
+  if (!query.execBatch()) {
+    qCWarning(lcDatabase) << "Error insertando asistencia:"
+                          << query.lastError().text();
+    if (ownsTransaction) {
+      m_db.rollbackTransaction();
+    }
+    return false;
+  }
+
+  if (ownsTransaction && !m_db.commitTransaction()) {
+    qCWarning(lcDatabase) << "Error confirmando asistencia:"
+                          << m_db.database().lastError().text();
+    m_db.rollbackTransaction();
+    return false;
+  }
+  return true;
+}
+
+bool AttendanceRepository::insertMany(QSqlDatabase &db,
+                                      const std::vector<Attendance> &records) {
+  if (records.empty()) {
+    return true;
+  }
+  GYM_TRACE_SCOPE("sql", "attendance.insertMany.worker");
+
+  if (!db.transaction()) {
+    qCWarning(lcDatabase) << "Error iniciando la transacción de asistencia:"
+                          << db.lastError().text();
+    return false;
+  }
+
+  QSqlQuery query(db);
+  prepareInsert(query, records);
+
+  if (!query.execBatch() || !db.commit()) {
+    qCWarning(lcDatabase) << "Error guardando asistencia:"
+                          << query.lastError().text();
+    db.rollback();
+    return false;
+  }
+  return true;
+}
+
+std::vector<Attendance> AttendanceRepository::findByMember(int64_t memberId,
+                                                           int limit) const {
+  std::vector<Attendance> records;
+  QSqlQuery query = m_db.executeQuery(
+      "SELECT * FROM attendance WHERE member_id = ? "
+      "ORDER BY checked_in_at DESC LIMIT ?",
+      {memberId, limit});
+
+  while (query.next()) {
+    records.push_back(mapRow(query));
+  }
+  return records;
+}
+
+std::vector<HourlyAttendance> AttendanceRepository::countByHourOfWeek() const {
+  std::vector<HourlyAttendance> counts;
+  QSqlQuery query = m_db.executeQuery(R"(
+        SELECT CAST(strftime('%w', checked_in_at) AS INTEGER) AS weekday,
+               CAST(strftime('%H', checked_in_at) AS INTEGER) AS hour,
+               COUNT(*) AS visits
+        FROM attendance
+        WHERE granted = 1
+        GROUP BY weekday, hour
+    )");
+
+  while (query.next()) {
+    // strftime('%w') usa 0 = domingo; QDate::dayOfWeek usa 7
+    const int weekday = query.value(0).toInt();
+    counts.push_back({weekday == 0 ? 7 : weekday, query.value(1).toInt(),
+                      query.value(2).toInt()});
+  }
+  return counts;
+}
+
+std::vector<DailyAttendance>
+AttendanceRepository::countDailyByMember(const QDate &since) const {
+  std::vector<DailyAttendance> counts;
+  QString sql = R"(
+        SELECT member_id, date(checked_in_at) AS day, COUNT(*) AS visits
+        FROM attendance
+        WHERE granted = 1 AND checked_in_at >= ?
+        GROUP BY member_id, day
+    )";
+
+  QSqlQuery query = m_db.executeQuery(sql, {since.toString(Qt::ISODate)});
+
+  while (query.next()) {
+    counts.push_back(
+        {query.value(0).toLongLong(),
+         QDate::fromString(query.value(1).toString(), Qt::ISODate),
+         query.value(2).toInt()});
+  }
+  return counts;
+}
+
+QDate AttendanceRepository::firstCheckInDate() const {
+  QSqlQuery query = m_db.executeQuery(
+      "SELECT date(MIN(checked_in_at)) FROM attendance WHERE granted = 1");
+  if (query.next() && !query.value(0).isNull()) {
+    return QDate::fromString(query.value(0).toString(), Qt::ISODate);
+  }
+  return {};
+}
+
+Attendance AttendanceRepository::mapRow(QSqlQuery &query) const {
+  Attendance record;
+  record.id = query.value("id").toLongLong();
+  record.memberId = query.value("member_id").toLongLong();
+  record.checkedInAt = QDateTime::fromString(
+      query.value("checked_in_at").toString(), Qt::ISODate);
+  record.granted = query.value("granted").toInt() != 0;
+  return record;
+}
+
+} // namespace GymOS::Infrastructure::Repositories
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../../core/models/Attendance.h"
+#include "../database/DatabaseManager.h"
+#include <QSqlQuery>
+#include <vector>
+
+namespace GymOS::Infrastructure::Repositories {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Database;
+
+/**
+ * @brief Repositorio de Asistencia
+ *
+ * La tabla attendance es append-only: no hay métodos de update o delete.
+ */
+class AttendanceRepository {
+public:
+  AttendanceRepository();
+
+  /**
+   * @brief Inserta un lote de registros con una sola sentencia preparada
+   *
+   * Abre su propia transacción salvo que ya haya una en curso.
+   * @return true si se insertaron todos los registros
+   */
+  bool insertMany(const std::vector<Attendance> &records);
+
+  /**
+   * @brief Inserta un lote sobre una conexión explícita, en su propia
+   * transacción (hilo de trabajo)
+   */
+  static bool insertMany(QSqlDatabase &db,
+                         const std::vector<Attendance> &records);
+
+  /**
+   * @brief Obtiene los últimos ingresos de un miembro
+   */
+  [[nodiscard]] std::vector<Attendance> findByMember(int64_t memberId,
+                                                     int limit = 50) const;
+
+  /**
+   * @brief Cuenta los ingresos permitidos por día de la semana y hora
+   */
+  [[nodiscard]] std::vector<HourlyAttendance> countByHourOfWeek() const;
+
+  /**
+   * @brief Cuenta los ingresos permitidos por miembro y día desde una fecha
+   */
+  [[nodiscard]] std::vector<DailyAttendance>
+  countDailyByMember(const QDate &since) const;
+
+  /**
+   * @brief Fecha del primer ingreso registrado (inválida si no hay)
+   */
+  [[nodiscard]] QDate firstCheckInDate() const;
+
+private:
+  /**
+   * @brief Prepara el INSERT del lote sobre `query` (sin ejecutarlo)
+   */
+  static void prepareInsert(QSqlQuery &query,
+                            const std::vector<Attendance> &records);
+
+  [[nodiscard]] Attendance mapRow(QSqlQuery &query) const;
+  DatabaseManager &m_db;
+};
+
+} // namespace GymOS::Infrastructure::Repositories
@@ -1,5 +1,8 @@
 #include "FinancialEntryRepository.h"
+#include "../diagnostics/Logging.h"
 #include <QDateTime>
+#include <QSqlError>
+#include <QStringList>
 
 namespace GymOS::Infrastructure::Repositories {
 
@@ -22,7 +25,7 @@ int64_t FinancialEntryRepository::insert(const FinancialEntry &entry) {
                              : QVariant(),
                          entry.entryDate.toString(Qt::ISODate)};
 
-  QSqlQuery query = m_db.executeQuery(sql, params);
+  PreparedQuery query = m_db.executePrepared(sql, params);
   return query.lastInsertId().toLongLong();
 }
 
@@ -49,7 +52,7 @@ FinancialEntryRepository::findLatest(int limit) const {
 
   QSqlQuery query =
       m_db.executeQuery("SELECT * FROM financial_entries ORDER BY entry_date "
-                        "DESC, created_at DESC LIMIT ?",
+                        "DESC, id DESC LIMIT ?",
                         {limit});
 
   while (query.next()) {
@@ -58,6 +61,53 @@ FinancialEntryRepository::findLatest(int limit) const {
   return entries;
 }
 
+std::vector<FinancialEntry>
+FinancialEntryRepository::findPage(const LedgerFilter &filter,
+                                   const std::optional<LedgerCursor> &after,
+                                   int limit) const {
+  QStringList conditions;
+  QVariantList params;
+
+  if (!filter.entryType.isEmpty()) {
+    conditions << "entry_type = ?";
+    params << filter.entryType;
+  }
+  if (!filter.classification.isEmpty()) {
+    conditions << "classification = ?";
+    params << filter.classification;
+  }
+  if (!filter.text.isEmpty()) {
+    QString pattern = filter.text;
+    pattern.replace('\\', "\\\\")
+        .replace('%', "\\%")
+        .replace('_', "\\_");
+    conditions << "description LIKE ? ESCAPE '\\'";
+    params << '%' + pattern + '%';
+  }
+  if (after) {
+    // `entry_date <= ?` acota el rango del índice; el OR solo descarta las
+    // filas del mismo día ya mostradas
+    const QString date = after->entryDate.toString(Qt::ISODate);
+    conditions << "entry_date <= ? AND (entry_date < ? OR id < ?)";
+    params << date << date << static_cast<qint64>(after->id);
+  }
+
+  QString sql = "SELECT * FROM financial_entries";
+  if (!conditions.isEmpty()) {
+    sql += " WHERE " + conditions.join(" AND ");
+  }
+  sql += " ORDER BY entry_date DESC, id DESC LIMIT ?";
+  params << limit;
+
+  std::vector<FinancialEntry> entries;
+  entries.reserve(limit);
+  QSqlQuery query = m_db.executeQuery(sql, params);
+  while (query.next()) {
+    entries.push_back(mapRow(query));
+  }
+  return entries;
+}
+
 std::vector<FinancialEntry>
 FinancialEntryRepository::findByClassification(Classification classification,
                                                const QDate &startDate,
@@ -159,7 +209,84 @@ FinancialEntryRepository::getMonthlyBreakdown(const QDate &startDate,
   return breakdown;
 }
 
-FinancialEntry FinancialEntryRepository::mapRow(QSqlQuery &query) const {
+int64_t FinancialEntryRepository::countByDateRange(const QSqlDatabase &db,
+                                                   const QDate &startDate,
+                                                   const QDate &endDate) {
+  QSqlQuery query(db);
+  query.prepare("SELECT COUNT(*) FROM financial_entries "
+                "WHERE entry_date BETWEEN ? AND ?");
+  query.addBindValue(startDate.toString(Qt::ISODate));
+  query.addBindValue(endDate.toString(Qt::ISODate));
+  if (!query.exec() || !query.next()) {
+    return 0;
+  }
+  return query.value(0).toLongLong();
+}
+
+bool FinancialEntryRepository::forEachInRange(
+    const QSqlDatabase &db, const QDate &startDate, const QDate &endDate,
+    const std::function<bool(const FinancialEntry &)> &fn) {
+  QSqlQuery query(db);
+  query.setForwardOnly(true); // Sin caché de filas en el driver
+  query.prepare(R"(SELECT * FROM financial_entries
+                   WHERE entry_date BETWEEN ? AND ?
+                   ORDER BY entry_date, id)");
+  query.addBindValue(startDate.toString(Qt::ISODate));
+  query.addBindValue(endDate.toString(Qt::ISODate));
+  if (!query.exec()) {
+    qCWarning(lcDatabase) << "Error al recorrer financial_entries:"
+                          << query.lastError().text();
+    return false;
+  }
+
+  while (query.next()) {
+    if (!fn(mapRow(query))) {
+      break;
+    }
+  }
+  return true;
+}
+
+bool FinancialEntryRepository::forEachFactAfter(
+    int64_t afterId, const std::function<void(const LedgerFact &)> &fn) const {
+  QSqlQuery query(m_db.database());
+  query.setForwardOnly(true);
+  query.prepare(R"(
+        SELECT f.id,
+               CAST(julianday(f.entry_date) + 0.5 AS INTEGER) AS jd,
+               f.entry_type,
+               f.classification,
+               CAST(ROUND(f.amount * 100) AS INTEGER) AS cents,
+               COALESCE(s.plan_id, 0) AS plan_id
+        FROM financial_entries f
+        LEFT JOIN payments p ON p.id = f.payment_id
+        LEFT JOIN subscriptions s ON s.id = p.subscription_id
+        WHERE f.id > ?
+        ORDER BY f.id
+    )");
+  query.addBindValue(static_cast<qint64>(afterId));
+  if (!query.exec()) {
+    qCWarning(lcDatabase) << "Error leyendo financial_entries:"
+                          << query.lastError().text();
+    return false;
+  }
+
+  LedgerFact fact;
+  while (query.next()) {
+    fact.id = query.value(0).toLongLong();
+    fact.julianDay = query.value(1).toInt();
+    fact.entryType =
+        FinancialEntry::entryTypeFromString(query.value(2).toString());
+    fact.classification =
+        FinancialEntry::classificationFromString(query.value(3).toString());
+    fact.amountCents = query.value(4).toLongLong();
+    fact.planId = query.value(5).toLongLong();
+    fn(fact);
+  }
+  return true;
+}
+
+FinancialEntry FinancialEntryRepository::mapRow(QSqlQuery &query) {
   FinancialEntry entry;
   entry.id = query.value("id").toLongLong();
   entry.entryType =
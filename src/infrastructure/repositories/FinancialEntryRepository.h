@@ -4,6 +4,7 @@
 #include "../database/DatabaseManager.h"
 #include <QDate>
 #include <QSqlQuery>
+#include <functional>
 #include <optional>
 #include <vector>
 
@@ -13,6 +14,41 @@ namespace GymOS::Infrastructure::Repositories {
 using namespace GymOS::Core::Models;
 using namespace GymOS::Infrastructure::Database;
 
+/**
+ * @brief Posición en el libro para la paginación por keyset
+ *
+ * Identifica la última fila de una página; la siguiente página empieza
+ * en la fila inmediatamente anterior en orden (entry_date, id).
+ */
+struct LedgerCursor {
+  QDate entryDate;
+  int64_t id = 0;
+};
+
+/**
+ * @brief Filtros del libro de movimientos (vacío = sin filtro)
+ */
+struct LedgerFilter {
+  QString entryType;      ///< Id de EntryType (p. ej. "renewal_income")
+  QString classification; ///< "income" o "expense"
+  QString text;           ///< Texto contenido en la descripción
+};
+
+/**
+ * @brief Fila del libro reducida a las dimensiones de análisis
+ *
+ * `julianDay` y `amountCents` vienen calculados por SQLite para no parsear
+ * texto por fila; `planId` es 0 si la entrada no está ligada a un pago.
+ */
+struct LedgerFact {
+  int64_t id = 0;
+  int32_t julianDay = 0;
+  EntryType entryType = EntryType::CustomIncome;
+  Classification classification = Classification::Income;
+  int64_t amountCents = 0;
+  int64_t planId = 0;
+};
+
 /**
  * @brief Repositorio de Entradas Financieras
  *
@@ -39,6 +75,20 @@ public:
    */
   [[nodiscard]] std::vector<FinancialEntry> findLatest(int limit = 10) const;
 
+  /**
+   * @brief Obtiene una página del libro, de la más reciente a la más antigua
+   *
+   * Paginación por keyset sobre (entry_date, id): cada página es un seek
+   * en los índices idx_financial_entries_ledger / _type_ledger /
+   * _classification_ledger, sin OFFSET, así que cuesta lo mismo en la
+   * primera página que después de años de movimientos.
+   *
+   * @param after Última fila de la página anterior (nullopt = primera)
+   */
+  [[nodiscard]] std::vector<FinancialEntry>
+  findPage(const LedgerFilter &filter, const std::optional<LedgerCursor> &after,
+           int limit) const;
+
   /**
    * @brief Obtiene entradas por clasificación
    */
@@ -63,8 +113,42 @@ public:
   [[nodiscard]] std::vector<MonthlyBreakdown>
   getMonthlyBreakdown(const QDate &startDate, const QDate &endDate) const;
 
+  /**
+   * @brief Cantidad de entradas en un rango de fechas
+   */
+  [[nodiscard]] static int64_t countByDateRange(const QSqlDatabase &db,
+                                                const QDate &startDate,
+                                                const QDate &endDate);
+
+  /**
+   * @brief Recorre las entradas de un rango con un cursor forward-only
+   *
+   * Las filas se leen de a una en orden (entry_date, id) y se entregan a
+   * `fn` sin acumularlas, de modo que la memoria no depende del tamaño del
+   * rango. Pensado para exportaciones desde un hilo de trabajo con su
+   * propia conexión.
+   *
+   * @param fn Recibe cada entrada; devolver false detiene el recorrido
+   * @return false si la consulta falló
+   */
+  static bool forEachInRange(const QSqlDatabase &db, const QDate &startDate,
+                             const QDate &endDate,
+                             const std::function<bool(const FinancialEntry &)>
+                                 &fn);
+
+  /**
+   * @brief Recorre las entradas con id mayor a `afterId`, en orden de id
+   *
+   * Como el libro es solo de inserción, quien guarda el último id visto
+   * puede mantenerse al día leyendo únicamente las filas nuevas.
+   * @return false si la consulta falló
+   */
+  bool
+  forEachFactAfter(int64_t afterId,
+                   const std::function<void(const LedgerFact &)> &fn) const;
+
 private:
-  [[nodiscard]] FinancialEntry mapRow(QSqlQuery &query) const;
+  [[nodiscard]] static FinancialEntry mapRow(QSqlQuery &query);
   DatabaseManager &m_db;
 };
 
@@ -0,0 +1,185 @@
+#include "LedgerSnapshotRepository.h"
+#include "../diagnostics/Logging.h"
+#include "../diagnostics/Tracer.h"
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QVariantList>
+
+namespace GymOS::Infrastructure::Repositories {
+
+namespace {
+
+/// Cota superior para consultas sin límite de fecha
+const QString kMaxDate = QStringLiteral("9999-12-31");
+
+constexpr const char *kTypeColumns[] = {
+    "enrollment_income_cents", "renewal_income_cents", "custom_income_cents",
+    "custom_expense_cents"};
+
+LedgerSnapshot mapRow(QSqlQuery &query) {
+  LedgerSnapshot snapshot;
+  snapshot.month = QDate::fromString(query.value("month").toString() + "-01",
+                                     Qt::ISODate);
+  snapshot.periodEnd =
+      QDate::fromString(query.value("period_end").toString(), Qt::ISODate);
+  snapshot.lastEntryId = query.value("last_entry_id").toLongLong();
+  snapshot.totals.incomeCents = query.value("income_cents").toLongLong();
+  snapshot.totals.expenseCents = query.value("expense_cents").toLongLong();
+  snapshot.totals.entries = query.value("entries").toLongLong();
+  for (size_t type = 0; type < snapshot.totals.typeCents.size(); ++type) {
+    snapshot.totals.typeCents[type] =
+        query.value(kTypeColumns[type]).toLongLong();
+  }
+  return snapshot;
+}
+
+} // namespace
+
+LedgerSnapshotRepository::LedgerSnapshotRepository()
+    : m_db(DatabaseManager::instance()) {}
+
+std::optional<LedgerSnapshot>
+LedgerSnapshotRepository::latestOnOrBefore(const QDate &date) const {
+  PreparedQuery query = m_db.executePrepared(
+      "SELECT * FROM ledger_snapshots WHERE period_end <= ? "
+      "ORDER BY month DESC LIMIT 1",
+      {date.isValid() ? date.toString(Qt::ISODate) : kMaxDate});
+  if (!query.next()) {
+    return std::nullopt;
+  }
+  return mapRow(query.query());
+}
+
+std::optional<LedgerTotals>
+LedgerSnapshotRepository::totalsSince(const std::optional<LedgerSnapshot> &base,
+                                      const QDate &asOf, int64_t maxId) const {
+  GYM_TRACE_SCOPE("sql", "ledger.totalsSince");
+
+  QString sql = R"(
+        SELECT classification, entry_type,
+               SUM(CAST(ROUND(amount * 100) AS INTEGER)) AS cents,
+               COUNT(*) AS entries
+        FROM (
+            SELECT classification, entry_type, amount
+            FROM financial_entries
+            WHERE entry_date > ? AND entry_date <= ? AND id <= ?
+            UNION ALL
+            SELECT classification, entry_type, amount
+            FROM financial_entries
+            WHERE id > ? AND id <= ? AND entry_date <= ?
+        )
+        GROUP BY classification, entry_type
+    )";
+
+  const QString periodEnd =
+      base ? base->periodEnd.toString(Qt::ISODate) : QString();
+  const QString until = asOf.isValid() ? asOf.toString(Qt::ISODate) : kMaxDate;
+  const qint64 lastId = base ? base->lastEntryId : 0;
+
+  PreparedQuery query = m_db.executePrepared(
+      sql, {periodEnd, until, lastId, lastId, static_cast<qint64>(maxId),
+            until});
+  if (!query.isActive()) {
+    return std::nullopt;
+  }
+
+  LedgerTotals totals;
+  while (query.next()) {
+    const int64_t cents = query.value("cents").toLongLong();
+    if (query.value("classification").toString() == "expense") {
+      totals.expenseCents += cents;
+    } else {
+      totals.incomeCents += cents;
+    }
+    const auto type = static_cast<size_t>(FinancialEntry::entryTypeFromString(
+        query.value("entry_type").toString()));
+    totals.typeCents[type] += cents;
+    totals.entries += query.value("entries").toLongLong();
+  }
+  return totals;
+}
+
+int64_t LedgerSnapshotRepository::maxEntryId() const {
+  PreparedQuery query =
+      m_db.executePrepared("SELECT COALESCE(MAX(id), 0) FROM financial_entries",
+                           {});
+  return query.next() ? query.value(0).toLongLong() : 0;
+}
+
+QDate LedgerSnapshotRepository::firstEntryDate() const {
+  PreparedQuery query = m_db.executePrepared(
+      "SELECT MIN(entry_date) FROM financial_entries", {});
+  if (!query.next()) {
+    return {};
+  }
+  return QDate::fromString(query.value(0).toString(), Qt::ISODate);
+}
+
+bool LedgerSnapshotRepository::insert(
+    const std::vector<LedgerSnapshot> &snapshots) {
+  if (snapshots.empty()) {
+    return true;
+  }
+
+  QVariantList months;
+  QVariantList periodEnds;
+  QVariantList lastIds;
+  QVariantList income;
+  QVariantList expense;
+  QVariantList balance;
+  QVariantList entries;
+  std::array<QVariantList, 4> types;
+  for (const LedgerSnapshot &snapshot : snapshots) {
+    months << snapshot.month.toString("yyyy-MM");
+    periodEnds << snapshot.periodEnd.toString(Qt::ISODate);
+    lastIds << static_cast<qint64>(snapshot.lastEntryId);
+    income << static_cast<qint64>(snapshot.totals.incomeCents);
+    expense << static_cast<qint64>(snapshot.totals.expenseCents);
+    balance << static_cast<qint64>(snapshot.totals.balanceCents());
+    entries << static_cast<qint64>(snapshot.totals.entries);
+    for (size_t type = 0; type < types.size(); ++type) {
+      types[type] << static_cast<qint64>(snapshot.totals.typeCents[type]);
+    }
+  }
+
+  // Si el llamador ya abrió una transacción, el lote se suma a ella
+  const bool ownsTransaction = m_db.beginTransaction();
+
+  QSqlQuery query(m_db.database());
+  query.prepare(R"(
+        INSERT INTO ledger_snapshots
+            (month, period_end, last_entry_id, income_cents, expense_cents,
+             closing_balance_cents, entries, enrollment_income_cents,
+             renewal_income_cents, custom_income_cents, custom_expense_cents)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+    )");
+  query.addBindValue(months);
+  query.addBindValue(periodEnds);
+  query.addBindValue(lastIds);
+  query.addBindValue(income);
+  query.addBindValue(expense);
+  query.addBindValue(balance);
+  query.addBindValue(entries);
+  for (const QVariantList &values : types) {
+    query.addBindValue(values);
+  }
+
+  if (!query.execBatch()) {
+    qCWarning(lcDatabase) << "Error insertando cierres del libro:"
+                          << query.lastError().text();
+    if (ownsTransaction) {
+      m_db.rollbackTransaction();
+    }
+    return false;
+  }
+
+  if (ownsTransaction && !m_db.commitTransaction()) {
+    qCWarning(lcDatabase) << "Error confirmando cierres del libro:"
+                          << m_db.database().lastError().text();
+    m_db.rollbackTransaction();
+    return false;
+  }
+  return true;
+}
+
+} // namespace GymOS::Infrastructure::Repositories
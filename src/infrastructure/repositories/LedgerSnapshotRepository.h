@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../../core/models/LedgerSnapshot.h"
+#include "../database/DatabaseManager.h"
+#include <optional>
+#include <vector>
+
+namespace GymOS::Infrastructure::Repositories {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Database;
+
+/**
+ * @brief Repositorio de cierres mensuales del libro (ledger_snapshots)
+ *
+ * Solo inserción y lectura: la migración 9 rechaza UPDATE y DELETE.
+ */
+class LedgerSnapshotRepository {
+public:
+  LedgerSnapshotRepository();
+
+  /**
+   * @brief Último cierre con período terminado en o antes de `date`
+   * @param date Inválida = el último cierre
+   */
+  [[nodiscard]] std::optional<LedgerSnapshot>
+  latestOnOrBefore(const QDate &date) const;
+
+  /**
+   * @brief Totales de los movimientos hasta `asOf` que `base` no incluye
+   *
+   * Dos tramos sin solapamiento: los de fecha posterior al cierre con id
+   * <= base.lastEntryId (índice por fecha) y los de id mayor que
+   * base.lastEntryId (clave primaria), ambos limitados a `maxId`. Sin
+   * cierre, recorre todo el libro.
+   * @param asOf Inválida = sin límite de fecha
+   * @return nullopt si la consulta falló
+   */
+  [[nodiscard]] std::optional<LedgerTotals>
+  totalsSince(const std::optional<LedgerSnapshot> &base, const QDate &asOf,
+              int64_t maxId) const;
+
+  /**
+   * @brief Mayor id del libro (0 si está vacío)
+   */
+  [[nodiscard]] int64_t maxEntryId() const;
+
+  /**
+   * @brief Fecha del movimiento más antiguo (inválida si no hay)
+   */
+  [[nodiscard]] QDate firstEntryDate() const;
+
+  /**
+   * @brief Inserta cierres en una sola transacción (o en la del llamador)
+   */
+  bool insert(const std::vector<LedgerSnapshot> &snapshots);
+
+private:
+  DatabaseManager &m_db;
+};
+
+} // namespace GymOS::Infrastructure::Repositories
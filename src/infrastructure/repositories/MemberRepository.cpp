@@ -1,6 +1,10 @@
 #include "MemberRepository.h"
+#include "../diagnostics/Logging.h"
 #include <QDateTime>
 #include <QJsonDocument>
+#include <QSqlError>
+#include <QStringList>
+#include <algorithm>
 
 namespace GymOS::Infrastructure::Repositories {
 
@@ -79,7 +83,7 @@ bool MemberRepository::remove(int64_t id) {
       "SELECT COUNT(*) FROM subscriptions WHERE member_id = ?", {id});
 
   if (checkQuery.next() && checkQuery.value(0).toInt() > 0) {
-    qWarning()
+    qCWarning(lcDatabase)
         << "No se puede eliminar el miembro: tiene suscripciones asociadas";
     return false;
   }
@@ -109,6 +113,36 @@ MemberRepository::findByEmail(const QString &email) const {
   return std::nullopt;
 }
 
+std::vector<Member>
+MemberRepository::findByIds(const std::vector<int64_t> &ids) const {
+  // SQLite limita la cantidad de parámetros por sentencia
+  constexpr size_t kChunkSize = 500;
+
+  std::vector<Member> members;
+  members.reserve(ids.size());
+
+  for (size_t offset = 0; offset < ids.size(); offset += kChunkSize) {
+    const size_t count = std::min(kChunkSize, ids.size() - offset);
+
+    QStringList placeholders;
+    QVariantList params;
+    for (size_t i = 0; i < count; ++i) {
+      placeholders << "?";
+      params << ids[offset + i];
+    }
+
+    QSqlQuery query = m_db.executeQuery(
+        QString("SELECT * FROM members WHERE id IN (%1)")
+            .arg(placeholders.join(", ")),
+        params);
+
+    while (query.next()) {
+      members.push_back(mapRow(query));
+    }
+  }
+  return members;
+}
+
 std::vector<Member> MemberRepository::findAll() const {
   std::vector<Member> members;
   QSqlQuery query =
@@ -136,6 +170,37 @@ std::vector<Member> MemberRepository::search(const QString &searchQuery) const {
   return members;
 }
 
+MemberRepository::CardAssignment
+MemberRepository::setCardCode(int64_t id, const QString &cardCode) {
+  QSqlQuery query = m_db.executeQuery(
+      "UPDATE members SET card_code = ?, updated_at = datetime('now') "
+      "WHERE id = ?",
+      {cardCode.isEmpty() ? QVariant() : QVariant(cardCode), id});
+
+  const QSqlError error = query.lastError();
+  if (error.isValid()) {
+    // SQLITE_CONSTRAINT (19) o, con códigos extendidos,
+    // SQLITE_CONSTRAINT_UNIQUE (2067): índice único de card_code
+    const QString code = error.nativeErrorCode();
+    return code == "19" || code == "2067" ? CardAssignment::Taken
+                                          : CardAssignment::Failed;
+  }
+  return query.numRowsAffected() > 0 ? CardAssignment::Assigned
+                                     : CardAssignment::NotFound;
+}
+
+std::vector<std::pair<QString, int64_t>>
+MemberRepository::findCardCodes() const {
+  std::vector<std::pair<QString, int64_t>> codes;
+  QSqlQuery query = m_db.executeQuery(
+      "SELECT card_code, id FROM members WHERE card_code IS NOT NULL");
+
+  while (query.next()) {
+    codes.emplace_back(query.value(0).toString(), query.value(1).toLongLong());
+  }
+  return codes;
+}
+
 int MemberRepository::count() const {
   QSqlQuery query = m_db.executeQuery("SELECT COUNT(*) FROM members");
   if (query.next()) {
@@ -173,6 +238,9 @@ Member MemberRepository::mapRow(QSqlQuery &query) const {
   if (!query.value("observations").isNull()) {
     member.observations = query.value("observations").toString();
   }
+  if (!query.value("card_code").isNull()) {
+    member.cardCode = query.value("card_code").toString();
+  }
 
   member.createdAt =
       QDateTime::fromString(query.value("created_at").toString(), Qt::ISODate);
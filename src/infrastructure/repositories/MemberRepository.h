@@ -4,6 +4,7 @@
 #include "../database/DatabaseManager.h"
 #include <QSqlQuery>
 #include <optional>
+#include <utility>
 #include <vector>
 
 
@@ -49,6 +50,12 @@ public:
    */
   [[nodiscard]] std::optional<Member> findByEmail(const QString &email) const;
 
+  /**
+   * @brief Busca varios miembros por ID (consulta por conjuntos)
+   */
+  [[nodiscard]] std::vector<Member>
+  findByIds(const std::vector<int64_t> &ids) const;
+
   /**
    * @brief Obtiene todos los miembros
    */
@@ -59,6 +66,26 @@ public:
    */
   [[nodiscard]] std::vector<Member> search(const QString &query) const;
 
+  /**
+   * @brief Resultado de setCardCode()
+   */
+  enum class CardAssignment {
+    Assigned, ///< Tarjeta asignada (o quitada)
+    NotFound, ///< No hay miembro con ese id
+    Taken,    ///< El código ya pertenece a otro miembro
+    Failed    ///< Otro error de base de datos
+  };
+
+  /**
+   * @brief Asigna (o quita, con un código vacío) la tarjeta de check-in
+   */
+  CardAssignment setCardCode(int64_t id, const QString &cardCode);
+
+  /**
+   * @brief Obtiene los pares (código de tarjeta, ID de miembro)
+   */
+  [[nodiscard]] std::vector<std::pair<QString, int64_t>> findCardCodes() const;
+
   /**
    * @brief Cuenta el total de miembros
    */
@@ -0,0 +1,235 @@
+#include "OutboxRepository.h"
+#include "../diagnostics/Logging.h"
+#include "../diagnostics/Tracer.h"
+#include <QSqlError>
+
+namespace GymOS::Infrastructure::Repositories {
+
+namespace {
+
+QVariant nullIfEmpty(const QString &value) {
+  return value.isEmpty() ? QVariant() : QVariant(value);
+}
+
+} // namespace
+
+OutboxRepository::OutboxRepository() : m_db(DatabaseManager::instance()) {}
+
+int OutboxRepository::enqueue(const std::vector<Reminder> &reminders) {
+  if (reminders.empty()) {
+    return 0;
+  }
+  GYM_TRACE_SCOPE("sql", "outbox.enqueue");
+
+  QVariantList memberIds, subscriptionIds, windows, expiryDates, names, plans,
+      phones, emails, messages;
+  for (const Reminder &reminder : reminders) {
+    memberIds << reminder.memberId;
+    subscriptionIds << reminder.subscriptionId;
+    windows << reminder.windowDays;
+    expiryDates << reminder.expiryDate.toString(Qt::ISODate);
+    names << reminder.memberName;
+    plans << reminder.planName;
+    phones << nullIfEmpty(reminder.phone);
+    emails << nullIfEmpty(reminder.email);
+    messages << reminder.message;
+  }
+
+  // total_changes() permite contar cuántas filas no ignoró INSERT OR IGNORE
+  auto totalChanges = [this] {
+    QSqlQuery query = m_db.executeQuery("SELECT total_changes()");
+    return query.next() ? query.value(0).toInt() : 0;
+  };
+  const int changesBefore = totalChanges();
+
+  // Si el llamador ya abrió una transacción, el lote se suma a ella
+  const bool ownsTransaction = m_db.beginTransaction();
+
+  QSqlQuery query(m_db.database());
+  query.prepare(R"(
+        INSERT OR IGNORE INTO outbox (member_id, subscription_id, window_days,
+                                      expiry_date, member_name, plan_name,
+                                      phone, email, message)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
+    )");
+  for (const QVariantList &column :
+       {memberIds, subscriptionIds, windows, expiryDates, names, plans, phones,
+        emails, messages}) {
+    query.addBindValue(column);
+  }
+
+  if (!query.execBatch()) {
+    qCWarning(lcDatabase) << "Error encolando recordatorios:"
+                          << query.lastError().text();
+    if (ownsTransaction) {
+      m_db.rollbackTransaction();
+    }
+    return -1;
+  }
+
+  if (ownsTransaction && !m_db.commitTransaction()) {
+    qCWarning(lcDatabase) << "Error confirmando recordatorios:"
+                          << m_db.database().lastError().text();
+    m_db.rollbackTransaction();
+    return -1;
+  }
+  return totalChanges() - changesBefore;
+}
+
+std::vector<Reminder> OutboxRepository::findByStatus(ReminderStatus status,
+                                                     int limit) const {
+  std::vector<Reminder> reminders;
+  QSqlQuery query = m_db.executeQuery(
+      "SELECT * FROM outbox WHERE status = ? ORDER BY id LIMIT ?",
+      {Reminder::statusToString(status), limit});
+  while (query.next()) {
+    reminders.push_back(mapRow(query));
+  }
+  return reminders;
+}
+
+int OutboxRepository::countByStatus(ReminderStatus status) const {
+  QSqlQuery query =
+      m_db.executeQuery("SELECT COUNT(*) FROM outbox WHERE status = ?",
+                        {Reminder::statusToString(status)});
+  return query.next() ? query.value(0).toInt() : 0;
+}
+
+bool OutboxRepository::dropSuperseded(int64_t memberId,
+                                      int64_t currentSubscriptionId) {
+  QSqlQuery query = m_db.executeQuery(
+      "DELETE FROM outbox WHERE member_id = ? AND subscription_id <> ? "
+      "AND status = 'pending'",
+      {static_cast<qint64>(memberId),
+       static_cast<qint64>(currentSubscriptionId)});
+  return !query.lastError().isValid();
+}
+
+std::vector<Reminder> OutboxRepository::fetchPending(const QSqlDatabase &db,
+                                                     int64_t afterId,
+                                                     int limit) {
+  std::vector<Reminder> reminders;
+  QSqlQuery query(db);
+  query.prepare("SELECT * FROM outbox WHERE status = 'pending' AND id > ? "
+                "ORDER BY id LIMIT ?");
+  query.addBindValue(static_cast<qint64>(afterId));
+  query.addBindValue(limit);
+
+  if (!query.exec()) {
+    qCWarning(lcDatabase) << "Error leyendo el outbox:"
+                          << query.lastError().text();
+    return reminders;
+  }
+  while (query.next()) {
+    reminders.push_back(mapRow(query));
+  }
+  return reminders;
+}
+
+bool OutboxRepository::claim(QSqlDatabase &db,
+                             const std::vector<Reminder> &reminders) {
+  if (reminders.empty()) {
+    return true;
+  }
+
+  QVariantList ids;
+  for (const Reminder &reminder : reminders) {
+    ids << reminder.id;
+  }
+
+  if (!db.transaction()) {
+    return false;
+  }
+
+  QSqlQuery query(db);
+  query.prepare("UPDATE outbox SET status = 'sending', attempts = attempts + 1 "
+                "WHERE id = ? AND status = 'pending'");
+  query.addBindValue(ids);
+
+  if (!query.execBatch() || !db.commit()) {
+    qCWarning(lcDatabase) << "Error reclamando el lote del outbox:"
+                          << query.lastError().text();
+    db.rollback();
+    return false;
+  }
+  return true;
+}
+
+int OutboxRepository::failInterrupted(QSqlDatabase &db) {
+  QSqlQuery query(db);
+  query.prepare("UPDATE outbox SET status = 'failed', last_error = ? "
+                "WHERE status = 'sending'");
+  query.addBindValue(QStringLiteral("Envío interrumpido: no se sabe si se "
+                                    "entregó"));
+  if (!query.exec()) {
+    qCWarning(lcDatabase) << "Error cerrando envíos interrumpidos:"
+                          << query.lastError().text();
+    return -1;
+  }
+  return query.numRowsAffected();
+}
+
+bool OutboxRepository::saveResults(QSqlDatabase &db,
+                                   const std::vector<Reminder> &reminders) {
+  if (reminders.empty()) {
+    return true;
+  }
+
+  QVariantList statuses, attempts, errors, sentAt, ids;
+  for (const Reminder &reminder : reminders) {
+    statuses << reminder.statusId();
+    attempts << reminder.attempts;
+    errors << nullIfEmpty(reminder.lastError);
+    sentAt << (reminder.sentAt.isValid()
+                   ? QVariant(reminder.sentAt.toString(Qt::ISODate))
+                   : QVariant());
+    ids << reminder.id;
+  }
+
+  if (!db.transaction()) {
+    return false;
+  }
+
+  QSqlQuery query(db);
+  query.prepare("UPDATE outbox SET status = ?, attempts = ?, last_error = ?, "
+                "sent_at = ? WHERE id = ?");
+  query.addBindValue(statuses);
+  query.addBindValue(attempts);
+  query.addBindValue(errors);
+  query.addBindValue(sentAt);
+  query.addBindValue(ids);
+
+  if (!query.execBatch() || !db.commit()) {
+    qCWarning(lcDatabase) << "Error guardando el outbox:"
+                          << query.lastError().text();
+    db.rollback();
+    return false;
+  }
+  return true;
+}
+
+Reminder OutboxRepository::mapRow(QSqlQuery &query) {
+  Reminder reminder;
+  reminder.id = query.value("id").toLongLong();
+  reminder.memberId = query.value("member_id").toLongLong();
+  reminder.subscriptionId = query.value("subscription_id").toLongLong();
+  reminder.windowDays = query.value("window_days").toInt();
+  reminder.expiryDate =
+      QDate::fromString(query.value("expiry_date").toString(), Qt::ISODate);
+  reminder.memberName = query.value("member_name").toString();
+  reminder.planName = query.value("plan_name").toString();
+  reminder.phone = query.value("phone").toString();
+  reminder.email = query.value("email").toString();
+  reminder.message = query.value("message").toString();
+  reminder.status =
+      Reminder::statusFromString(query.value("status").toString());
+  reminder.attempts = query.value("attempts").toInt();
+  reminder.lastError = query.value("last_error").toString();
+  reminder.createdAt = QDateTime::fromString(
+      query.value("created_at").toString(), Qt::ISODate);
+  reminder.sentAt =
+      QDateTime::fromString(query.value("sent_at").toString(), Qt::ISODate);
+  return reminder;
+}
+
+} // namespace GymOS::Infrastructure::Repositories
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../../core/models/Reminder.h"
+#include "../database/DatabaseManager.h"
+#include <QSqlQuery>
+#include <vector>
+
+namespace GymOS::Infrastructure::Repositories {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Database;
+
+/**
+ * @brief Repositorio del outbox de recordatorios
+ *
+ * La generación escribe desde el hilo principal; el envío lee y actualiza
+ * lotes desde un hilo de trabajo, con los métodos estáticos que reciben la
+ * conexión de ese hilo.
+ */
+class OutboxRepository {
+public:
+  OutboxRepository();
+
+  /**
+   * @brief Encola recordatorios (ignora los ya generados para la misma
+   * suscripción y ventana)
+   * @return Cantidad de recordatorios nuevos, o -1 si falló
+   */
+  int enqueue(const std::vector<Reminder> &reminders);
+
+  /**
+   * @brief Recordatorios en un estado, del más antiguo al más nuevo
+   */
+  [[nodiscard]] std::vector<Reminder> findByStatus(ReminderStatus status,
+                                                   int limit = 1000) const;
+
+  [[nodiscard]] int countByStatus(ReminderStatus status) const;
+
+  /**
+   * @brief Borra los recordatorios pendientes de las suscripciones
+   * anteriores de un miembro
+   *
+   * Al renovar, el aviso de vencimiento de la suscripción reemplazada ya
+   * no corresponde: no debe enviarse, exportarse ni reintentarse.
+   * @return false si la consulta falló
+   */
+  bool dropSuperseded(int64_t memberId, int64_t currentSubscriptionId);
+
+  /**
+   * @brief Lote de pendientes con id mayor a `afterId` (hilo de trabajo)
+   */
+  [[nodiscard]] static std::vector<Reminder>
+  fetchPending(const QSqlDatabase &db, int64_t afterId, int limit);
+
+  /**
+   * @brief Reclama un lote antes de enviarlo (hilo de trabajo)
+   *
+   * En una transacción pasa los recordatorios a `sending` y suma un
+   * intento, así un lote cuyo resultado no llega a guardarse no vuelve a
+   * enviarse como pendiente.
+   */
+  static bool claim(QSqlDatabase &db, const std::vector<Reminder> &reminders);
+
+  /**
+   * @brief Marca como fallidos los recordatorios que quedaron en `sending`
+   * por un envío interrumpido (hilo de trabajo)
+   *
+   * No se sabe si llegaron a entregarse; no se reintentan.
+   * @return Cantidad de recordatorios marcados, o -1 si falló
+   */
+  static int failInterrupted(QSqlDatabase &db);
+
+  /**
+   * @brief Guarda estado, intentos y error de un lote en una transacción
+   * (hilo de trabajo)
+   */
+  static bool saveResults(QSqlDatabase &db,
+                          const std::vector<Reminder> &reminders);
+
+private:
+  [[nodiscard]] static Reminder mapRow(QSqlQuery &query);
+  DatabaseManager &m_db;
+};
+
+} // namespace GymOS::Infrastructure::Repositories
@@ -0,0 +1,45 @@
+#include "PaymentRepository.h"
+#include <QSqlError>
+
+namespace GymOS::Infrastructure::Repositories {
+
+namespace {
+
+const QString kInsertSql = R"(
+        INSERT INTO payments (subscription_id, amount, payment_date, payment_type, notes)
+        VALUES (?, ?, ?, ?, ?)
+    )";
+
+} // namespace
+
+PaymentRepository::PaymentRepository() : m_db(DatabaseManager::instance()) {}
+
+int64_t PaymentRepository::insert(const Payment &payment) {
+  PreparedQuery query = m_db.executePrepared(
+      kInsertSql, {payment.subscriptionId, payment.amount,
+                   payment.paymentDate.toString(Qt::ISODate),
+                   payment.paymentTypeId(),
+                   payment.notes.isEmpty() ? QVariant() : payment.notes});
+
+  if (query.lastError().isValid()) {
+    return -1;
+  }
+  return query.lastInsertId().toLongLong();
+}
+
+double PaymentRepository::totalByMember(int64_t memberId) const {
+  QString sql = R"(
+        SELECT COALESCE(SUM(p.amount), 0)
+        FROM subscriptions s
+        JOIN payments p ON p.subscription_id = s.id
+        WHERE s.member_id = ?
+    )";
+
+  QSqlQuery query = m_db.executeQuery(sql, {memberId});
+  if (query.next()) {
+    return query.value(0).toDouble();
+  }
+  return 0.0;
+}
+
+} // namespace GymOS::Infrastructure::Repositories
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../../core/models/Payment.h"
+#include "../database/DatabaseManager.h"
+
+namespace GymOS::Infrastructure::Repositories {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Database;
+
+/**
+ * @brief Repositorio de Pagos
+ *
+ * IMPORTANTE: Este repositorio NO tiene métodos de update o delete.
+ * Los pagos son inmutables.
+ */
+class PaymentRepository {
+public:
+  PaymentRepository();
+
+  /**
+   * @brief Inserta un pago (sentencia preparada en caché)
+   * @return ID del pago insertado, -1 si falló
+   */
+  [[nodiscard]] int64_t insert(const Payment &payment);
+
+  /**
+   * @brief Suma de los pagos de todas las suscripciones de un miembro
+   */
+  [[nodiscard]] double totalByMember(int64_t memberId) const;
+
+private:
+  DatabaseManager &m_db;
+};
+
+} // namespace GymOS::Infrastructure::Repositories
@@ -0,0 +1,150 @@
+#include "RevenueRepository.h"
+#include "../diagnostics/Tracer.h"
+#include <QSqlQuery>
+#include <tuple>
+#include <utility>
+
+namespace GymOS::Infrastructure::Repositories {
+
+namespace {
+
+/**
+ * @brief Año y mes de una clave "yyyy-MM"
+ */
+std::pair<int, int> parseMonth(const QString &key) {
+  return {key.left(4).toInt(), key.mid(5, 2).toInt()};
+}
+
+QString monthKey(const QDate &date) { return date.toString("yyyy-MM"); }
+
+MemberValue mapMemberValue(QSqlQuery &query) {
+  MemberValue value;
+  value.memberId = query.value("member_id").toLongLong();
+  value.memberName = query.value("member_name").toString();
+  value.revenueCents = query.value("revenue_cents").toLongLong();
+  value.payments = query.value("payments").toInt();
+  value.renewals = query.value("renewals").toInt();
+  value.firstPayment =
+      QDate::fromString(query.value("first_payment").toString(), Qt::ISODate);
+  value.lastPayment =
+      QDate::fromString(query.value("last_payment").toString(), Qt::ISODate);
+  return value;
+}
+
+const QString kMemberValueSql = R"(
+        SELECT r.member_id, r.revenue_cents, r.payments, r.renewals,
+               r.first_payment, r.last_payment,
+               m.first_name || ' ' || m.last_name AS member_name
+        FROM member_revenue r
+        JOIN members m ON m.id = r.member_id
+    )";
+
+} // namespace
+
+RevenueRepository::RevenueRepository() : m_db(DatabaseManager::instance()) {}
+
+std::vector<PlanRevenue> RevenueRepository::planRevenue(const QDate &from,
+                                                        const QDate &to) const {
+  GYM_TRACE_SCOPE("sql", "revenue.planRevenue");
+  std::vector<PlanRevenue> rows;
+
+  QString sql = R"(
+        SELECT r.plan_id, COALESCE(p.name, '') AS plan_name, r.month,
+               r.revenue_cents, r.payments, r.renewals
+        FROM plan_revenue_monthly r
+        LEFT JOIN plans p ON p.id = r.plan_id
+        WHERE r.month BETWEEN ? AND ?
+        ORDER BY r.month, r.revenue_cents DESC
+    )";
+
+  PreparedQuery query =
+      m_db.executePrepared(sql, {monthKey(from), monthKey(to)});
+
+  while (query.next()) {
+    PlanRevenue row;
+    row.planId = query.value("plan_id").toLongLong();
+    row.planName = query.value("plan_name").toString();
+    std::tie(row.year, row.month) =
+        parseMonth(query.value("month").toString());
+    row.revenueCents = query.value("revenue_cents").toLongLong();
+    row.payments = query.value("payments").toInt();
+    row.renewals = query.value("renewals").toInt();
+    rows.push_back(row);
+  }
+  return rows;
+}
+
+std::vector<MemberValue> RevenueRepository::topMembers(int limit) const {
+  GYM_TRACE_SCOPE("sql", "revenue.topMembers");
+  std::vector<MemberValue> rows;
+
+  PreparedQuery query = m_db.executePrepared(
+      kMemberValueSql + " ORDER BY r.revenue_cents DESC LIMIT ?", {limit});
+  while (query.next()) {
+    rows.push_back(mapMemberValue(query.query()));
+  }
+  return rows;
+}
+
+std::optional<MemberValue>
+RevenueRepository::memberValue(int64_t memberId) const {
+  PreparedQuery query = m_db.executePrepared(
+      kMemberValueSql + " WHERE r.member_id = ?",
+      {static_cast<qint64>(memberId)});
+  if (query.next()) {
+    return mapMemberValue(query.query());
+  }
+  return std::nullopt;
+}
+
+std::vector<PaymentCohort> RevenueRepository::cohorts(const QDate &from,
+                                                      const QDate &to) const {
+  GYM_TRACE_SCOPE("sql", "revenue.cohorts");
+  std::vector<PaymentCohort> rows;
+
+  QString sql = R"(
+        SELECT substr(first_payment, 1, 7) AS cohort,
+               COUNT(*) AS members,
+               SUM(renewals > 0) AS renewed,
+               SUM(revenue_cents) AS revenue_cents
+        FROM member_revenue
+        WHERE first_payment BETWEEN ? AND ?
+        GROUP BY cohort
+        ORDER BY cohort
+    )";
+
+  PreparedQuery query = m_db.executePrepared(
+      sql, {from.toString(Qt::ISODate), to.toString(Qt::ISODate)});
+
+  while (query.next()) {
+    PaymentCohort cohort;
+    std::tie(cohort.year, cohort.month) =
+        parseMonth(query.value("cohort").toString());
+    cohort.members = query.value("members").toInt();
+    cohort.renewed = query.value("renewed").toInt();
+    cohort.revenueCents = query.value("revenue_cents").toLongLong();
+    rows.push_back(cohort);
+  }
+  return rows;
+}
+
+LifetimeValueSummary RevenueRepository::lifetimeSummary() const {
+  LifetimeValueSummary summary;
+
+  QString sql = R"(
+        SELECT COUNT(*) AS members,
+               COALESCE(SUM(renewals > 0), 0) AS renewed,
+               COALESCE(SUM(revenue_cents), 0) AS revenue_cents
+        FROM member_revenue
+    )";
+
+  QSqlQuery query = m_db.executeQuery(sql);
+  if (query.next()) {
+    summary.members = query.value("members").toInt();
+    summary.renewedMembers = query.value("renewed").toInt();
+    summary.revenueCents = query.value("revenue_cents").toLongLong();
+  }
+  return summary;
+}
+
+} // namespace GymOS::Infrastructure::Repositories
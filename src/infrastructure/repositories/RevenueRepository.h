@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../../core/models/Revenue.h"
+#include "../database/DatabaseManager.h"
+#include <optional>
+#include <vector>
+
+namespace GymOS::Infrastructure::Repositories {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Database;
+
+/**
+ * @brief Repositorio de los agregados de ingresos
+ *
+ * Solo lectura: plan_revenue_monthly y member_revenue los mantiene el
+ * trigger trg_financial_entries_revenue al insertar cada movimiento (ver
+ * la migración 8).
+ */
+class RevenueRepository {
+public:
+  RevenueRepository();
+
+  /**
+   * @brief Ingresos por plan de los meses entre `from` y `to`
+   *
+   * Ordenados por mes y, dentro del mes, de mayor a menor ingreso.
+   */
+  [[nodiscard]] std::vector<PlanRevenue> planRevenue(const QDate &from,
+                                                     const QDate &to) const;
+
+  /**
+   * @brief Miembros de mayor valor acumulado
+   */
+  [[nodiscard]] std::vector<MemberValue> topMembers(int limit) const;
+
+  /**
+   * @brief Valor acumulado de un miembro (nullopt si no tiene pagos)
+   */
+  [[nodiscard]] std::optional<MemberValue> memberValue(int64_t memberId) const;
+
+  /**
+   * @brief Cohortes por mes del primer pago, entre `from` y `to`
+   */
+  [[nodiscard]] std::vector<PaymentCohort> cohorts(const QDate &from,
+                                                   const QDate &to) const;
+
+  [[nodiscard]] LifetimeValueSummary lifetimeSummary() const;
+
+private:
+  DatabaseManager &m_db;
+};
+
+} // namespace GymOS::Infrastructure::Repositories
@@ -1,5 +1,9 @@
 #include "SubscriptionRepository.h"
+#include "../diagnostics/Logging.h"
 #include <QDate>
+#include <QSqlError>
+#include <QStringList>
+#include <algorithm>
 
 namespace GymOS::Infrastructure::Repositories {
 
@@ -12,7 +16,7 @@ int64_t SubscriptionRepository::insert(const Subscription &subscription) {
         VALUES (?, ?, ?, ?, ?)
     )";
 
-  QSqlQuery query = m_db.executeQuery(
+  PreparedQuery query = m_db.executePrepared(
       sql, {subscription.memberId, subscription.planId,
             subscription.startDate.toString(Qt::ISODate),
             subscription.planDurationDays, subscription.enrollmentFee});
@@ -71,44 +75,93 @@ SubscriptionRepository::findLatestByMember(int64_t memberId) const {
   return std::nullopt;
 }
 
-std::vector<Subscription>
-SubscriptionRepository::findByStatus(SubscriptionStatus status) const {
+std::vector<Subscription> SubscriptionRepository::findLatestPerMember() const {
   std::vector<Subscription> subscriptions;
+  QSqlQuery query = m_db.executeQuery(
+      "SELECT * FROM v_subscriptions_with_expiry WHERE id IN "
+      "(SELECT MAX(id) FROM subscriptions GROUP BY member_id)");
+
+  while (query.next()) {
+    subscriptions.push_back(mapRow(query));
+  }
+  return subscriptions;
+}
+
+std::vector<Subscription> SubscriptionRepository::findLatestByMembers(
+    const std::vector<int64_t> &memberIds) const {
+  // SQLite limita la cantidad de parámetros por sentencia
+  constexpr size_t kChunkSize = 500;
+
+  std::vector<Subscription> subscriptions;
+  subscriptions.reserve(memberIds.size());
+
+  for (size_t offset = 0; offset < memberIds.size(); offset += kChunkSize) {
+    const size_t count = std::min(kChunkSize, memberIds.size() - offset);
+
+    QStringList placeholders;
+    QVariantList params;
+    for (size_t i = 0; i < count; ++i) {
+      placeholders << "?";
+      params << memberIds[offset + i];
+    }
+
+    QSqlQuery query = m_db.executeQuery(
+        QString("SELECT * FROM v_subscriptions_with_expiry WHERE id IN "
+                "(SELECT MAX(id) FROM subscriptions WHERE member_id IN (%1) "
+                "GROUP BY member_id)")
+            .arg(placeholders.join(", ")),
+        params);
 
-  if (status == SubscriptionStatus::Active) {
-    // STRICT DATE LOGIC for Active
-    // User Requirement: "A user is 'Active' if CURRENT_DATE is between
-    // start_date and end_date"
-    QString sql = R"(
-        SELECT * FROM v_subscriptions_with_expiry 
-        WHERE date('now') BETWEEN start_date AND end_date
-        ORDER BY end_date
-      )";
-    QSqlQuery query = m_db.executeQuery(sql);
     while (query.next()) {
       subscriptions.push_back(mapRow(query));
     }
-    return subscriptions;
   }
+  return subscriptions;
+}
 
-  QString statusStr;
+std::vector<Subscription>
+SubscriptionRepository::findByStatus(SubscriptionStatus status,
+                                     const QDate &today) const {
+  // La fecha de negocio se enlaza como parámetro: date('now') es UTC y se
+  // reevalúa en cada lectura
+  const QString day = today.toString(Qt::ISODate);
+
+  QString sql;
+  QVariantList params;
   switch (status) {
-  // Active handled above
+  case SubscriptionStatus::Active:
+    // STRICT DATE LOGIC for Active
+    // User Requirement: "A user is 'Active' if CURRENT_DATE is between
+    // start_date and end_date"
+    sql = R"(
+        SELECT * FROM v_subscriptions_with_expiry 
+        WHERE ? BETWEEN start_date AND end_date
+        ORDER BY end_date
+      )";
+    params = {day};
+    break;
   case SubscriptionStatus::ExpiringSoon:
-    statusStr = "expiring";
+    sql = R"(
+        SELECT * FROM v_subscriptions_with_expiry 
+        WHERE end_date >= ? AND end_date <= date(?, '+7 days')
+        ORDER BY end_date
+      )";
+    params = {day, day};
     break;
   case SubscriptionStatus::Expired:
-    statusStr = "expired";
+    sql = R"(
+        SELECT * FROM v_subscriptions_with_expiry 
+        WHERE end_date < ?
+        ORDER BY end_date
+      )";
+    params = {day};
     break;
   default:
-    return subscriptions;
+    return {};
   }
 
-  QSqlQuery query =
-      m_db.executeQuery("SELECT * FROM v_subscriptions_with_expiry WHERE "
-                        "status = ? ORDER BY end_date",
-                        {statusStr});
-
+  std::vector<Subscription> subscriptions;
+  QSqlQuery query = m_db.executeQuery(sql, params);
   while (query.next()) {
     subscriptions.push_back(mapRow(query));
   }
@@ -116,19 +169,21 @@ SubscriptionRepository::findByStatus(SubscriptionStatus status) const {
 }
 
 std::vector<Subscription>
-SubscriptionRepository::findExpiringSoon(int days) const {
+SubscriptionRepository::findExpiringSoon(const QDate &today, int days) const {
   std::vector<Subscription> subscriptions;
 
   // Obtener suscripciones que vencen en los próximos N días pero no han vencido
   // aún
   QString sql = R"(
         SELECT * FROM v_subscriptions_with_expiry 
-        WHERE end_date >= date('now') 
-          AND end_date <= date('now', '+' || ? || ' days')
+        WHERE end_date >= ? 
+          AND end_date <= ?
         ORDER BY end_date
     )";
 
-  QSqlQuery query = m_db.executeQuery(sql, {days});
+  QSqlQuery query = m_db.executeQuery(
+      sql, {today.toString(Qt::ISODate),
+            today.addDays(days).toString(Qt::ISODate)});
 
   while (query.next()) {
     subscriptions.push_back(mapRow(query));
@@ -136,63 +191,108 @@ SubscriptionRepository::findExpiringSoon(int days) const {
   return subscriptions;
 }
 
-int SubscriptionRepository::countActive() const {
-  // Contar miembros ÚNICOS cuya suscripción MÁS RECIENTE está activa
-  // (no contar suscripciones antiguas del mismo miembro)
+SubscriptionRepository::ExpiryCounts
+SubscriptionRepository::countByExpiry(const QDate &today,
+                                      int expiringDays) const {
+  return countByExpiry(m_db.database(), today, expiringDays);
+}
+
+SubscriptionRepository::ExpiryCounts
+SubscriptionRepository::countByExpiry(const QSqlDatabase &db,
+                                      const QDate &today, int expiringDays) {
+  // Solo cuenta la suscripción MÁS RECIENTE de cada miembro (no contar
+  // suscripciones antiguas del mismo miembro)
   QString sql = R"(
-        SELECT COUNT(DISTINCT member_id) FROM v_subscriptions_with_expiry v1
-        WHERE v1.id = (
-          SELECT v2.id FROM v_subscriptions_with_expiry v2 
-          WHERE v2.member_id = v1.member_id 
-          ORDER BY v2.id DESC LIMIT 1
-        )
-        AND date('now') BETWEEN v1.start_date AND v1.end_date
+        SELECT
+          COALESCE(SUM(? BETWEEN start_date AND end_date), 0),
+          COALESCE(SUM(end_date >= ? AND end_date <= ?), 0),
+          COALESCE(SUM(end_date < ?), 0)
+        FROM v_subscriptions_with_expiry
+        WHERE id IN (SELECT MAX(id) FROM subscriptions GROUP BY member_id)
     )";
 
-  QSqlQuery query = m_db.executeQuery(sql);
+  const QString day = today.toString(Qt::ISODate);
+  QSqlQuery query(db);
+  query.prepare(sql);
+  query.addBindValue(day);
+  query.addBindValue(day);
+  query.addBindValue(today.addDays(expiringDays).toString(Qt::ISODate));
+  query.addBindValue(day);
+
+  ExpiryCounts counts;
+  if (!query.exec()) {
+    qCWarning(lcDatabase) << "Error contando suscripciones:"
+                          << query.lastError().text();
+    return counts;
+  }
   if (query.next()) {
-    return query.value(0).toInt();
+    counts.active = query.value(0).toInt();
+    counts.expiring = query.value(1).toInt();
+    counts.expired = query.value(2).toInt();
   }
-  return 0;
+  return counts;
 }
 
-int SubscriptionRepository::countExpired() const {
-  // Contar miembros ÚNICOS cuya suscripción MÁS RECIENTE está expirada
-  QString sql = R"(
-        SELECT COUNT(DISTINCT member_id) FROM v_subscriptions_with_expiry v1
-        WHERE v1.id = (
-          SELECT v2.id FROM v_subscriptions_with_expiry v2 
-          WHERE v2.member_id = v1.member_id 
-          ORDER BY v2.id DESC LIMIT 1
-        )
-        AND v1.end_date < date('now')
-    )";
+bool SubscriptionRepository::forEachPeriod(
+    const std::function<void(int64_t, int, int)> &fn) const {
+  QSqlQuery query(m_db.database());
+  query.setForwardOnly(true);
+  if (!query.exec(R"(
+        SELECT s.member_id,
+               CAST(julianday(s.start_date) + 0.5 AS INTEGER) AS start_day,
+               COALESCE(s.plan_duration_days, p.duration_days) AS duration
+        FROM subscriptions s
+        JOIN plans p ON p.id = s.plan_id
+        ORDER BY s.member_id, s.start_date
+    )")) {
+    qCWarning(lcDatabase) << "Error leyendo períodos de suscripciones:"
+                          << query.lastError().text();
+    return false;
+  }
 
-  QSqlQuery query = m_db.executeQuery(sql);
-  if (query.next()) {
-    return query.value(0).toInt();
+  while (query.next()) {
+    fn(query.value(0).toLongLong(), query.value(1).toInt(),
+       query.value(2).toInt());
   }
-  return 0;
+  return true;
 }
 
-int SubscriptionRepository::countExpiringSoon(int days) const {
-  // Contar miembros ÚNICOS cuya suscripción MÁS RECIENTE está por vencer
+std::vector<SubscriptionRepository::RenewalCounts>
+SubscriptionRepository::renewalCountsByPlan(const QDate &today,
+                                            int graceDays) const {
+  std::vector<RenewalCounts> rows;
+
+  // La subconsulta usa idx_subscriptions_member
   QString sql = R"(
-        SELECT COUNT(DISTINCT member_id) FROM v_subscriptions_with_expiry v1
-        WHERE v1.id = (
-          SELECT v2.id FROM v_subscriptions_with_expiry v2 
-          WHERE v2.member_id = v1.member_id 
-          ORDER BY v2.id DESC LIMIT 1
-        )
-        AND v1.end_date >= date('now') 
-        AND v1.end_date <= date('now', '+' || ? || ' days')
+        SELECT e.plan_id,
+               COUNT(*) AS ended,
+               SUM(EXISTS (
+                 SELECT 1 FROM subscriptions n
+                 WHERE n.member_id = e.member_id AND n.id > e.id
+                   AND n.start_date <= date(e.end_date, ?)
+               )) AS renewed
+        FROM (
+          SELECT s.id, s.member_id, s.plan_id,
+                 date(s.start_date, '+' || COALESCE(s.plan_duration_days,
+                      p.duration_days) || ' days') AS end_date
+          FROM subscriptions s
+          JOIN plans p ON p.id = s.plan_id
+        ) e
+        WHERE e.end_date < ?
+        GROUP BY e.plan_id
     )";
 
-  QSqlQuery query = m_db.executeQuery(sql, {days});
-  if (query.next()) {
-    return query.value(0).toInt();
+  PreparedQuery query = m_db.executePrepared(
+      sql, {QString("+%1 days").arg(graceDays),
+            today.addDays(-graceDays).toString(Qt::ISODate)});
+  while (query.next()) {
+    RenewalCounts counts;
+    counts.planId = query.value("plan_id").toLongLong();
+    counts.ended = query.value("ended").toInt();
+    counts.renewed = query.value("renewed").toInt();
+    rows.push_back(counts);
   }
-  return 0;
+  return rows;
 }
 
 Subscription SubscriptionRepository::mapRow(QSqlQuery &query) const {
@@ -3,6 +3,7 @@
 #include "../../core/models/Subscription.h"
 #include "../database/DatabaseManager.h"
 #include <QSqlQuery>
+#include <functional>
 #include <optional>
 #include <vector>
 
@@ -35,30 +36,91 @@ public:
   findLatestByMember(int64_t memberId) const;
 
   /**
-   * @brief Obtiene suscripciones por estado (calculado dinámicamente)
+   * @brief Obtiene la suscripción más reciente de cada miembro
+   *
+   * Equivale a findLatestByMember() para todos los miembros en una sola
+   * consulta.
+   */
+  [[nodiscard]] std::vector<Subscription> findLatestPerMember() const;
+
+  /**
+   * @brief Obtiene la suscripción más reciente de cada miembro indicado
+   *
+   * Consulta por conjuntos (en bloques de IDs) en lugar de una consulta por
+   * miembro. Los miembros sin suscripción no aparecen en el resultado.
    */
   [[nodiscard]] std::vector<Subscription>
-  findByStatus(SubscriptionStatus status) const;
+  findLatestByMembers(const std::vector<int64_t> &memberIds) const;
+
+  /**
+   * @brief Obtiene suscripciones por estado respecto de `today`
+   */
+  [[nodiscard]] std::vector<Subscription>
+  findByStatus(SubscriptionStatus status, const QDate &today) const;
 
   /**
    * @brief Obtiene suscripciones que vencen en los próximos N días
    */
-  [[nodiscard]] std::vector<Subscription> findExpiringSoon(int days = 7) const;
+  [[nodiscard]] std::vector<Subscription>
+  findExpiringSoon(const QDate &today, int days = 7) const;
+
+  /**
+   * @brief Cantidad de miembros por estado de su suscripción más reciente
+   */
+  struct ExpiryCounts {
+    int active = 0;   ///< `today` entre inicio y vencimiento
+    int expiring = 0; ///< Vence dentro de los próximos `expiringDays` días
+    int expired = 0;  ///< Venció antes de `today`
+  };
+
+  /**
+   * @brief Cuenta activas, por vencer y vencidas en una sola consulta
+   */
+  [[nodiscard]] ExpiryCounts countByExpiry(const QDate &today,
+                                           int expiringDays = 7) const;
+
+  /**
+   * @brief Igual que countByExpiry() pero sobre una conexión explícita
+   *
+   * Permite calcular los conteos en un hilo de trabajo con su propia
+   * conexión (ver DatabaseManager::openWorkerConnection).
+   */
+  [[nodiscard]] static ExpiryCounts
+  countByExpiry(const QSqlDatabase &db, const QDate &today,
+                int expiringDays = 7);
 
   /**
-   * @brief Cuenta suscripciones activas
+   * @brief Recorre el período de cada suscripción, por miembro y fecha de
+   * inicio
+   *
+   * Lectura forward-only sin la vista (no hace falta el nombre del
+   * miembro): `fn` recibe el miembro, el día juliano de inicio y la
+   * duración en días.
+   * @return false si la consulta falló
    */
-  [[nodiscard]] int countActive() const;
+  bool forEachPeriod(
+      const std::function<void(int64_t memberId, int startDay,
+                               int durationDays)> &fn) const;
 
   /**
-   * @brief Cuenta suscripciones vencidas
+   * @brief Suscripciones terminadas de un plan y cuántas se renovaron
    */
-  [[nodiscard]] int countExpired() const;
+  struct RenewalCounts {
+    int64_t planId = 0;
+    int ended = 0;   ///< Vencidas hace más de `graceDays` días
+    int renewed = 0; ///< Con otra suscripción del miembro a tiempo
+  };
 
   /**
-   * @brief Cuenta suscripciones por vencer
+   * @brief Historial de renovaciones por plan
+   *
+   * Una suscripción cuenta como renovada si el miembro tiene otra posterior
+   * que empieza antes de `graceDays` días después del vencimiento. Solo se
+   * consideran las vencidas antes de `today - graceDays`, cuyo resultado ya
+   * se conoce.
    */
-  [[nodiscard]] int countExpiringSoon(int days = 7) const;
+  [[nodiscard]] std::vector<RenewalCounts>
+  renewalCountsByPlan(const QDate &today, int graceDays) const;
 
 private:
   [[nodiscard]] Subscription mapRow(QSqlQuery &query) const;
@@ -1,25 +1,29 @@
+#include <QApplication>
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
-#include <QGuiApplication>
 #include <QIcon>
 #include <QLocale>
 #include <QQmlApplicationEngine>
-#include <QQmlComponent>
-#include <QQmlContext>
 #include <QQmlError>
+#include <QQuickWindow>
 #include <QQuickStyle>
 #include <QTextStream>
+#include <QTimer>
 #include <iostream>
 
+#include "core/services/BusinessClock.h"
 #include "core/services/FinanceEngine.h"
 #include "core/services/SubscriptionManager.h"
 #include "infrastructure/database/DatabaseManager.h"
+#include "infrastructure/diagnostics/Tracer.h"
 #include "ui/controllers/DashboardController.h"
 #include "ui/controllers/GymController.h"
 
 using namespace GymOS::Infrastructure::Database;
+using namespace GymOS::Infrastructure::Diagnostics;
 using namespace GymOS::Core::Services;
 using namespace GymOS::UI::Controllers;
 
@@ -58,22 +62,35 @@ void logDebug(const QString &msg) { writeLog("DEBUG", msg, true); }
 // Custom message handler for Qt messages
 void messageHandler(QtMsgType type, const QMessageLogContext &context,
                     const QString &msg) {
+  const char *category = context.category ? context.category : "default";
+
+  // Filter out verbose Qt internal debug messages but keep QML and GymOS
+  // categories. The check runs before any formatting so discarded messages
+  // cost only the category comparison.
+  if (type == QtDebugMsg) {
+    const bool keep = qstrncmp(category, "gymos.", 6) == 0 ||
+                      qstrcmp(category, "qml") == 0 ||
+                      qstrcmp(category, "js") == 0 || msg.startsWith("[QML]");
+    if (!keep) {
+      return;
+    }
+  }
+
   QString formattedMsg = msg;
+  if (qstrcmp(category, "default") != 0) {
+    formattedMsg = QString("[%1] %2").arg(QLatin1String(category), msg);
+  }
 
   // Add context info if available
   if (context.file && context.line > 0) {
     formattedMsg = QString("%1 (%2:%3)")
-                       .arg(msg, context.file, QString::number(context.line));
+                       .arg(formattedMsg, context.file,
+                            QString::number(context.line));
   }
 
   switch (type) {
   case QtDebugMsg:
-    // Filter out verbose Qt internal messages but keep QML and GymController
-    // logs
-    if (msg.contains("qml:") || msg.startsWith("[QML]") ||
-        msg.startsWith("[GymController]")) {
-      logDebug(formattedMsg);
-    }
+    logDebug(formattedMsg);
     break;
   case QtInfoMsg:
     logInfo(formattedMsg);
@@ -89,6 +106,10 @@ void messageHandler(QtMsgType type, const QMessageLogContext &context,
 }
 
 int main(int argc, char *argv[]) {
+  // Tiempo desde el inicio del proceso (time-to-first-frame)
+  QElapsedTimer startupTimer;
+  startupTimer.start();
+
   // Create runtime-logs directory
   QDir dir;
   if (!dir.exists("runtime-logs")) {
@@ -124,8 +145,15 @@ int main(int argc, char *argv[]) {
   logInfo("           GYMOS APPLICATION START            ");
   logInfo("==============================================");
 
-  QGuiApplication app(argc, argv);
-  logInfo("QGuiApplication created");
+  // Traza de rendimiento (GYMOS_TRACE=1 o GYMOS_TRACE=<ruta>.json)
+  auto &tracer = Tracer::instance();
+  tracer.configureFromEnvironment();
+  qint64 phaseStart = tracer.nowUs();
+
+  // QApplication (no QGuiApplication): ChartView de QtCharts lo requiere
+  QApplication app(argc, argv);
+  tracer.completeSpan("startup", "QApplication", phaseStart);
+  logInfo("QApplication created");
 
   // Configuración de la aplicación
   app.setApplicationName("GymOS");
@@ -144,34 +172,30 @@ int main(int argc, char *argv[]) {
 
   // Inicializar base de datos
   logInfo("Initializing database...");
+  phaseStart = tracer.nowUs();
   auto &db = DatabaseManager::instance();
   if (!db.initialize("gymos.db")) {
     logError("FATAL: Failed to initialize database!");
     return -1;
   }
+  tracer.completeSpan("startup", "DatabaseManager::initialize", phaseStart);
   logInfo("Database initialized successfully");
   logInfo(
       QString("Database connected: %1").arg(db.isConnected() ? "YES" : "NO"));
 
   // Crear el controlador principal (incluye todos los servicios)
   logInfo("Creating GymController...");
+  phaseStart = tracer.nowUs();
+  BusinessClock::instance().start();
   GymController *gymController = new GymController(&app);
+  tracer.completeSpan("startup", "GymController", phaseStart);
   logInfo("GymController created");
 
-  // Insertar planes por defecto si la base de datos está vacía
-  if (gymController->getPlans().isEmpty()) {
-    logInfo("Database is empty, inserting default plans...");
-    gymController->createPlan("Mensual", 1, 5000);
-    gymController->createPlan("Trimestral", 3, 12000);
-    gymController->createPlan("Semestral", 6, 20000);
-    gymController->createPlan("Anual", 12, 35000);
-    gymController->createPlan("Quincenal", 15, 3000); // 15 días
-    logInfo("Default plans inserted");
-  }
-
   // Motor QML
   logInfo("Creating QML engine...");
+  phaseStart = tracer.nowUs();
   QQmlApplicationEngine engine;
+  tracer.completeSpan("startup", "QQmlApplicationEngine", phaseStart);
   logInfo("QML engine created");
 
   // Conexión para capturar errores de QML
@@ -184,48 +208,13 @@ int main(int argc, char *argv[]) {
                    });
   logInfo("Warning handler connected");
 
-  // Exponer el controlador a QML
-  logInfo("Setting context properties...");
-  QQmlContext *context = engine.rootContext();
-  context->setContextProperty("gymController", gymController);
-  logInfo("Context properties set");
-
-  // Agregar ruta de importación para módulos QML
-  engine.addImportPath("qrc:/");
-  logInfo("Import path added: qrc:/");
-  logInfo(
-      QString("All import paths: %1").arg(engine.importPathList().join("; ")));
-
-  // Test if QML file exists in resources
-  logInfo("Checking if QML resource exists...");
-  QFile qmlFile(":/qml/Main.qml");
-  if (qmlFile.exists()) {
-    logInfo("Main.qml found in resources");
-  } else {
-    logError("Main.qml NOT FOUND in resources!");
-  }
-
-  // Create component to check for errors before loading
-  logInfo("Creating QQmlComponent to test Main.qml...");
-  const QUrl url(QStringLiteral("qrc:/qml/Main.qml"));
-
-  QQmlComponent component(&engine, url);
-  logInfo(QString("Component status: %1").arg(component.status()));
-
-  if (component.isError()) {
-    logError("QML Component has errors:");
-    for (const QQmlError &error : component.errors()) {
-      logError(QString("  - %1").arg(error.toString()));
-    }
-    g_logFile->close();
-    g_runtimeLogFile->close();
-    delete g_logFile;
-    delete g_runtimeLogFile;
-    return -1;
-  }
+  // GymController y Tracer son singletons del módulo GymOSQml; el motor
+  // obtiene las instancias a través de sus fábricas create()
+  GymController::setQmlInstance(gymController);
 
-  // Now load with engine
-  logInfo("Loading QML with engine.load()...");
+  // Main.qml y el resto del módulo se compilan en build (qmlcachegen); los
+  // errores de carga llegan por la señal warnings y objectCreationFailed
+  logInfo("Loading QML module GymOSQml...");
 
   QObject::connect(
       &engine, &QQmlApplicationEngine::objectCreationFailed, &app,
@@ -236,8 +225,10 @@ int main(int argc, char *argv[]) {
       },
       Qt::QueuedConnection);
 
-  engine.load(url);
-  logInfo("engine.load() completed");
+  phaseStart = tracer.nowUs();
+  engine.loadFromModule("GymOSQml", "Main");
+  tracer.completeSpan("startup", "engine.loadFromModule", phaseStart);
+  logInfo("engine.loadFromModule() completed");
 
   // Verificar si se cargó correctamente
   logInfo(QString("Root objects count: %1").arg(engine.rootObjects().size()));
@@ -251,6 +242,28 @@ int main(int argc, char *argv[]) {
     return -1;
   }
 
+  // Mostrar la ventana primero y cargar los datos después del primer frame.
+  // frameSwapped se emite desde el hilo de render; la conexión es encolada
+  // porque gymController vive en el hilo principal.
+  auto *window = qobject_cast<QQuickWindow *>(engine.rootObjects().first());
+  auto loadData = [gymController, &startupTimer]() {
+    logInfo(QString("First frame after %1 ms").arg(startupTimer.elapsed()));
+
+    auto &tracer = Tracer::instance();
+    const qint64 dataStart = tracer.nowUs();
+    gymController->loadInitialData();
+    tracer.completeSpan("startup", "loadInitialData", dataStart);
+
+    logInfo(QString("Initial data loaded after %1 ms")
+                .arg(startupTimer.elapsed()));
+  };
+  if (window) {
+    QObject::connect(window, &QQuickWindow::frameSwapped, gymController,
+                     loadData, Qt::SingleShotConnection);
+  } else {
+    QTimer::singleShot(0, gymController, loadData);
+  }
+
   logInfo("==============================================");
   logInfo("    GYMOS QML LOADED - STARTING EVENT LOOP    ");
   logInfo("==============================================");
@@ -266,6 +279,8 @@ int main(int argc, char *argv[]) {
 
   logInfo("Application exited with code: " + QString::number(result));
 
+  tracer.exportChromeTrace();
+
   g_logFile->close();
   g_runtimeLogFile->close();
   delete g_logFile;
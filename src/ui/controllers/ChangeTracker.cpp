@@ -0,0 +1,33 @@
+#include "ChangeTracker.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+
+namespace GymOS::UI::Controllers {
+
+ChangeTracker::ChangeTracker(QObject *parent) : QObject(parent) {}
+
+void ChangeTracker::markDirty(Domains domains) {
+  if (!domains) {
+    return;
+  }
+
+  m_pending |= domains;
+  if (!m_flushScheduled) {
+    m_flushScheduled = true;
+    QMetaObject::invokeMethod(this, &ChangeTracker::flush,
+                              Qt::QueuedConnection);
+  }
+}
+
+void ChangeTracker::flush() {
+  m_flushScheduled = false;
+  if (!m_pending) {
+    return;
+  }
+
+  const Domains domains = m_pending;
+  m_pending = None;
+  GYM_TRACE(lcController) << "Publishing changed domains:" << domains;
+  emit changed(domains);
+}
+
+} // namespace GymOS::UI::Controllers
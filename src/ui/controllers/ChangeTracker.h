@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QObject>
+#include <QtQml/qqmlregistration.h>
+
+namespace GymOS::UI::Controllers {
+
+/**
+ * @brief Registro de dominios de datos modificados
+ *
+ * Las escrituras marcan los dominios que tocaron con markDirty(); las marcas
+ * se acumulan y se publican una sola vez por vuelta del event loop mediante
+ * `changed`. Así una operación que toca miembros, suscripciones y finanzas
+ * produce una única notificación, y cada vista decide si le afecta.
+ *
+ * En QML los valores están disponibles como `ChangeTracker.Members`, etc.
+ */
+class ChangeTracker : public QObject {
+  Q_OBJECT
+  QML_ELEMENT
+  QML_UNCREATABLE("ChangeTracker solo expone los dominios de datos")
+
+public:
+  enum Domain {
+    None = 0,
+    Members = 0x01,
+    Plans = 0x02,
+    Subscriptions = 0x04,
+    Finance = 0x08,
+    Settings = 0x10,
+    Attendance = 0x20,
+    Reminders = 0x40,
+    All = Members | Plans | Subscriptions | Finance | Settings | Attendance |
+          Reminders
+  };
+  Q_ENUM(Domain)
+  Q_DECLARE_FLAGS(Domains, Domain)
+  Q_FLAG(Domains)
+
+  explicit ChangeTracker(QObject *parent = nullptr);
+
+  /**
+   * @brief Marca dominios como modificados y agenda la publicación
+   *
+   * Varias llamadas dentro de la misma vuelta del event loop se combinan
+   * en una sola emisión de `changed`.
+   */
+  void markDirty(Domains domains);
+
+  /**
+   * @brief Dominios marcados que todavía no se publicaron
+   */
+  [[nodiscard]] Domains pending() const { return m_pending; }
+
+  /**
+   * @brief Publica de inmediato los dominios pendientes
+   */
+  void flush();
+
+signals:
+  void changed(GymOS::UI::Controllers::ChangeTracker::Domains domains);
+
+private:
+  Domains m_pending;
+  bool m_flushScheduled = false;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(ChangeTracker::Domains)
+
+} // namespace GymOS::UI::Controllers
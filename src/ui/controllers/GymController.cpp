@@ -1,11 +1,259 @@
 #include "GymController.h"
-#include <QDebug>
+#include "../../infrastructure/diagnostics/Logging.h"
+#include "../../infrastructure/diagnostics/Tracer.h"
+#include "../../infrastructure/notifications/FileReminderSender.h"
+#include "../../infrastructure/notifications/ReminderExporter.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QQmlEngine>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QSettings>
+#include <algorithm>
 
 namespace GymOS::UI::Controllers {
 
+namespace {
+
+/**
+ * @brief Valor de vida de un miembro para QML
+ */
+QVariantMap memberValueToMap(const MemberValue &value) {
+  QVariantMap item;
+  item["memberId"] = static_cast<qint64>(value.memberId);
+  item["name"] = value.memberName;
+  item["value"] = value.revenueCents / 100.0;
+  item["payments"] = value.payments;
+  item["renewals"] = value.renewals;
+  item["firstPayment"] = value.firstPayment.toString("dd/MM/yyyy");
+  item["lastPayment"] = value.lastPayment.toString("dd/MM/yyyy");
+  return item;
+}
+
+} // namespace
+
+GymController *GymController::s_qmlInstance = nullptr;
+
 GymController::GymController(QObject *parent) : QObject(parent) {
-  qDebug() << "[GymController] Initialized";
+  connect(&m_checkInService, &CheckInService::checkedIn,
+          &m_attendanceAnalytics, &AttendanceAnalytics::record);
+  connect(&m_attendanceAnalytics, &AttendanceAnalytics::updated, this,
+          [this] { markDirty(ChangeTracker::Attendance); });
+  connect(&m_changes, &ChangeTracker::changed, this,
+          &GymController::publishChanges);
+  connect(&m_views, &ViewRefreshScheduler::refreshRequested, this,
+          &GymController::viewRefreshRequested);
+  connect(&BusinessClock::instance(), &BusinessClock::dayChanged, this,
+          &GymController::onDayChanged);
+
+  // Canal de envío local: los recordatorios quedan en outbox/ junto a la app
+  m_reminders.setSender(
+      std::make_shared<Infrastructure::Notifications::FileReminderSender>(
+          QCoreApplication::applicationDirPath() + "/outbox"));
+  connect(&m_reminders, &ReminderScheduler::remindersQueued, this,
+          [this] { markDirty(ChangeTracker::Reminders); });
+  connect(&m_reminders, &ReminderScheduler::outboxProcessed, this,
+          [this] { markDirty(ChangeTracker::Reminders); });
+
+  using Infrastructure::Reports::FinancialReportExporter;
+  connect(&m_reportExporter, &FinancialReportExporter::runningChanged, this,
+          &GymController::reportExportingChanged);
+  connect(&m_reportExporter, &FinancialReportExporter::progress, this,
+          [this](qint64 written, qint64 total) {
+            emit reportExportProgress(
+                total > 0 ? static_cast<int>(written * 100 / total) : 100);
+          });
+  connect(&m_reportExporter, &FinancialReportExporter::finished, this,
+          [this](const QString &path, qint64 rows) {
+            emit operationSuccess(QString("%1 movimientos exportados a %2")
+                                      .arg(rows)
+                                      .arg(QDir::toNativeSeparators(path)));
+          });
+  connect(&m_reportExporter, &FinancialReportExporter::failed, this,
+          [this](const QString &error) {
+            emit operationError(
+                QString("Error al exportar movimientos: %1").arg(error));
+          });
+
+  using Infrastructure::Reports::Statement;
+  using Infrastructure::Reports::StatementEngine;
+  connect(&m_statements, &StatementEngine::runningChanged, this,
+          &GymController::statementBuildingChanged);
+  connect(&m_statements, &StatementEngine::finished, this,
+          [this](const Statement &statement) {
+            emit statementReady(statementToMap(statement));
+          });
+  connect(&m_statements, &StatementEngine::failed, this,
+          [this](const QString &error) {
+            emit operationError(
+                QString("Error al generar el estado: %1").arg(error));
+          });
+  GYM_TRACE(lcController) << "Initialized";
+}
+
+void GymController::markDirty(ChangeTracker::Domains domains) {
+  // Cachés derivadas de los dominios modificados
+  if (domains.testFlag(ChangeTracker::Subscriptions)) {
+    m_expiryStats.reset();
+    m_renewalForecast.invalidate(); // Vencimientos y renovaciones
+  }
+  if (domains.testFlag(ChangeTracker::Plans)) {
+    ExpiryIndex::instance().invalidate(); // Nombres y precios de planes
+    CohortEngine::instance().invalidate(); // Duración de los planes
+    m_renewalForecast.invalidate();        // Precios de planes
+  }
+  if (domains.testFlag(ChangeTracker::Finance)) {
+    FinanceCube::instance().markStale(); // Movimientos nuevos
+  }
+  m_changes.markDirty(domains);
+}
+
+void GymController::onDayChanged(const QDate &today) {
+  GYM_TRACE_SCOPE("controller", __func__);
+  m_attendanceAnalytics.rollOver(today);
+  m_financeEngine.closePeriods(); // Al empezar un mes se cierra el anterior
+
+  // Los conteos por estado dependen de la fecha: se recalculan una vez, en
+  // un hilo de trabajo con su propia conexión de solo lectura
+  using GymOS::Infrastructure::Database::DatabaseManager;
+  using Stats = SubscriptionManager::Stats;
+
+  auto compute = [today]() -> std::optional<Stats> {
+    const QString connection = QStringLiteral("gymos_rollover");
+    std::optional<Stats> stats;
+    {
+      QSqlDatabase db =
+          DatabaseManager::instance().openWorkerConnection(connection);
+      if (db.isOpen()) {
+        stats = SubscriptionManager::computeStats(db, today);
+      }
+    }
+    DatabaseManager::closeWorkerConnection(connection);
+    return stats;
+  };
+
+  QtConcurrent::run(compute).then(
+      this, [this, today](const std::optional<Stats> &stats) {
+        if (today != BusinessClock::instance().today()) {
+          return; // Otro cambio de día mientras se calculaba
+        }
+        markDirty(ChangeTracker::Subscriptions | ChangeTracker::Finance);
+        m_expiryStats = stats;
+      });
+}
+
+const SubscriptionManager::Stats &GymController::expiryStats() const {
+  if (!m_expiryStats) {
+    m_expiryStats = m_subscriptionManager.getStats();
+  }
+  return *m_expiryStats;
+}
+
+void GymController::publishChanges(ChangeTracker::Domains domains) {
+  GYM_TRACE_SCOPE("controller", __func__);
+
+  // Las señales NOTIFY mantienen vivos los bindings a las propiedades
+  if (domains.testFlag(ChangeTracker::Plans)) {
+    emit plansChanged();
+  }
+  if (domains.testFlag(ChangeTracker::Members)) {
+    emit membersChanged();
+  }
+  if (domains.testFlag(ChangeTracker::Subscriptions)) {
+    emit subscriptionsChanged();
+  }
+  if (domains.testFlag(ChangeTracker::Finance)) {
+    emit financialDataChanged();
+  }
+  if (domains.testFlag(ChangeTracker::Settings)) {
+    emit settingsChanged();
+  }
+  if (domains.testFlag(ChangeTracker::Attendance)) {
+    emit attendanceChanged();
+  }
+  if (domains.testFlag(ChangeTracker::Reminders)) {
+    emit remindersChanged();
+  }
+
+  emit dataChanged(static_cast<int>(domains));
+  m_views.dispatch(domains);
+}
+
+void GymController::setQmlInstance(GymController *instance) {
+  s_qmlInstance = instance;
+}
+
+GymController *GymController::create(QQmlEngine *qmlEngine,
+                                     QJSEngine *jsEngine) {
+  Q_UNUSED(jsEngine)
+  Q_ASSERT(s_qmlInstance);
+  Q_ASSERT(s_qmlInstance->thread() == qmlEngine->thread());
+
+  // La instancia pertenece a main(); el motor no debe destruirla
+  QJSEngine::setObjectOwnership(s_qmlInstance, QJSEngine::CppOwnership);
+  return s_qmlInstance;
+}
+
+void GymController::loadInitialData() {
+  GYM_TRACE_SCOPE("controller", __func__);
+
+  // Insertar planes por defecto si la base de datos está vacía
+  if (m_planRepo.count() == 0) {
+    qCInfo(lcController) << "Database is empty, inserting default plans...";
+
+    struct DefaultPlan {
+      const char *name;
+      int days;
+      double price;
+    };
+    const DefaultPlan defaults[] = {{"Mensual", 1, 5000},
+                                    {"Trimestral", 3, 12000},
+                                    {"Semestral", 6, 20000},
+                                    {"Anual", 12, 35000},
+                                    {"Quincenal", 15, 3000}}; // 15 días
+
+    auto &dbManager =
+        GymOS::Infrastructure::Database::DatabaseManager::instance();
+    if (!dbManager.beginTransaction()) {
+      qCWarning(lcController)
+          << "Failed to begin transaction for default plans";
+    } else {
+      bool inserted = true;
+      for (const auto &def : defaults) {
+        Plan plan;
+        plan.name = def.name;
+        plan.durationDays = def.days;
+        plan.price = def.price;
+        plan.isActive = true;
+        if (m_planRepo.insert(plan) <= 0) {
+          qCWarning(lcController) << "Failed to insert default plan"
+                                  << def.name;
+          inserted = false;
+          break;
+        }
+      }
+
+      if (inserted && dbManager.commitTransaction()) {
+        qCInfo(lcController) << "Default plans inserted";
+      } else {
+        dbManager.rollbackTransaction();
+        qCWarning(lcController) << "Default plans rolled back";
+      }
+    }
+  }
+
+  m_checkInService.load();
+  m_attendanceAnalytics.load();
+  FinanceCube::instance().sync();
+  m_financeEngine.closePeriods();
+
+  m_ready = true;
+  emit readyChanged();
+
+  // Carga inicial: la vista activa consulta ahora, el resto al mostrarse
+  m_views.dispatch(ChangeTracker::All);
+
+  // Recordatorios del día (si no se generaron en una ejecución anterior)
+  m_reminders.runIfDue();
 }
 
 // ============================================================================
@@ -17,18 +265,19 @@ bool GymController::registerMember(const QString &firstName,
                                    const QString &email, const QString &phone,
                                    int planId, const QDate &startDate,
                                    double enrollmentFee) {
-  qDebug() << "[GymController] registerMember called";
-  qDebug() << "  - Name:" << firstName << lastName;
-  qDebug() << "  - Email:" << email;
-  qDebug() << "  - Phone:" << phone;
-  qDebug() << "  - Plan ID:" << planId;
-  qDebug() << "  - Start Date:" << startDate;
-  qDebug() << "  - Enrollment Fee:" << enrollmentFee;
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "registerMember called";
+  GYM_TRACE(lcController) << "  - Name:" << firstName << lastName;
+  GYM_TRACE(lcController) << "  - Email:" << email;
+  GYM_TRACE(lcController) << "  - Phone:" << phone;
+  GYM_TRACE(lcController) << "  - Plan ID:" << planId;
+  GYM_TRACE(lcController) << "  - Start Date:" << startDate;
+  GYM_TRACE(lcController) << "  - Enrollment Fee:" << enrollmentFee;
 
   auto &dbManager =
       GymOS::Infrastructure::Database::DatabaseManager::instance();
   if (!dbManager.beginTransaction()) {
-    qCritical() << "[GymController] Failed to begin transaction";
+    qCCritical(lcController) << "Failed to begin transaction";
     emit operationError("Error interno: No se pudo iniciar la transacción");
     return false;
   }
@@ -46,77 +295,74 @@ bool GymController::registerMember(const QString &firstName,
     }
 
     int64_t memberId = m_memberRepo.insert(member);
-    qDebug() << "[GymController] Member created with ID:" << memberId;
+    GYM_TRACE(lcController) << "Member created with ID:" << memberId;
 
-    // 2. Crear la suscripción
+    // 2. Crear la suscripción (registra los pagos del plan y de la
+    // inscripción con sus ingresos)
     int64_t subscriptionId = m_subscriptionManager.createSubscription(
         memberId, planId, startDate, enrollmentFee);
-    qDebug() << "[GymController] Subscription created with ID:"
-             << subscriptionId;
-
-    // 3. Registrar transacción financiera inicial (Enrollment Fee)
-    if (enrollmentFee > 0) {
-      m_financeEngine.recordCustomIncome(
-          enrollmentFee,
-          QString("Inscripción - %1 %2").arg(firstName, lastName));
-      qDebug() << "[GymController] Financial entry created for enrollment";
-    }
+    GYM_TRACE(lcController) << "Subscription created with ID:"
+                            << subscriptionId;
 
-    // 4. Confirmar transacción
+    // 3. Confirmar transacción
     if (!dbManager.commitTransaction()) {
       throw std::runtime_error("Failed to commit transaction");
     }
-    qDebug() << "[GymController] Transaction committed successfully";
-
-    // 5. Emitir señales de actualización
-    emit membersChanged();
-    emit subscriptionsChanged();
-    emit financialDataChanged();
+    GYM_TRACE(lcController) << "Transaction committed successfully";
+    m_checkInService.refreshMember(memberId);
+    ExpiryIndex::instance().refreshMember(memberId);
+    CohortEngine::instance().refreshMember(memberId);
+
+    // 4. Notificar a las vistas (una sola publicación por vuelta del loop)
+    markDirty(ChangeTracker::Members | ChangeTracker::Subscriptions |
+              ChangeTracker::Finance);
     emit operationSuccess("Miembro registrado exitosamente");
 
     return true;
   } catch (const std::exception &e) {
     dbManager.rollbackTransaction();
-    qWarning() << "[GymController] Error registering member (Rolled back):"
-               << e.what();
+    qCWarning(lcController) << "Error registering member (Rolled back):"
+                            << e.what();
     emit operationError(QString("Error al registrar: %1").arg(e.what()));
     return false;
   }
 }
 
 bool GymController::recordExpense(const QString &description, double amount) {
-  qDebug() << "[GymController] recordExpense called";
-  qDebug() << "  - Description:" << description;
-  qDebug() << "  - Amount:" << amount;
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "recordExpense called";
+  GYM_TRACE(lcController) << "  - Description:" << description;
+  GYM_TRACE(lcController) << "  - Amount:" << amount;
 
   try {
     int64_t entryId = m_financeEngine.recordCustomExpense(amount, description);
-    qDebug() << "[GymController] Expense recorded with ID:" << entryId;
+    GYM_TRACE(lcController) << "Expense recorded with ID:" << entryId;
 
-    emit financialDataChanged();
+    markDirty(ChangeTracker::Finance);
     emit operationSuccess("Gasto registrado exitosamente");
     return true;
   } catch (const std::exception &e) {
-    qWarning() << "[GymController] Error recording expense:" << e.what();
+    qCWarning(lcController) << "Error recording expense:" << e.what();
     emit operationError(QString("Error al registrar gasto: %1").arg(e.what()));
     return false;
   }
 }
 
 bool GymController::recordIncome(const QString &description, double amount) {
-  qDebug() << "[GymController] recordIncome called";
-  qDebug() << "  - Description:" << description;
-  qDebug() << "  - Amount:" << amount;
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "recordIncome called";
+  GYM_TRACE(lcController) << "  - Description:" << description;
+  GYM_TRACE(lcController) << "  - Amount:" << amount;
 
   try {
     int64_t entryId = m_financeEngine.recordCustomIncome(amount, description);
-    qDebug() << "[GymController] Income recorded with ID:" << entryId;
+    GYM_TRACE(lcController) << "Income recorded with ID:" << entryId;
 
-    emit financialDataChanged();
+    markDirty(ChangeTracker::Finance);
     emit operationSuccess("Ingreso registrado exitosamente");
     return true;
   } catch (const std::exception &e) {
-    qWarning() << "[GymController] Error recording income:" << e.what();
+    qCWarning(lcController) << "Error recording income:" << e.what();
     emit operationError(
         QString("Error al registrar ingreso: %1").arg(e.what()));
     return false;
@@ -124,6 +370,7 @@ bool GymController::recordIncome(const QString &description, double amount) {
 }
 
 void GymController::setEnrollmentFee(double fee) {
+  GYM_TRACE_SCOPE("controller", __func__);
   auto &dbManager =
       GymOS::Infrastructure::Database::DatabaseManager::instance();
   // Upsert enrollment_fee
@@ -134,10 +381,11 @@ void GymController::setEnrollmentFee(double fee) {
       "excluded.updated_at",
       {QString::number(fee)});
 
-  emit settingsChanged();
+  markDirty(ChangeTracker::Settings);
 }
 
 double GymController::getEnrollmentFee() const {
+  GYM_TRACE_SCOPE("controller", __func__);
   auto &dbManager =
       GymOS::Infrastructure::Database::DatabaseManager::instance();
   QSqlQuery query = dbManager.executeQuery(
@@ -149,10 +397,11 @@ double GymController::getEnrollmentFee() const {
 }
 
 bool GymController::createPlan(const QString &name, int days, double price) {
-  qDebug() << "[GymController] createPlan called";
-  qDebug() << "  - Name:" << name;
-  qDebug() << "  - Days:" << days;
-  qDebug() << "  - Price:" << price;
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "createPlan called";
+  GYM_TRACE(lcController) << "  - Name:" << name;
+  GYM_TRACE(lcController) << "  - Days:" << days;
+  GYM_TRACE(lcController) << "  - Price:" << price;
 
   try {
     Plan plan;
@@ -162,13 +411,13 @@ bool GymController::createPlan(const QString &name, int days, double price) {
     plan.isActive = true;
 
     int64_t planId = m_planRepo.insert(plan);
-    qDebug() << "[GymController] Plan created with ID:" << planId;
+    GYM_TRACE(lcController) << "Plan created with ID:" << planId;
 
-    emit plansChanged();
+    markDirty(ChangeTracker::Plans);
     emit operationSuccess("Plan creado exitosamente");
     return true;
   } catch (const std::exception &e) {
-    qWarning() << "[GymController] Error creating plan:" << e.what();
+    qCWarning(lcController) << "Error creating plan:" << e.what();
     emit operationError(QString("Error al crear plan: %1").arg(e.what()));
     return false;
   }
@@ -176,7 +425,8 @@ bool GymController::createPlan(const QString &name, int days, double price) {
 
 bool GymController::updatePlan(int planId, const QString &name, int days,
                                double price) {
-  qDebug() << "[GymController] updatePlan called for ID:" << planId;
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "updatePlan called for ID:" << planId;
 
   try {
     auto existingPlan = m_planRepo.findById(planId);
@@ -191,21 +441,22 @@ bool GymController::updatePlan(int planId, const QString &name, int days,
     plan.price = price;
 
     m_planRepo.update(plan);
-    qDebug() << "[GymController] Plan updated";
+    GYM_TRACE(lcController) << "Plan updated";
 
-    emit plansChanged();
+    markDirty(ChangeTracker::Plans);
     emit operationSuccess("Plan actualizado exitosamente");
     return true;
   } catch (const std::exception &e) {
-    qWarning() << "[GymController] Error updating plan:" << e.what();
+    qCWarning(lcController) << "Error updating plan:" << e.what();
     emit operationError(QString("Error al actualizar plan: %1").arg(e.what()));
     return false;
   }
 }
 
 bool GymController::togglePlanStatus(int id, bool isActive) {
-  qDebug() << "[GymController] togglePlanStatus called for ID:" << id
-           << " New Status:" << isActive;
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "togglePlanStatus called for ID:" << id
+                          << " New Status:" << isActive;
   auto &dbManager =
       GymOS::Infrastructure::Database::DatabaseManager::instance();
   QSqlQuery query = dbManager.executeQuery(
@@ -214,22 +465,23 @@ bool GymController::togglePlanStatus(int id, bool isActive) {
       {isActive ? 1 : 0, id});
 
   if (query.lastError().isValid()) {
-    qWarning() << "[GymController] Error toggling plan status:"
-               << query.lastError().text();
+    qCWarning(lcController) << "Error toggling plan status:"
+                            << query.lastError().text();
     emit operationError("Error al cambiar estado del plan");
     return false;
   }
 
-  emit plansChanged();
+  markDirty(ChangeTracker::Plans);
   return true;
 }
 
 bool GymController::deletePlan(int planId) {
-  qDebug() << "[GymController] deletePlan called for ID:" << planId;
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "deletePlan called for ID:" << planId;
 
   try {
     if (m_planRepo.remove(planId)) {
-      emit plansChanged();
+      markDirty(ChangeTracker::Plans);
       emit operationSuccess("Plan eliminado exitosamente");
       return true;
     } else {
@@ -237,19 +489,17 @@ bool GymController::deletePlan(int planId) {
       return false;
     }
   } catch (const std::exception &e) {
-    qWarning() << "[GymController] Error deleting plan:" << e.what();
+    qCWarning(lcController) << "Error deleting plan:" << e.what();
     emit operationError(QString("Error al eliminar plan: %1").arg(e.what()));
     return false;
   }
 }
 
 void GymController::refreshData() {
-  qDebug() << "[GymController] refreshData called";
-  emit plansChanged();
-  emit membersChanged();
-  emit subscriptionsChanged();
-  emit financialDataChanged();
-  qDebug() << "[GymController] Data refreshed manually";
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "refreshData called";
+  markDirty(ChangeTracker::All);
+  GYM_TRACE(lcController) << "Data refreshed manually";
 }
 
 bool GymController::updateMember(int memberId, const QString &firstName,
@@ -258,7 +508,8 @@ bool GymController::updateMember(int memberId, const QString &firstName,
                                  double weight, double height,
                                  const QString &healthNotes,
                                  const QString &observations) {
-  qDebug() << "[GymController] updateMember called for ID:" << memberId;
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "updateMember called for ID:" << memberId;
 
   try {
     auto existingMember = m_memberRepo.findById(memberId);
@@ -311,19 +562,22 @@ bool GymController::updateMember(int memberId, const QString &firstName,
       member.observations = std::nullopt;
 
     m_memberRepo.update(member);
-    qDebug() << "[GymController] Member updated successfully";
+    GYM_TRACE(lcController) << "Member updated successfully";
+    ExpiryIndex::instance().refreshMember(memberId); // Nombre visible
+    m_checkInService.refreshMember(memberId);         // Nombre en el escaneo
 
-    emit membersChanged();
+    markDirty(ChangeTracker::Members);
     emit operationSuccess("Perfil actualizado correctamente");
     return true;
   } catch (const std::exception &e) {
-    qWarning() << "[GymController] Error updating member:" << e.what();
+    qCWarning(lcController) << "Error updating member:" << e.what();
     emit operationError(QString("Error al actualizar: %1").arg(e.what()));
     return false;
   }
 }
 
 QVariantMap GymController::getMemberDetails(int memberId) {
+  GYM_TRACE_SCOPE("controller", __func__);
   auto member = m_memberRepo.findById(memberId);
   if (!member)
     return {};
@@ -341,42 +595,77 @@ QVariantMap GymController::getMemberDetails(int memberId) {
   map["healthNotes"] = member->healthNotes.value_or("");
   map["observations"] = member->observations.value_or("");
   map["registerDate"] = member->createdAt;
+  map["cardCode"] = member->cardCode.value_or("");
+  map["totalPaid"] = m_paymentRepo.totalByMember(member->id);
 
   return map;
 }
 
 bool GymController::renewSubscription(int memberId, int planId,
                                       double priceOverride) {
-  qDebug() << "[GymController] Renewing subscription for member" << memberId
-           << "Plan" << planId << "Price:" << priceOverride;
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "Renewing subscription for member" << memberId
+                          << "Plan" << planId << "Price:" << priceOverride;
 
   try {
     int64_t newSubId = m_subscriptionManager.renewSubscription(
         memberId, planId, QDate(), priceOverride);
 
-    qDebug() << "[GymController] renewSubscription returned:" << newSubId;
+    GYM_TRACE(lcController) << "renewSubscription returned:" << newSubId;
 
     if (newSubId != -1) {
-      qDebug() << "[GymController] Subscription renewed successfully!";
-      emit subscriptionsChanged();
-      emit financialDataChanged();
+      GYM_TRACE(lcController) << "Subscription renewed successfully!";
+      m_checkInService.refreshMember(memberId);
+      markDirty(ChangeTracker::Subscriptions | ChangeTracker::Finance |
+                ChangeTracker::Reminders);
       emit operationSuccess("Suscripción renovada exitosamente");
       return true;
     } else {
-      qWarning() << "[GymController] renewSubscription returned -1 (failure)";
+      qCWarning(lcController) << "renewSubscription returned -1 (failure)";
       emit operationError("Falló la renovación de la suscripción");
       return false;
     }
   } catch (const std::exception &e) {
-    qWarning() << "[GymController] Exception in renewSubscription:" << e.what();
+    qCWarning(lcController) << "Exception in renewSubscription:" << e.what();
     emit operationError(QString("Error: %1").arg(e.what()));
     return false;
   }
 }
 
+int GymController::renewMany(const QVariantList &memberIds, int planId,
+                             double priceOverride) {
+  GYM_TRACE_SCOPE("controller", __func__);
+
+  std::vector<int64_t> ids;
+  ids.reserve(static_cast<size_t>(memberIds.size()));
+  for (const QVariant &id : memberIds) {
+    ids.push_back(id.toLongLong());
+  }
+
+  const auto renewals =
+      m_subscriptionManager.renewMany(ids, planId, priceOverride);
+  if (renewals.empty()) {
+    emit operationError("No se renovó ninguna suscripción");
+    return 0;
+  }
+
+  for (const auto &renewal : renewals) {
+    m_checkInService.updateAccess(renewal.memberId, renewal.endDate,
+                                  renewal.memberName);
+  }
+
+  // Una sola publicación para todo el lote
+  markDirty(ChangeTracker::Subscriptions | ChangeTracker::Finance |
+            ChangeTracker::Reminders);
+  emit operationSuccess(
+      QString("%1 suscripciones renovadas").arg(renewals.size()));
+  return static_cast<int>(renewals.size());
+}
+
 QVariantList GymController::getMemberSubscriptionHistory(int memberId) {
-  qDebug() << "[GymController] getMemberSubscriptionHistory called for member:"
-           << memberId;
+  GYM_TRACE_SCOPE("controller", __func__);
+  GYM_TRACE(lcController) << "getMemberSubscriptionHistory called for member:"
+                          << memberId;
   QVariantList result;
 
   // Necesitamos acceso al repositorio de suscripciones
@@ -392,6 +681,8 @@ QVariantList GymController::getMemberSubscriptionHistory(int memberId) {
       "s.plan_duration_days, COALESCE(s.plan_duration_days, p.duration_days) "
       "as duration_days, "
       "p.name as plan_name, p.price as plan_price, "
+      "(SELECT COALESCE(SUM(pay.amount), 0) FROM payments pay "
+      "WHERE pay.subscription_id = s.id) as paid, "
       "date(s.start_date, '+' || COALESCE(s.plan_duration_days, "
       "p.duration_days) || ' days') as end_date "
       "FROM subscriptions s "
@@ -400,7 +691,7 @@ QVariantList GymController::getMemberSubscriptionHistory(int memberId) {
       "ORDER BY s.start_date DESC",
       params);
 
-  qDebug() << "[GymController] Query executed, checking results...";
+  GYM_TRACE(lcController) << "Query executed, checking results...";
 
   while (query.next()) {
     QVariantMap item;
@@ -412,10 +703,11 @@ QVariantList GymController::getMemberSubscriptionHistory(int memberId) {
     item["endDate"] = query.value("end_date").toDate().toString("dd/MM/yyyy");
     item["price"] = query.value("plan_price").toDouble();
     item["enrollmentFee"] = query.value("enrollment_fee").toDouble();
+    item["paid"] = query.value("paid").toDouble();
 
     // Calcular el estado basado en la fecha
     QDate endDate = query.value("end_date").toDate();
-    QDate today = QDate::currentDate();
+    QDate today = BusinessClock::instance().today();
     int daysLeft = today.daysTo(endDate);
 
     QString status;
@@ -436,6 +728,7 @@ QVariantList GymController::getMemberSubscriptionHistory(int memberId) {
 }
 
 QVariantList GymController::getPlans() const {
+  GYM_TRACE_SCOPE("controller", __func__);
   QVariantList result;
   auto plans = m_planRepo.findAll();
   for (const auto &plan : plans) {
@@ -452,6 +745,7 @@ QVariantList GymController::getPlans() const {
 }
 
 QVariantList GymController::getMembers() const {
+  GYM_TRACE_SCOPE("controller", __func__);
   QVariantList result;
   auto members = m_memberRepo.findAll();
   for (const auto &member : members) {
@@ -467,6 +761,7 @@ QVariantList GymController::getMembers() const {
 }
 
 QVariantList GymController::getActiveSubscriptions() const {
+  GYM_TRACE_SCOPE("controller", __func__);
   QVariantList result;
   auto subs = m_subscriptionManager.getActive();
   for (const auto &sub : subs) {
@@ -485,6 +780,7 @@ QVariantList GymController::getActiveSubscriptions() const {
 }
 
 QVariantList GymController::getAllSubscriptions() const {
+  GYM_TRACE_SCOPE("controller", __func__);
   QVariantList result;
   auto subs = m_subscriptionManager.getAll();
   for (const auto &sub : subs) {
@@ -503,6 +799,7 @@ QVariantList GymController::getAllSubscriptions() const {
 }
 
 QVariantList GymController::getExpiringSubscriptions() const {
+  GYM_TRACE_SCOPE("controller", __func__);
   QVariantList result;
   auto subs = m_subscriptionManager.getExpiringSoon(7);
   for (const auto &sub : subs) {
@@ -522,6 +819,7 @@ QVariantList GymController::getExpiringSubscriptions() const {
 }
 
 QVariantMap GymController::getFinancialSummary() const {
+  GYM_TRACE_SCOPE("controller", __func__);
   auto summary = m_financeEngine.getCurrentMonthSummary();
   QVariantMap result;
   result["totalIncome"] = summary.totalIncome;
@@ -531,6 +829,7 @@ QVariantMap GymController::getFinancialSummary() const {
 }
 
 QVariantList GymController::getRecentTransactions() const {
+  GYM_TRACE_SCOPE("controller", __func__);
   QVariantList result;
   auto transactions = m_financeEngine.getLatestTransactions(10);
   for (const auto &entry : transactions) {
@@ -545,42 +844,571 @@ QVariantList GymController::getRecentTransactions() const {
   return result;
 }
 
-QVariantList GymController::getMonthlyBreakdown() const {
+QVariantMap GymController::getFinanceCube(const QString &dimension,
+                                          const QVariantMap &filter) const {
+  GYM_TRACE_SCOPE("controller", __func__);
+
+  CubeDimension cubeDimension = CubeDimension::Month;
+  if (dimension == "type") {
+    cubeDimension = CubeDimension::EntryType;
+  } else if (dimension == "plan") {
+    cubeDimension = CubeDimension::Plan;
+  } else if (dimension == "weekday") {
+    cubeDimension = CubeDimension::Weekday;
+  }
+
+  CubeFilter cubeFilter;
+  cubeFilter.from = filter.value("from").toDate();
+  cubeFilter.to = filter.value("to").toDate();
+  if (const QString type = filter.value("entryType").toString();
+      !type.isEmpty()) {
+    cubeFilter.entryTypes =
+        1U << static_cast<int>(FinancialEntry::entryTypeFromString(type));
+  }
+  if (const QString classification = filter.value("classification").toString();
+      !classification.isEmpty()) {
+    cubeFilter.classifications = classification == "expense" ? 0x2 : 0x1;
+  }
+  cubeFilter.planId = filter.value("planId", -1).toLongLong();
+  if (const int weekday = filter.value("weekday", 0).toInt();
+      weekday >= 1 && weekday <= 7) {
+    cubeFilter.weekdays = 1U << (weekday - 1);
+  }
+
+  const CubeResult cube =
+      FinanceCube::instance().aggregate(cubeDimension, cubeFilter);
+
+  QHash<int64_t, QString> planNames;
+  if (cubeDimension == CubeDimension::Plan) {
+    for (const auto &plan : m_planRepo.findAll()) {
+      planNames.insert(plan.id, plan.name);
+    }
+  }
+  static const QStringList weekdays = {"Lunes",  "Martes", "Miércoles",
+                                       "Jueves", "Viernes", "Sábado",
+                                       "Domingo"};
+
+  QVariantList cells;
+  for (const CubeCell &cell : cube.cells) {
+    QString label;
+    switch (cubeDimension) {
+    case CubeDimension::Month: {
+      MonthlyBreakdown month{int(cell.key / 12), int(cell.key % 12) + 1, 0, 0};
+      label = QString("%1 %2").arg(month.monthName()).arg(month.year);
+      break;
+    }
+    case CubeDimension::EntryType: {
+      FinancialEntry entry;
+      entry.entryType = static_cast<EntryType>(cell.key);
+      label = entry.entryTypeText();
+      break;
+    }
+    case CubeDimension::Plan:
+      label = cell.key == 0 ? QString("Sin plan")
+                            : planNames.value(cell.key, "Plan eliminado");
+      break;
+    case CubeDimension::Weekday:
+      label = weekdays.value(int(cell.key) - 1);
+      break;
+    }
+
+    QVariantMap item;
+    item["key"] = static_cast<qint64>(cell.key);
+    item["label"] = label;
+    item["income"] = cell.incomeCents / 100.0;
+    item["expense"] = cell.expenseCents / 100.0;
+    item["count"] = static_cast<qint64>(cell.count);
+    cells.append(item);
+  }
+
+  QVariantMap result;
+  result["cells"] = cells;
+  result["rows"] = static_cast<qint64>(cube.scannedRows);
+  result["elapsedUs"] = cube.elapsedNs / 1000.0;
+  return result;
+}
+
+QVariantMap GymController::checkIn(const QString &code) {
+  GYM_TRACE_SCOPE("controller", __func__);
+  const auto result = m_checkInService.checkIn(code);
+
+  QVariantMap map;
+  map["allowed"] = result.allowed();
+  map["memberId"] = static_cast<int>(result.memberId);
+  map["memberName"] = result.memberName;
+  map["endDate"] = result.endDate.toString("dd/MM/yyyy");
+  const QDate today = BusinessClock::instance().today();
+  map["daysLeft"] =
+      result.endDate.isValid() ? today.daysTo(result.endDate) : 0;
+  map["visits30"] =
+      m_attendanceAnalytics.memberVisits(result.memberId).visitsInWindow;
+
+  switch (result.decision) {
+  case CheckInService::Decision::Allowed:
+    map["status"] = "allowed";
+    break;
+  case CheckInService::Decision::Expired:
+    map["status"] = "expired";
+    break;
+  case CheckInService::Decision::UnknownMember:
+    map["status"] = "unknown";
+    break;
+  }
+  return map;
+}
+
+QVariantList GymController::getPlanRevenue(int months) const {
+  GYM_TRACE_SCOPE("controller", __func__);
   QVariantList result;
-  auto breakdown = m_financeEngine.getMonthlyBreakdown(6);
-  for (const auto &item : breakdown) {
-    QVariantMap entry;
-    entry["month"] = item.monthName();
-    entry["income"] = item.income;
-    entry["expense"] = item.expenses;
-    result.append(entry);
+  for (const PlanRevenue &row : m_revenueAnalytics.planRevenue(months)) {
+    MonthlyBreakdown label{row.year, row.month, 0, 0};
+    QVariantMap item;
+    item["month"] = label.monthName();
+    item["year"] = row.year;
+    item["planId"] = static_cast<qint64>(row.planId);
+    item["plan"] = row.planName.isEmpty() ? QString("Plan eliminado")
+                                          : row.planName;
+    item["revenue"] = row.revenueCents / 100.0;
+    item["payments"] = row.payments;
+    item["renewals"] = row.renewals;
+    result.append(item);
   }
   return result;
 }
 
-QVariantList GymController::getMonthlyBreakdownForPeriod(int months) {
+QVariantList GymController::getTopMembersByValue(int limit) const {
+  GYM_TRACE_SCOPE("controller", __func__);
   QVariantList result;
-  auto breakdown = m_financeEngine.getMonthlyBreakdown(months);
-  for (const auto &item : breakdown) {
+  for (const MemberValue &value : m_revenueAnalytics.topMembers(limit)) {
+    result.append(memberValueToMap(value));
+  }
+  return result;
+}
+
+QVariantMap GymController::getMemberLifetimeValue(int memberId) const {
+  GYM_TRACE_SCOPE("controller", __func__);
+  const auto value = m_revenueAnalytics.memberValue(memberId);
+  return value ? memberValueToMap(*value) : QVariantMap();
+}
+
+QVariantMap GymController::getPaymentCohorts(int months) const {
+  GYM_TRACE_SCOPE("controller", __func__);
+  QVariantList cohorts;
+  for (const PaymentCohort &cohort : m_revenueAnalytics.cohorts(months)) {
+    MonthlyBreakdown label{cohort.year, cohort.month, 0, 0};
+    QVariantMap item;
+    item["month"] = label.monthName();
+    item["year"] = cohort.year;
+    item["members"] = cohort.members;
+    item["renewed"] = cohort.renewed;
+    item["retention"] = cohort.retentionRate();
+    item["churn"] = cohort.churnRate();
+    item["averageValue"] = cohort.averageValue();
+    cohorts.append(item);
+  }
+
+  const LifetimeValueSummary summary = m_revenueAnalytics.lifetimeSummary();
+  QVariantMap result;
+  result["cohorts"] = cohorts;
+  result["members"] = summary.members;
+  result["renewedMembers"] = summary.renewedMembers;
+  result["averageValue"] = summary.averageValue();
+  return result;
+}
+
+QVariantMap GymController::getCohortRetention(int months) const {
+  GYM_TRACE_SCOPE("controller", __func__);
+  const CohortMatrix matrix = CohortEngine::instance().matrix(months);
+
+  QVariantList rows;
+  for (const CohortRow &row : matrix.rows) {
+    MonthlyBreakdown label{row.year, row.month, 0, 0};
+    QVariantList retention;
+    for (int active : row.active) {
+      retention.append(row.members > 0 ? double(active) / row.members : 0.0);
+    }
+
+    QVariantMap item;
+    item["label"] = QString("%1 %2").arg(label.monthName()).arg(row.year);
+    item["members"] = row.members;
+    item["retention"] = retention;
+    rows.append(item);
+  }
+
+  QVariantMap result;
+  result["rows"] = rows;
+  result["maxOffset"] = matrix.maxOffset;
+  return result;
+}
+
+QVariantMap GymController::getRenewalForecast(int days) const {
+  GYM_TRACE_SCOPE("controller", __func__);
+  const RevenueForecast &forecast = m_renewalForecast.forecast();
+  const int count = std::clamp(days, 1, RenewalForecast::kHorizonDays);
+
+  QVariantList series;
+  int expiring = 0;
+  double expectedRenewals = 0.0;
+  for (int k = 0; k < count; ++k) {
+    const ForecastDay &day = forecast.days[k];
+    QVariantMap item;
+    item["date"] = day.date;
+    item["expiring"] = day.expiring;
+    item["expectedRenewals"] = day.expectedRenewals;
+    item["projected"] = day.projectedCents / 100.0;
+    item["cumulative"] = day.cumulativeCents / 100.0;
+    series.append(item);
+    expiring += day.expiring;
+    expectedRenewals += day.expectedRenewals;
+  }
+
+  QHash<int64_t, QString> planNames;
+  for (const auto &plan : m_planRepo.findAll()) {
+    planNames.insert(plan.id, plan.name);
+  }
+  QVariantList rates;
+  for (const PlanRenewalRate &rate : forecast.rates) {
+    QVariantMap item;
+    item["planId"] = static_cast<qint64>(rate.planId);
+    item["plan"] = planNames.value(rate.planId, "Plan eliminado");
+    item["ended"] = rate.ended;
+    item["renewed"] = rate.renewed;
+    item["probability"] = rate.probability;
+    rates.append(item);
+  }
+
+  QVariantMap result;
+  result["days"] = series;
+  result["projected"] = forecast.projectedCents(count) / 100.0;
+  result["projected30"] = forecast.projectedCents(30) / 100.0;
+  result["projected60"] = forecast.projectedCents(60) / 100.0;
+  result["projected90"] = forecast.projectedCents(90) / 100.0;
+  result["expiring"] = expiring;
+  result["expectedRenewals"] = expectedRenewals;
+  result["rates"] = rates;
+  return result;
+}
+
+QVariantList GymController::getHourlyOccupancyFor(int dayOfWeek) const {
+  GYM_TRACE_SCOPE("controller", __func__);
+  QVariantList result;
+  const auto profile = m_attendanceAnalytics.hourlyProfile(dayOfWeek);
+  const int peak = m_attendanceAnalytics.peakHour(dayOfWeek);
+
+  for (int hour = 0; hour < 24; ++hour) {
     QVariantMap entry;
-    entry["month"] = item.monthName();
-    entry["income"] = item.income;
-    entry["expense"] = item.expenses;
+    entry["hour"] = hour;
+    entry["label"] = QString("%1h").arg(hour);
+    entry["visits"] = profile[hour];
+    entry["isPeak"] = hour == peak;
     result.append(entry);
   }
   return result;
 }
 
+QVariantList GymController::getHourlyOccupancy() const {
+  return getHourlyOccupancyFor(BusinessClock::instance().today().dayOfWeek());
+}
+
+int GymController::getVisitsToday() const {
+  return m_attendanceAnalytics.visitsOn(BusinessClock::instance().today());
+}
+
+QVariantMap GymController::getMemberVisitStats(int memberId) const {
+  GYM_TRACE_SCOPE("controller", __func__);
+  const auto visits = m_attendanceAnalytics.memberVisits(memberId);
+
+  QVariantMap map;
+  map["visits30"] = visits.visitsInWindow;
+  map["lastVisit"] = visits.lastVisit.isValid()
+                         ? visits.lastVisit.toString("dd/MM/yyyy")
+                         : QString();
+  return map;
+}
+
+bool GymController::assignCardCode(int memberId, const QString &cardCode) {
+  GYM_TRACE_SCOPE("controller", __func__);
+  const QString code = cardCode.trimmed();
+
+  switch (m_memberRepo.setCardCode(memberId, code)) {
+  case MemberRepository::CardAssignment::Assigned:
+    break;
+  case MemberRepository::CardAssignment::NotFound:
+    emit operationError("El miembro no existe");
+    return false;
+  case MemberRepository::CardAssignment::Taken:
+    emit operationError("La tarjeta ya está asignada a otro miembro");
+    return false;
+  case MemberRepository::CardAssignment::Failed:
+    emit operationError("No se pudo asignar la tarjeta");
+    return false;
+  }
+
+  m_checkInService.setCardCode(memberId, code);
+  markDirty(ChangeTracker::Members);
+  emit operationSuccess("Tarjeta asignada");
+  return true;
+}
+
+bool GymController::exportFinancialReport(const QDate &from, const QDate &to,
+                                          const QString &format) {
+  GYM_TRACE_SCOPE("controller", __func__);
+  using Infrastructure::Reports::FinancialReportExporter;
+
+  if (!from.isValid() || !to.isValid() || from > to) {
+    emit operationError("El rango de fechas no es válido");
+    return false;
+  }
+
+  const auto exportFormat = format == "columnar"
+                                ? FinancialReportExporter::Format::Columnar
+                                : FinancialReportExporter::Format::Csv;
+  const QString path =
+      QString("%1/exports/movimientos_%2_%3.%4")
+          .arg(QCoreApplication::applicationDirPath(),
+               from.toString("yyyy-MM-dd"), to.toString("yyyy-MM-dd"),
+               FinancialReportExporter::extension(exportFormat));
+
+  if (!m_reportExporter.start(from, to, exportFormat, path)) {
+    emit operationError("Ya hay una exportación en curso");
+    return false;
+  }
+  return true;
+}
+
+void GymController::cancelFinancialReport() { m_reportExporter.cancel(); }
+
+bool GymController::buildStatement(int fromYear, int toYear) {
+  GYM_TRACE_SCOPE("controller", __func__);
+  if (fromYear > toYear) {
+    emit operationError("El rango de años no es válido");
+    return false;
+  }
+  if (!m_statements.start(fromYear, toYear)) {
+    emit operationError("Ya se está generando un estado");
+    return false;
+  }
+  return true;
+}
+
+QVariantMap GymController::statementToMap(
+    const Infrastructure::Reports::Statement &statement) const {
+  GYM_TRACE_SCOPE("controller", __func__);
+  using namespace Infrastructure::Reports;
+
+  QHash<int64_t, QString> planNames;
+  for (const auto &plan : m_planRepo.findAll()) {
+    planNames.insert(plan.id, plan.name);
+  }
+
+  QVariantList years;
+  for (const StatementYear &year : statement.years) {
+    QVariantList months;
+    for (const StatementMonth &month : statement.months) {
+      if (month.year != year.year) {
+        continue;
+      }
+      MonthlyBreakdown label{month.year, month.month, 0, 0};
+      QVariantMap item;
+      item["month"] = label.monthName();
+      item["income"] = month.incomeCents / 100.0;
+      item["expense"] = month.expenseCents / 100.0;
+      item["count"] = static_cast<qint64>(month.count);
+      months.append(item);
+    }
+
+    QVariantList plans;
+    for (const StatementPlan &plan : statement.plans) {
+      if (plan.year != year.year) {
+        continue;
+      }
+      QVariantMap item;
+      item["planId"] = static_cast<qint64>(plan.planId);
+      item["name"] = plan.planId == 0
+                         ? QString("Sin plan")
+                         : planNames.value(plan.planId, "Plan eliminado");
+      item["revenue"] = plan.revenueCents / 100.0;
+      item["count"] = static_cast<qint64>(plan.count);
+      plans.append(item);
+    }
+
+    QVariantMap item;
+    item["year"] = year.year;
+    item["income"] = year.incomeCents / 100.0;
+    item["expense"] = year.expenseCents / 100.0;
+    item["balance"] = (year.incomeCents - year.expenseCents) / 100.0;
+    item["count"] = static_cast<qint64>(year.count);
+    item["payingMembers"] = static_cast<qint64>(year.payingMembers);
+    item["averageMemberRevenue"] =
+        year.payingMembers > 0
+            ? year.memberRevenueCents / 100.0 / year.payingMembers
+            : 0.0;
+    item["months"] = months;
+    item["plans"] = plans;
+    years.append(item);
+  }
+
+  std::vector<int64_t> memberIds;
+  for (const StatementMember &member : statement.topMembers) {
+    memberIds.push_back(member.memberId);
+  }
+  QHash<int64_t, QString> memberNames;
+  for (const auto &member : m_memberRepo.findByIds(memberIds)) {
+    memberNames.insert(member.id, member.fullName());
+  }
+  QVariantList topMembers;
+  for (const StatementMember &member : statement.topMembers) {
+    QVariantMap item;
+    item["memberId"] = static_cast<qint64>(member.memberId);
+    item["name"] = memberNames.value(member.memberId, "Miembro eliminado");
+    item["value"] = member.revenueCents / 100.0;
+    topMembers.append(item);
+  }
+
+  QVariantMap result;
+  result["fromYear"] = statement.fromYear;
+  result["toYear"] = statement.toYear;
+  result["years"] = years;
+  result["topMembers"] = topMembers;
+  result["payingMembers"] = static_cast<qint64>(statement.payingMembers);
+  result["averageMemberValue"] =
+      statement.payingMembers > 0
+          ? statement.memberRevenueCents / 100.0 / statement.payingMembers
+          : 0.0;
+  result["partitions"] = statement.partitions;
+  result["workers"] = statement.workers;
+  result["elapsedMs"] = statement.elapsedMs;
+  return result;
+}
+
+QVariantList GymController::getReminders(const QString &status) const {
+  GYM_TRACE_SCOPE("controller", __func__);
+
+  QVariantList result;
+  OutboxRepository outbox;
+  for (const auto &reminder :
+       outbox.findByStatus(Reminder::statusFromString(status))) {
+    QVariantMap map;
+    map["id"] = static_cast<qint64>(reminder.id);
+    map["memberId"] = static_cast<qint64>(reminder.memberId);
+    map["memberName"] = reminder.memberName;
+    map["planName"] = reminder.planName;
+    map["phone"] = reminder.phone;
+    map["email"] = reminder.email;
+    map["windowDays"] = reminder.windowDays;
+    map["expiryDate"] = reminder.expiryDate.toString("dd/MM/yyyy");
+    map["message"] = reminder.message;
+    map["attempts"] = reminder.attempts;
+    map["lastError"] = reminder.lastError;
+    result.append(map);
+  }
+  return result;
+}
+
+bool GymController::exportReminders(const QString &format) {
+  GYM_TRACE_SCOPE("controller", __func__);
+  using GymOS::Infrastructure::Notifications::ReminderExporter;
+
+  ReminderExporter::Format exportFormat = ReminderExporter::Format::Csv;
+  if (format == "vcard") {
+    exportFormat = ReminderExporter::Format::VCard;
+  } else if (format == "messages") {
+    exportFormat = ReminderExporter::Format::Messages;
+  }
+
+  OutboxRepository outbox;
+  const auto reminders = outbox.findByStatus(ReminderStatus::Pending);
+  if (reminders.empty()) {
+    emit operationError("No hay recordatorios pendientes para exportar");
+    return false;
+  }
+
+  const QString directory = QCoreApplication::applicationDirPath() + "/exports";
+  QDir().mkpath(directory);
+  const QString path =
+      QString("%1/recordatorios_%2.%3")
+          .arg(directory,
+               BusinessClock::instance().today().toString("yyyy-MM-dd"),
+               ReminderExporter::extension(exportFormat));
+
+  QString error;
+  if (!ReminderExporter::write(reminders, exportFormat, path, &error)) {
+    qCWarning(lcController) << "Error exporting reminders:" << error;
+    emit operationError(
+        QString("Error al exportar recordatorios: %1").arg(error));
+    return false;
+  }
+
+  emit operationSuccess(QString("%1 recordatorios exportados a %2")
+                            .arg(reminders.size())
+                            .arg(QDir::toNativeSeparators(path)));
+  return true;
+}
+
+void GymController::sendReminders() {
+  GYM_TRACE_SCOPE("controller", __func__);
+  if (m_reminders.isProcessing()) {
+    emit operationError("Ya hay un envío de recordatorios en curso");
+    return;
+  }
+  m_reminders.processOutbox();
+}
+
+int GymController::getPendingReminderCount() const {
+  GYM_TRACE_SCOPE("controller", __func__);
+  return OutboxRepository().countByStatus(ReminderStatus::Pending);
+}
+
+QString GymController::getReminderWindows() const {
+  QStringList parts;
+  for (int days : m_reminders.windows()) {
+    parts << QString::number(days);
+  }
+  return parts.join(", ");
+}
+
+void GymController::setReminderWindows(const QString &windows) {
+  QList<int> days;
+  for (const QString &part : windows.split(',', Qt::SkipEmptyParts)) {
+    bool ok = false;
+    const int value = part.trimmed().toInt(&ok);
+    if (!ok || value < 0) {
+      emit operationError("Las ventanas deben ser días separados por coma");
+      return;
+    }
+    days.append(value);
+  }
+  m_reminders.setWindows(days);
+  markDirty(ChangeTracker::Settings);
+}
+
+QString GymController::getReminderTemplate() const {
+  return m_reminders.messageTemplate();
+}
+
+void GymController::setReminderTemplate(const QString &text) {
+  m_reminders.setMessageTemplate(text);
+  markDirty(ChangeTracker::Settings);
+}
+
+void GymController::registerView(const QString &view, int domains) {
+  m_views.registerView(view, ChangeTracker::Domains(domains));
+}
+
+void GymController::setActiveView(const QString &view) {
+  m_views.setActiveView(view);
+}
+
 int GymController::getTotalMembers() const { return m_memberRepo.count(); }
 
 int GymController::getActiveSubscriptionsCount() const {
-  auto stats = m_subscriptionManager.getStats();
-  return stats.activeCount;
+  GYM_TRACE_SCOPE("controller", __func__);
+  return expiryStats().activeCount;
 }
 
 int GymController::getExpiringSubscriptionsCount() const {
-  auto stats = m_subscriptionManager.getStats();
-  return stats.expiringCount;
+  GYM_TRACE_SCOPE("controller", __func__);
+  return expiryStats().expiringCount;
 }
 
 bool GymController::getDarkMode() const {
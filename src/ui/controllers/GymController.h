@@ -2,14 +2,32 @@
 
 #include "../../core/models/Member.h"
 #include "../../core/models/Plan.h"
+#include "../../core/services/AttendanceAnalytics.h"
+#include "../../core/services/BusinessClock.h"
+#include "../../core/services/CheckInService.h"
+#include "../../core/services/CohortEngine.h"
+#include "../../core/services/FinanceCube.h"
 #include "../../core/services/FinanceEngine.h"
+#include "../../core/services/ReminderScheduler.h"
+#include "../../core/services/RenewalForecast.h"
+#include "../../core/services/RevenueAnalytics.h"
 #include "../../core/services/SubscriptionManager.h"
 #include "../../infrastructure/repositories/MemberRepository.h"
+#include "../../infrastructure/repositories/PaymentRepository.h"
 #include "../../infrastructure/repositories/PlanRepository.h"
+#include "../../infrastructure/reports/FinancialReportExporter.h"
+#include "../../infrastructure/reports/StatementEngine.h"
+#include "ChangeTracker.h"
+#include "ViewRefreshScheduler.h"
 #include <QDate>
 #include <QObject>
 #include <QVariantList>
 #include <QVariantMap>
+#include <QtQml/qqmlregistration.h>
+#include <optional>
+
+class QQmlEngine;
+class QJSEngine;
 
 namespace GymOS::UI::Controllers {
 
@@ -21,9 +39,19 @@ using namespace GymOS::Infrastructure::Repositories;
  * @brief Controlador principal para la interfaz QML
  *
  * Expone los servicios del backend a QML a través de métodos Q_INVOKABLE.
+ * Se registra como singleton tipado del módulo GymOSQml (`GymController` en
+ * QML), lo que permite a qmlsc compilar a C++ los bindings que lo usan.
+ *
+ * Las escrituras no emiten señales directamente: marcan los dominios
+ * modificados en un ChangeTracker, que los publica una vez por vuelta del
+ * event loop. Las vistas se registran con registerView() y reciben
+ * `viewRefreshRequested` solo mientras están visibles; las ocultas se
+ * refrescan al volver a mostrarse (ver ViewRefreshScheduler).
  */
 class GymController : public QObject {
   Q_OBJECT
+  QML_ELEMENT
+  QML_SINGLETON
 
   // Propiedades para binding en QML
   Q_PROPERTY(QVariantList plans READ getPlans NOTIFY plansChanged)
@@ -38,8 +66,6 @@ class GymController : public QObject {
                  financialDataChanged)
   Q_PROPERTY(QVariantList recentTransactions READ getRecentTransactions NOTIFY
                  financialDataChanged)
-  Q_PROPERTY(QVariantList monthlyBreakdown READ getMonthlyBreakdown NOTIFY
-                 financialDataChanged)
   Q_PROPERTY(int totalMembers READ getTotalMembers NOTIFY membersChanged)
   Q_PROPERTY(int activeSubscriptionsCount READ getActiveSubscriptionsCount
                  NOTIFY subscriptionsChanged)
@@ -49,10 +75,45 @@ class GymController : public QObject {
                  NOTIFY settingsChanged)
   Q_PROPERTY(
       bool darkMode READ getDarkMode WRITE setDarkMode NOTIFY darkModeChanged)
+  Q_PROPERTY(bool ready READ isReady NOTIFY readyChanged)
+  Q_PROPERTY(QVariantList hourlyOccupancy READ getHourlyOccupancy NOTIFY
+                 attendanceChanged)
+  Q_PROPERTY(int visitsToday READ getVisitsToday NOTIFY attendanceChanged)
+  Q_PROPERTY(int pendingReminderCount READ getPendingReminderCount NOTIFY
+                 remindersChanged)
+  Q_PROPERTY(QString reminderWindows READ getReminderWindows WRITE
+                 setReminderWindows NOTIFY settingsChanged)
+  Q_PROPERTY(QString reminderTemplate READ getReminderTemplate WRITE
+                 setReminderTemplate NOTIFY settingsChanged)
+  Q_PROPERTY(bool reportExporting READ isReportExporting NOTIFY
+                 reportExportingChanged)
+  Q_PROPERTY(bool statementBuilding READ isStatementBuilding NOTIFY
+                 statementBuildingChanged)
 
 public:
   explicit GymController(QObject *parent = nullptr);
 
+  /**
+   * @brief Define la instancia que el motor QML usa como singleton
+   *
+   * Debe llamarse antes de cargar el módulo GymOSQml.
+   */
+  static void setQmlInstance(GymController *instance);
+
+  /**
+   * @brief Fábrica del singleton QML (llamada por el motor)
+   */
+  static GymController *create(QQmlEngine *qmlEngine, QJSEngine *jsEngine);
+
+  /**
+   * @brief Carga los datos iniciales (planes por defecto) y marca el
+   * controlador como listo
+   *
+   * Se llama después del primer frame; las vistas esperan a `ready` para
+   * consultar la base de datos.
+   */
+  void loadInitialData();
+
   // ========================================================================
   // Métodos invocables desde QML
   // ========================================================================
@@ -127,16 +188,152 @@ public:
   Q_INVOKABLE bool renewSubscription(int memberId, int planId,
                                      double priceOverride = 0);
 
+  /**
+   * @brief Renueva varias suscripciones al mismo plan en una transacción
+   * @param memberIds IDs de los miembros
+   * @param priceOverride Precio por renovación (negativo = precio del plan)
+   * @return Cantidad de suscripciones renovadas
+   */
+  Q_INVOKABLE int renewMany(const QVariantList &memberIds, int planId,
+                            double priceOverride = -1);
+
   /**
    * @brief Obtiene el historial de suscripciones de un miembro
    */
   Q_INVOKABLE QVariantList getMemberSubscriptionHistory(int memberId);
 
   /**
-   * @brief Obtiene el desglose mensual para un período específico
-   * @param months Número de meses hacia atrás (ej: 1, 3, 6, 12)
+   * @brief Ingresos y gastos agrupados por una dimensión (FinanceCube)
+   * @param dimension "month", "type", "plan" o "weekday"
+   * @param filter Claves opcionales: from, to (fechas), entryType,
+   * classification ("income"/"expense"), planId (-1 = todos, 0 = sin plan)
+   * y weekday (1 = lunes … 7 = domingo, 0 = todos)
+   * @return { cells: [{key, label, income, expense, count}], rows,
+   * elapsedUs }
+   */
+  Q_INVOKABLE QVariantMap getFinanceCube(const QString &dimension,
+                                         const QVariantMap &filter) const;
+
+  /**
+   * @brief Ingresos por plan y mes de los últimos `months` meses
+   * @return [{month, year, planId, plan, revenue, payments, renewals}]
+   */
+  Q_INVOKABLE QVariantList getPlanRevenue(int months) const;
+
+  /**
+   * @brief Miembros de mayor valor de vida
+   * @return [{memberId, name, value, payments, renewals, firstPayment,
+   * lastPayment}]
+   */
+  Q_INVOKABLE QVariantList getTopMembersByValue(int limit) const;
+
+  /**
+   * @brief Valor de vida de un miembro ({} si no tiene pagos)
+   */
+  Q_INVOKABLE QVariantMap getMemberLifetimeValue(int memberId) const;
+
+  /**
+   * @brief Retención por cohorte del primer pago, últimos `months` meses
+   * @return { cohorts: [{month, year, members, renewed, retention, churn,
+   * averageValue}], members, renewedMembers, averageValue }
+   */
+  Q_INVOKABLE QVariantMap getPaymentCohorts(int months) const;
+
+  /**
+   * @brief Matriz de retención mensual de las últimas `months` cohortes
+   *
+   * La cohorte es el mes de la primera suscripción; `retention[k]` es la
+   * fracción de la cohorte activa k meses después.
+   * @return { rows: [{label, members, retention: [...]}], maxOffset }
+   */
+  Q_INVOKABLE QVariantMap getCohortRetention(int months) const;
+
+  /**
+   * @brief Ingresos proyectados por renovaciones de los próximos `days`
+   * días (hasta 90, incluido hoy)
+   *
+   * Vencimientos programados × precio del plan × probabilidad histórica de
+   * renovación del plan.
+   * @return { days: [{date, expiring, expectedRenewals, projected,
+   * cumulative}], projected, projected30, projected60, projected90,
+   * expiring, expectedRenewals, rates: [{planId, plan, ended, renewed,
+   * probability}] }
+   */
+  Q_INVOKABLE QVariantMap getRenewalForecast(int days) const;
+
+  /**
+   * @brief Valida el ingreso de un miembro (código de tarjeta o ID)
+   * @return Mapa con allowed, status, memberId, memberName, endDate,
+   * daysLeft y visits30
+   */
+  Q_INVOKABLE QVariantMap checkIn(const QString &code);
+
+  /**
+   * @brief Promedio de ingresos por hora para un día de la semana
+   * @param dayOfWeek 1 = lunes … 7 = domingo
+   */
+  Q_INVOKABLE QVariantList getHourlyOccupancyFor(int dayOfWeek) const;
+
+  /**
+   * @brief Frecuencia de visitas de un miembro (últimos 30 días)
+   */
+  Q_INVOKABLE QVariantMap getMemberVisitStats(int memberId) const;
+
+  /**
+   * @brief Asigna la tarjeta de check-in de un miembro (vacío para quitarla)
+   */
+  Q_INVOKABLE bool assignCardCode(int memberId, const QString &cardCode);
+
+  /**
+   * @brief Exporta los movimientos de un rango a exports/ en segundo plano
+   *
+   * El avance se informa con reportExportProgress y el resultado con
+   * operationSuccess / operationError.
+   * @param format "csv" o "columnar"
+   */
+  Q_INVOKABLE bool exportFinancialReport(const QDate &from, const QDate &to,
+                                         const QString &format);
+
+  /**
+   * @brief Cancela la exportación de movimientos en curso
+   */
+  Q_INVOKABLE void cancelFinancialReport();
+
+  /**
+   * @brief Genera en segundo plano el estado de los años [fromYear, toYear]
+   *
+   * Totales por mes y año, ingresos por plan y valor por miembro. El
+   * resultado llega con statementReady.
+   */
+  Q_INVOKABLE bool buildStatement(int fromYear, int toYear);
+
+  /**
+   * @brief Recordatorios de vencimiento del outbox
+   * @param status "pending", "sending", "sent" o "failed"
+   */
+  Q_INVOKABLE QVariantList getReminders(const QString &status) const;
+
+  /**
+   * @brief Exporta los recordatorios pendientes a exports/
+   * @param format "csv", "vcard" o "messages"
+   */
+  Q_INVOKABLE bool exportReminders(const QString &format);
+
+  /**
+   * @brief Envía ahora los recordatorios pendientes (en segundo plano)
    */
-  Q_INVOKABLE QVariantList getMonthlyBreakdownForPeriod(int months);
+  Q_INVOKABLE void sendReminders();
+
+  /**
+   * @brief Registra una vista y los dominios que muestra
+   * @param domains Máscara de ChangeTracker::Domain
+   */
+  Q_INVOKABLE void registerView(const QString &view, int domains);
+
+  /**
+   * @brief Indica qué vista está visible (las demás difieren sus refrescos)
+   */
+  Q_INVOKABLE void setActiveView(const QString &view);
 
   // ========================================================================
   // Getters para propiedades
@@ -149,13 +346,22 @@ public:
   QVariantList getExpiringSubscriptions() const;
   QVariantMap getFinancialSummary() const;
   QVariantList getRecentTransactions() const;
-  QVariantList getMonthlyBreakdown() const;
   int getTotalMembers() const;
   int getActiveSubscriptionsCount() const;
   int getExpiringSubscriptionsCount() const;
   double getEnrollmentFee() const;
   bool getDarkMode() const;
   void setDarkMode(bool dark);
+  bool isReady() const { return m_ready; }
+  QVariantList getHourlyOccupancy() const;
+  int getVisitsToday() const;
+  int getPendingReminderCount() const;
+  QString getReminderWindows() const;
+  void setReminderWindows(const QString &windows);
+  QString getReminderTemplate() const;
+  void setReminderTemplate(const QString &text);
+  bool isReportExporting() const { return m_reportExporter.isRunning(); }
+  bool isStatementBuilding() const { return m_statements.isRunning(); }
 
 signals:
   void plansChanged();
@@ -164,14 +370,92 @@ signals:
   void financialDataChanged();
   void settingsChanged();
   void darkModeChanged();
+  void readyChanged();
+  void attendanceChanged();
+  void remindersChanged();
+  void reportExportingChanged();
+
+  /**
+   * @brief Avance de la exportación de movimientos
+   * @param percent 0 a 100
+   */
+  void reportExportProgress(int percent);
+
+  void statementBuildingChanged();
+
+  /**
+   * @brief Estado generado por buildStatement
+   *
+   * `years` (con `months` y `plans` de cada año), `topMembers`,
+   * `payingMembers`, `averageMemberValue` y el tiempo de cálculo.
+   */
+  void statementReady(const QVariantMap &statement);
+
+  /**
+   * @brief Dominios modificados desde la última publicación
+   * @param domains Máscara de ChangeTracker::Domain
+   */
+  void dataChanged(int domains);
+
+  /**
+   * @brief La vista `view` debe recargar los dominios indicados
+   */
+  void viewRefreshRequested(const QString &view, int domains);
+
   void operationSuccess(const QString &message);
   void operationError(const QString &message);
 
 private:
+  /**
+   * @brief Marca dominios modificados y descarta las cachés que dependen de
+   * ellos
+   */
+  void markDirty(ChangeTracker::Domains domains);
+
+  /**
+   * @brief Cambio de día: avanza la asistencia y recalcula en segundo plano
+   * los conteos por estado de suscripción
+   */
+  void onDayChanged(const QDate &today);
+
+  /**
+   * @brief Conteos por estado (cacheados hasta la próxima escritura de
+   * suscripciones o el próximo cambio de día)
+   */
+  const SubscriptionManager::Stats &expiryStats() const;
+
+  /**
+   * @brief Emite las señales NOTIFY de los dominios modificados y
+   * `dataChanged`
+   */
+  void publishChanges(ChangeTracker::Domains domains);
+
+  /**
+   * @brief Convierte un estado a QVariantMap con nombres de planes y
+   * miembros
+   */
+  QVariantMap statementToMap(
+      const Infrastructure::Reports::Statement &statement) const;
+
+  ChangeTracker m_changes;
+  ViewRefreshScheduler m_views;
   mutable SubscriptionManager m_subscriptionManager;
   mutable FinanceEngine m_financeEngine;
   mutable MemberRepository m_memberRepo;
   mutable PlanRepository m_planRepo;
+  mutable PaymentRepository m_paymentRepo;
+  CheckInService m_checkInService;
+  AttendanceAnalytics m_attendanceAnalytics;
+  RevenueAnalytics m_revenueAnalytics;
+  mutable RenewalForecast m_renewalForecast;
+  ReminderScheduler m_reminders;
+  Infrastructure::Reports::FinancialReportExporter m_reportExporter;
+  Infrastructure::Reports::StatementEngine m_statements;
+
+  mutable std::optional<SubscriptionManager::Stats> m_expiryStats;
+  bool m_ready = false;
+
+  static GymController *s_qmlInstance;
 };
 
 } // namespace GymOS::UI::Controllers
@@ -0,0 +1,63 @@
+#include "ViewRefreshScheduler.h"
+#include "../../infrastructure/diagnostics/Logging.h"
+
+namespace GymOS::UI::Controllers {
+
+ViewRefreshScheduler::ViewRefreshScheduler(QObject *parent) : QObject(parent) {
+  m_clock.start();
+}
+
+void ViewRefreshScheduler::registerView(const QString &view,
+                                        ChangeTracker::Domains domains) {
+  m_views[view].domains = domains;
+}
+
+void ViewRefreshScheduler::setActiveView(const QString &view) {
+  if (view == m_activeView) {
+    return;
+  }
+
+  m_activeView = view;
+  auto it = m_views.find(view);
+  if (it != m_views.end()) {
+    refreshIfStale(view, it.value());
+  }
+}
+
+void ViewRefreshScheduler::dispatch(ChangeTracker::Domains domains) {
+  for (auto it = m_views.begin(); it != m_views.end(); ++it) {
+    ViewState &state = it.value();
+    const ChangeTracker::Domains relevant = domains & state.domains;
+    if (!relevant) {
+      continue;
+    }
+
+    if (it.key() == m_activeView) {
+      emit refreshRequested(it.key(), static_cast<int>(relevant));
+      continue;
+    }
+
+    // Vista oculta: se refresca al volver a mostrarse
+    state.stale |= relevant;
+    if (state.staleSinceMs < 0) {
+      state.staleSinceMs = m_clock.elapsed();
+    }
+  }
+}
+
+void ViewRefreshScheduler::refreshIfStale(const QString &view,
+                                          ViewState &state) {
+  if (!state.stale) {
+    return;
+  }
+
+  GYM_TRACE(lcController) << "Refreshing" << view << "stale for"
+                          << m_clock.elapsed() - state.staleSinceMs << "ms";
+
+  const ChangeTracker::Domains stale = state.stale;
+  state.stale = ChangeTracker::None;
+  state.staleSinceMs = -1;
+  emit refreshRequested(view, static_cast<int>(stale));
+}
+
+} // namespace GymOS::UI::Controllers
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ChangeTracker.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+namespace GymOS::UI::Controllers {
+
+/**
+ * @brief Reparte las actualizaciones de datos según la vista visible
+ *
+ * Cada vista se registra con los dominios que muestra. Cuando cambian datos,
+ * solo la vista activa recibe `refreshRequested`; las ocultas acumulan los
+ * dominios pendientes junto con el momento en que quedaron desactualizadas,
+ * y se refrescan una sola vez al volver a mostrarse. Así una escritura
+ * consulta la base de datos solo para lo que está en pantalla.
+ */
+class ViewRefreshScheduler : public QObject {
+  Q_OBJECT
+
+public:
+  explicit ViewRefreshScheduler(QObject *parent = nullptr);
+
+  /**
+   * @brief Registra una vista y los dominios que muestra
+   *
+   * Volver a registrar una vista reemplaza sus dominios.
+   */
+  void registerView(const QString &view, ChangeTracker::Domains domains);
+
+  /**
+   * @brief Cambia la vista visible
+   *
+   * Si la vista tiene dominios pendientes se emite `refreshRequested` con
+   * ellos antes de mostrarla.
+   */
+  void setActiveView(const QString &view);
+
+  [[nodiscard]] QString activeView() const { return m_activeView; }
+
+  /**
+   * @brief Distribuye dominios modificados a las vistas registradas
+   */
+  void dispatch(ChangeTracker::Domains domains);
+
+signals:
+  void refreshRequested(const QString &view, int domains);
+
+private:
+  struct ViewState {
+    ChangeTracker::Domains domains;
+    ChangeTracker::Domains stale;
+    qint64 staleSinceMs = -1;
+  };
+
+  void refreshIfStale(const QString &view, ViewState &state);
+
+  QHash<QString, ViewState> m_views;
+  QString m_activeView;
+  QElapsedTimer m_clock;
+};
+
+} // namespace GymOS::UI::Controllers
@@ -0,0 +1,147 @@
+#include "FinanceChartModel.h"
+#include "../../infrastructure/diagnostics/Tracer.h"
+#include <algorithm>
+
+namespace GymOS::UI::Models {
+
+FinanceChartModel::FinanceChartModel(QObject *parent)
+    : QAbstractTableModel(parent) {}
+
+int FinanceChartModel::rowCount(const QModelIndex &parent) const {
+  return parent.isValid() ? 0 : m_series.size();
+}
+
+int FinanceChartModel::columnCount(const QModelIndex &parent) const {
+  return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant FinanceChartModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() >= rowCount()) {
+    return {};
+  }
+
+  const int row = index.row();
+  switch (role) {
+  case Qt::DisplayRole:
+  case Qt::EditRole:
+    switch (index.column()) {
+    case IndexColumn:
+      return row;
+    case IncomeColumn:
+      return m_series.income[row];
+    case ExpenseColumn:
+      return m_series.expense[row];
+    case BalanceColumn:
+      return m_series.balance[row];
+    default:
+      return {};
+    }
+  case LabelRole:
+    return m_series.labels[row];
+  case YearRole:
+    return m_series.years[row];
+  case IncomeRole:
+    return m_series.income[row];
+  case ExpenseRole:
+    return m_series.expense[row];
+  case BalanceRole:
+    return m_series.balance[row];
+  default:
+    return {};
+  }
+}
+
+QVariant FinanceChartModel::headerData(int section,
+                                       Qt::Orientation orientation,
+                                       int role) const {
+  if (role != Qt::DisplayRole) {
+    return {};
+  }
+  if (orientation == Qt::Vertical) {
+    return section < rowCount() ? QVariant(m_series.labels[section])
+                                : QVariant();
+  }
+
+  switch (section) {
+  case IndexColumn:
+    return QStringLiteral("Mes");
+  case IncomeColumn:
+    return QStringLiteral("Ingresos");
+  case ExpenseColumn:
+    return QStringLiteral("Gastos");
+  case BalanceColumn:
+    return QStringLiteral("Balance");
+  default:
+    return {};
+  }
+}
+
+QHash<int, QByteArray> FinanceChartModel::roleNames() const {
+  QHash<int, QByteArray> roles = QAbstractTableModel::roleNames();
+  roles.insert(LabelRole, "label");
+  roles.insert(YearRole, "year");
+  roles.insert(IncomeRole, "income");
+  roles.insert(ExpenseRole, "expense");
+  roles.insert(BalanceRole, "balance");
+  return roles;
+}
+
+void FinanceChartModel::setMonths(int months) {
+  months = std::max(months, 1);
+  if (months == m_months) {
+    return;
+  }
+  m_months = months;
+  emit monthsChanged();
+  if (m_firstMonth.isValid()) {
+    refresh();
+  }
+}
+
+void FinanceChartModel::refresh() {
+  GYM_TRACE_SCOPE("finance", "FinanceChartModel::refresh");
+
+  const std::vector<MonthlyBreakdown> breakdown =
+      m_engine.getMonthlyBreakdown(m_months);
+  const QDate firstMonth =
+      breakdown.empty() ? QDate()
+                        : QDate(breakdown.front().year,
+                                breakdown.front().month, 1);
+
+  // Otro período (o cambió el mes actual): se reemplaza todo
+  if (firstMonth != m_firstMonth ||
+      static_cast<int>(breakdown.size()) != count()) {
+    beginResetModel();
+    m_series = MonthlySeries::fromBreakdown(breakdown);
+    m_firstMonth = firstMonth;
+    endResetModel();
+    emit countChanged();
+    emit rangeChanged();
+    return;
+  }
+
+  bool changed = false;
+  for (int row = 0; row < count(); ++row) {
+    const MonthlyBreakdown &month = breakdown[row];
+    if (month.income == m_series.income[row] &&
+        month.expenses == m_series.expense[row]) {
+      continue;
+    }
+    m_series.income[row] = month.income;
+    m_series.expense[row] = month.expenses;
+    m_series.balance[row] = month.balance();
+    emit dataChanged(index(row, IncomeColumn), index(row, BalanceColumn));
+    changed = true;
+  }
+
+  if (changed) {
+    const double minBefore = m_series.minBalance;
+    const double maxBefore = m_series.maxBalance;
+    m_series.updateExtremes();
+    if (m_series.minBalance != minBefore || m_series.maxBalance != maxBefore) {
+      emit rangeChanged();
+    }
+  }
+}
+
+} // namespace GymOS::UI::Models
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "../../core/services/FinanceEngine.h"
+#include "MonthlySeries.h"
+#include <QAbstractTableModel>
+#include <QDate>
+#include <QtQml/qqmlregistration.h>
+
+namespace GymOS::UI::Models {
+
+using namespace GymOS::Core::Services;
+
+/**
+ * @brief Datos del gráfico de finanzas como modelo de tabla
+ *
+ * Una fila por mes de los últimos `months` meses (incluido el actual, sin
+ * huecos) y una columna por magnitud: índice del mes (eje X), ingresos,
+ * gastos y balance. FinanceChart lo dibuja con un VXYModelMapper (xColumn:
+ * 0, yColumn: 3); los delegados de QML usan los roles por nombre.
+ *
+ * refresh() vuelve a leer el desglose (FinanceCube, incremental) y lo
+ * compara con el actual: si el período es el mismo solo se emite
+ * dataChanged para los meses que cambiaron, que al registrar un movimiento
+ * suele ser uno, y el mapper mueve solo esos puntos. Cambiar `months` o
+ * pasar a otro mes reinicia el modelo. minBalance y maxBalance acotan el
+ * eje Y sin copiar la serie a QML.
+ *
+ * Arranca vacío: la vista llama a refresh() cuando los datos están listos.
+ */
+class FinanceChartModel : public QAbstractTableModel {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(int months READ months WRITE setMonths NOTIFY monthsChanged)
+  Q_PROPERTY(int count READ count NOTIFY countChanged)
+  Q_PROPERTY(double minBalance READ minBalance NOTIFY rangeChanged)
+  Q_PROPERTY(double maxBalance READ maxBalance NOTIFY rangeChanged)
+
+public:
+  enum Column {
+    IndexColumn,
+    IncomeColumn,
+    ExpenseColumn,
+    BalanceColumn,
+    ColumnCount,
+  };
+  Q_ENUM(Column)
+
+  enum Role {
+    LabelRole = Qt::UserRole + 1,
+    YearRole,
+    IncomeRole,
+    ExpenseRole,
+    BalanceRole,
+  };
+  Q_ENUM(Role)
+
+  explicit FinanceChartModel(QObject *parent = nullptr);
+
+  [[nodiscard]] int rowCount(const QModelIndex &parent = {}) const override;
+  [[nodiscard]] int columnCount(const QModelIndex &parent = {}) const override;
+  [[nodiscard]] QVariant data(const QModelIndex &index,
+                              int role = Qt::DisplayRole) const override;
+  [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation,
+                                    int role = Qt::DisplayRole) const override;
+  [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+
+  [[nodiscard]] int months() const { return m_months; }
+  void setMonths(int months);
+
+  [[nodiscard]] int count() const { return m_series.size(); }
+  [[nodiscard]] double minBalance() const { return m_series.minBalance; }
+  [[nodiscard]] double maxBalance() const { return m_series.maxBalance; }
+
+  /**
+   * @brief Actualiza los meses que cambiaron desde la última lectura
+   */
+  Q_INVOKABLE void refresh();
+
+signals:
+  void monthsChanged();
+  void countChanged();
+  void rangeChanged();
+
+private:
+  FinanceEngine m_engine;
+  MonthlySeries m_series;
+  int m_months = 6;
+  QDate m_firstMonth; ///< Primer mes de m_series; inválida antes de cargar
+};
+
+} // namespace GymOS::UI::Models
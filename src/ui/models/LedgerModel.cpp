@@ -0,0 +1,115 @@
+#include "LedgerModel.h"
+#include "../../infrastructure/diagnostics/Tracer.h"
+#include <iterator>
+#include <optional>
+
+namespace GymOS::UI::Models {
+
+LedgerModel::LedgerModel(QObject *parent) : QAbstractListModel(parent) {}
+
+int LedgerModel::rowCount(const QModelIndex &parent) const {
+  return parent.isValid() ? 0 : static_cast<int>(m_entries.size());
+}
+
+QVariant LedgerModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() >= rowCount()) {
+    return {};
+  }
+
+  const FinancialEntry &entry = m_entries[index.row()];
+  switch (role) {
+  case IdRole:
+    return static_cast<qint64>(entry.id);
+  case TypeRole:
+    return entry.entryTypeId();
+  case ClassificationRole:
+    return entry.classificationId();
+  case AmountRole:
+    return entry.amount;
+  case Qt::DisplayRole:
+  case DescriptionRole:
+    return entry.description;
+  case DateRole:
+    return entry.entryDate.toString("dd/MM/yyyy");
+  default:
+    return {};
+  }
+}
+
+QHash<int, QByteArray> LedgerModel::roleNames() const {
+  return {{IdRole, "entryId"},
+          {TypeRole, "type"},
+          {ClassificationRole, "classification"},
+          {AmountRole, "amount"},
+          {DescriptionRole, "description"},
+          {DateRole, "date"}};
+}
+
+bool LedgerModel::canFetchMore(const QModelIndex &parent) const {
+  return !parent.isValid() && m_hasMore;
+}
+
+void LedgerModel::fetchMore(const QModelIndex &parent) {
+  if (parent.isValid() || !m_hasMore) {
+    return;
+  }
+  GYM_TRACE_SCOPE("ledger", __func__);
+
+  std::optional<LedgerCursor> after;
+  if (!m_entries.empty()) {
+    after = LedgerCursor{m_entries.back().entryDate, m_entries.back().id};
+  }
+
+  auto page = m_repo.findPage(m_filter, after, kPageSize);
+  m_hasMore = static_cast<int>(page.size()) == kPageSize;
+
+  if (!page.empty()) {
+    const int first = rowCount();
+    beginInsertRows({}, first, first + static_cast<int>(page.size()) - 1);
+    m_entries.insert(m_entries.end(), std::make_move_iterator(page.begin()),
+                     std::make_move_iterator(page.end()));
+    endInsertRows();
+  }
+  emit countChanged();
+}
+
+void LedgerModel::reload() {
+  beginResetModel();
+  m_entries.clear();
+  m_hasMore = true;
+  endResetModel();
+
+  // Primera página de inmediato: la vista no siempre llama a fetchMore
+  // después de un reset
+  fetchMore({});
+}
+
+void LedgerModel::setEntryType(const QString &entryType) {
+  if (m_filter.entryType == entryType) {
+    return;
+  }
+  m_filter.entryType = entryType;
+  emit filterChanged();
+  reload();
+}
+
+void LedgerModel::setClassification(const QString &classification) {
+  if (m_filter.classification == classification) {
+    return;
+  }
+  m_filter.classification = classification;
+  emit filterChanged();
+  reload();
+}
+
+void LedgerModel::setSearchText(const QString &text) {
+  const QString trimmed = text.trimmed();
+  if (m_filter.text == trimmed) {
+    return;
+  }
+  m_filter.text = trimmed;
+  emit filterChanged();
+  reload();
+}
+
+} // namespace GymOS::UI::Models
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../../infrastructure/repositories/FinancialEntryRepository.h"
+#include <QAbstractListModel>
+#include <QtQml/qqmlregistration.h>
+#include <vector>
+
+namespace GymOS::UI::Models {
+
+using namespace GymOS::Core::Models;
+using namespace GymOS::Infrastructure::Repositories;
+
+/**
+ * @brief Libro de movimientos con carga perezosa
+ *
+ * Modelo de lista para el historial de FinanceView. Carga una página
+ * (kPageSize filas) y pide las siguientes cuando la vista llega al final
+ * (canFetchMore/fetchMore), usando la última fila cargada como cursor de
+ * FinancialEntryRepository::findPage: cada página es un seek en el índice,
+ * sin OFFSET.
+ *
+ * Arranca vacío: la vista llama a reload() cuando los datos están listos.
+ * Los filtros son propiedades; cambiarlos recarga desde la primera página.
+ * En QML: `LedgerModel { classification: "expense" }`.
+ */
+class LedgerModel : public QAbstractListModel {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QString entryType READ entryType WRITE setEntryType NOTIFY
+                 filterChanged)
+  Q_PROPERTY(QString classification READ classification WRITE
+                 setClassification NOTIFY filterChanged)
+  Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY
+                 filterChanged)
+  Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+  Q_PROPERTY(bool hasMore READ hasMore NOTIFY countChanged)
+
+public:
+  /// Filas por página
+  static constexpr int kPageSize = 100;
+
+  enum Role {
+    IdRole = Qt::UserRole + 1,
+    TypeRole,
+    ClassificationRole,
+    AmountRole,
+    DescriptionRole,
+    DateRole,
+  };
+  Q_ENUM(Role)
+
+  explicit LedgerModel(QObject *parent = nullptr);
+
+  [[nodiscard]] int rowCount(const QModelIndex &parent = {}) const override;
+  [[nodiscard]] QVariant data(const QModelIndex &index,
+                              int role = Qt::DisplayRole) const override;
+  [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+
+  [[nodiscard]] bool canFetchMore(const QModelIndex &parent) const override;
+  void fetchMore(const QModelIndex &parent) override;
+
+  [[nodiscard]] QString entryType() const { return m_filter.entryType; }
+  void setEntryType(const QString &entryType);
+  [[nodiscard]] QString classification() const {
+    return m_filter.classification;
+  }
+  void setClassification(const QString &classification);
+  [[nodiscard]] QString searchText() const { return m_filter.text; }
+  void setSearchText(const QString &text);
+
+  [[nodiscard]] bool hasMore() const { return m_hasMore; }
+
+  /**
+   * @brief Descarta las filas cargadas y vuelve a la primera página
+   */
+  Q_INVOKABLE void reload();
+
+signals:
+  void filterChanged();
+  void countChanged();
+
+private:
+  FinancialEntryRepository m_repo;
+  LedgerFilter m_filter;
+  std::vector<FinancialEntry> m_entries;
+  bool m_hasMore = false; ///< La primera página la carga reload()
+};
+
+} // namespace GymOS::UI::Models
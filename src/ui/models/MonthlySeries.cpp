@@ -0,0 +1,37 @@
+#include "MonthlySeries.h"
+#include <algorithm>
+
+namespace GymOS::UI::Models {
+
+MonthlySeries
+MonthlySeries::fromBreakdown(const std::vector<MonthlyBreakdown> &breakdown) {
+  MonthlySeries series;
+  const auto size = static_cast<qsizetype>(breakdown.size());
+  series.labels.reserve(size);
+  series.years.reserve(size);
+  series.income.reserve(size);
+  series.expense.reserve(size);
+  series.balance.reserve(size);
+
+  for (const MonthlyBreakdown &month : breakdown) {
+    series.labels.append(month.monthName());
+    series.years.append(month.year);
+    series.income.append(month.income);
+    series.expense.append(month.expenses);
+    series.balance.append(month.balance());
+  }
+  series.updateExtremes();
+  return series;
+}
+
+void MonthlySeries::updateExtremes() {
+  if (balance.isEmpty()) {
+    minBalance = maxBalance = 0.0;
+    return;
+  }
+  const auto [min, max] = std::minmax_element(balance.cbegin(), balance.cend());
+  minBalance = *min;
+  maxBalance = *max;
+}
+
+} // namespace GymOS::UI::Models
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../../core/models/FinancialEntry.h"
+#include <QList>
+#include <QObject>
+#include <QStringList>
+#include <QtQml/qqmlregistration.h>
+#include <vector>
+
+namespace GymOS::UI::Models {
+
+using namespace GymOS::Core::Models;
+
+/**
+ * @brief Serie mensual de ingresos y gastos para gráficos
+ *
+ * Una posición por mes del período, sin huecos (los meses sin movimientos
+ * valen 0), en listas paralelas. Se expone a QML como tipo de valor: las
+ * listas llegan como secuencias de números, sin un mapa por punto, y los
+ * extremos del balance ya vienen calculados. En QML:
+ * `property monthlySeries series` y `series.balance[i]`.
+ */
+class MonthlySeries {
+  Q_GADGET
+  QML_VALUE_TYPE(monthlySeries)
+
+  Q_PROPERTY(int size READ size CONSTANT)
+  Q_PROPERTY(QStringList labels MEMBER labels CONSTANT)
+  Q_PROPERTY(QList<int> years MEMBER years CONSTANT)
+  Q_PROPERTY(QList<double> income MEMBER income CONSTANT)
+  Q_PROPERTY(QList<double> expense MEMBER expense CONSTANT)
+  Q_PROPERTY(QList<double> balance MEMBER balance CONSTANT)
+  Q_PROPERTY(double minBalance MEMBER minBalance CONSTANT)
+  Q_PROPERTY(double maxBalance MEMBER maxBalance CONSTANT)
+
+public:
+  /**
+   * @brief Arma la serie a partir de un desglose denso (un mes por fila)
+   */
+  [[nodiscard]] static MonthlySeries
+  fromBreakdown(const std::vector<MonthlyBreakdown> &breakdown);
+
+  [[nodiscard]] int size() const { return static_cast<int>(labels.size()); }
+
+  /**
+   * @brief Recalcula minBalance y maxBalance después de editar `balance`
+   */
+  void updateExtremes();
+
+  QStringList labels; ///< Nombre corto del mes ("Ene", "Feb", ...)
+  QList<int> years;
+  QList<double> income;
+  QList<double> expense;
+  QList<double> balance;
+  double minBalance = 0.0;
+  double maxBalance = 0.0;
+};
+
+} // namespace GymOS::UI::Models